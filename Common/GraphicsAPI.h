@@ -6,6 +6,7 @@
 
 #pragma once
 #include <HelperFunctions.h>
+#include <Profiler.h>
 
 // Platform headers
 #if defined(_WIN32)
@@ -266,10 +267,15 @@ public:
         const char* semanticName;
     };
     typedef std::vector<VertexInputAttribute> VertexInputAttributes;
+    enum class VertexInputRate : uint8_t {
+        PER_VERTEX = 0,
+        PER_INSTANCE = 1
+    };
     struct VertexInputBinding {
         uint32_t bindingIndex;  // Which buffer to use when bound for draws.
         size_t offset;
         size_t stride;
+        VertexInputRate inputRate = VertexInputRate::PER_VERTEX;  // PER_INSTANCE advances once per instance.
     };
     typedef std::vector<VertexInputBinding> VertexInputBindings;
     struct VertexInputState {
@@ -350,6 +356,10 @@ public:
         int64_t depthFormat;
         std::vector<DescriptorInfo> layout;
     };
+    struct ComputePipelineCreateInfo {
+        void* shader;
+        std::vector<DescriptorInfo> layout;  // Storage buffers/images are declared with readWrite = true.
+    };
 
     struct SwapchainCreateInfo {
         uint32_t width;
@@ -365,10 +375,13 @@ public:
             VERTEX,
             INDEX,
             UNIFORM,
+            STORAGE,   // Read/written by shaders. Can also be bound as a vertex or index buffer.
+            INDIRECT,  // Indirect draw/dispatch arguments. Can also be written by shaders.
         } type;
         size_t stride;
         size_t size;
         void* data;
+        bool persistentlyMapped = false;  // Keep the buffer mapped for its lifetime. See GetBufferMappedData().
     };
 
     struct ImageCreateInfo {
@@ -463,6 +476,15 @@ public:
         Extent2D extent;
     };
 
+    // Matches the layout of VkDrawIndexedIndirectCommand and GL's DrawElementsIndirectCommand.
+    struct DrawIndexedIndirectCommand {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+
 public:
     virtual ~GraphicsAPI() = default;
 
@@ -477,7 +499,15 @@ public:
 
     virtual int64_t GetDepthFormat() = 0;
 
+    // Returns true if SetRenderAttachments() attaches TYPE_2D_ARRAY image views for multiview, so that both eyes can be
+    // rendered into a single array swapchain in one pass. Shaders select the layer with gl_ViewID_OVR.
+    virtual bool IsMultiviewSupported() { return false; }
+
     virtual void* GetGraphicsBinding() = 0;
+    // Called when the XrInstance was lost and has been recreated. Queries the graphics requirements again, which the
+    // runtime requires before xrCreateSession(), and returns true if the existing device and the resources created
+    // with it can be used with the new instance. Otherwise, the GraphicsAPI must be recreated.
+    virtual bool RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) { return false; }
     virtual XrSwapchainImageBaseHeader* AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) = 0;
     virtual void FreeSwapchainImageData(XrSwapchain swapchain) = 0;
     virtual XrSwapchainImageBaseHeader* GetSwapchainImageData(XrSwapchain swapchain, uint32_t index) = 0;
@@ -494,15 +524,22 @@ public:
 
     virtual void* CreateBuffer(const BufferCreateInfo& bufferCI) = 0;
     virtual void DestroyBuffer(void*& buffer) {}
+    // Returns the CPU address of a buffer created with BufferCreateInfo::persistentlyMapped, or nullptr if the backend
+    // can not keep it mapped; use SetBufferData() then. Writes are seen by GPU work submitted by the next EndRendering().
+    virtual void* GetBufferMappedData(void* buffer) { return nullptr; }
 
     virtual void* CreateShader(const ShaderCreateInfo& shaderCI) = 0;
     virtual void DestroyShader(void*& shader) = 0;
 
     virtual void* CreatePipeline(const PipelineCreateInfo& pipelineCI) = 0;
+    virtual void* CreateComputePipeline(const ComputePipelineCreateInfo& pipelineCI);
     virtual void DestroyPipeline(void*& pipeline) = 0;
 
     virtual void BeginRendering() = 0;
     virtual void EndRendering() = 0;
+    // Returns the GPU time, in nanoseconds, of the most recent BeginRendering()/EndRendering() submission known to have
+    // completed, or 0 if the backend can not measure it. Read it after BeginRendering(), which waits for the previous one.
+    virtual uint64_t GetLastRenderingGpuTime() { return 0; }
 
     virtual void SetBufferData(void* buffer, size_t offset, size_t size, void* data) = 0;
 
@@ -520,6 +557,14 @@ public:
     virtual void SetIndexBuffer(void* indexBuffer) = 0;
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) = 0;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) = 0;
+    // Draws using DrawIndexedIndirectCommand records read from an INDIRECT buffer, which may have been written by a compute shader.
+    virtual void DrawIndexedIndirect(void* buffer, size_t offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(DrawIndexedIndirectCommand));
+
+    // Compute: Bind a compute pipeline with SetPipeline() and its resources with SetDescriptor()/UpdateDescriptors().
+    // Dispatches must be recorded outside of SetRenderAttachments(); call it again before drawing afterwards.
+    // Shader writes are made visible to all subsequent vertex, index, indirect, uniform and shader reads.
+    virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+    virtual void DispatchIndirect(void* buffer, size_t offset = 0);
 
 protected:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() = 0;
@@ -228,6 +228,24 @@ GraphicsAPI_D3D11::~GraphicsAPI_D3D11() {
     D3D11_SAFE_RELEASE(factory);
 }
 // XR_DOCS_TAG_END_GraphicsAPI_D3D11
+
+bool GraphicsAPI_D3D11::RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) {
+    XR_TUT_PROFILE_FUNCTION();
+    OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetD3D11GraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetD3D11GraphicsRequirementsKHR), "Failed to get InstanceProcAddr xrGetD3D11GraphicsRequirementsKHR.");
+    XrGraphicsRequirementsD3D11KHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D11_KHR};
+    OPENXR_CHECK(xrGetD3D11GraphicsRequirementsKHR(m_xrInstance, systemId, &graphicsRequirements), "Failed to get Graphics Requirements for D3D11.");
+
+    // The device can be kept if it is on the adapter that the runtime wants.
+    IDXGIDevice *dxgiDevice = nullptr;
+    IDXGIAdapter *adapter = nullptr;
+    DXGI_ADAPTER_DESC adapterDesc = {};
+    D3D11_CHECK(device->QueryInterface(IID_PPV_ARGS(&dxgiDevice)), "Failed to get DXGI Device.");
+    D3D11_CHECK(dxgiDevice->GetAdapter(&adapter), "Failed to get DXGI Adapter.");
+    adapter->GetDesc(&adapterDesc);
+    D3D11_SAFE_RELEASE(adapter);
+    D3D11_SAFE_RELEASE(dxgiDevice);
+    return memcmp(&graphicsRequirements.adapterLuid, &adapterDesc.AdapterLuid, sizeof(LUID)) == 0 && device->GetFeatureLevel() >= graphicsRequirements.minFeatureLevel;
+}
 static bool DesktopSwapchainVsync = false;
 void *GraphicsAPI_D3D11::CreateDesktopSwapchain(const SwapchainCreateInfo &swapchainCI) {
     DesktopSwapchainVsync = swapchainCI.vsync;
@@ -663,6 +681,7 @@ void GraphicsAPI_D3D11::EndRendering() {
 }
 
 void GraphicsAPI_D3D11::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
+    XR_TUT_PROFILE_FUNCTION();
     ID3D11Buffer *d3d11Buffer = (ID3D11Buffer *)buffer;
     D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
     D3D11_CHECK(immediateContext->Map(d3d11Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource), "Failed to map Resource.");
@@ -672,15 +691,18 @@ void GraphicsAPI_D3D11::SetBufferData(void *buffer, size_t offset, size_t size,
 }
 
 void GraphicsAPI_D3D11::ClearColor(void *imageView, float r, float g, float b, float a) {
+    XR_TUT_PROFILE_FUNCTION();
     const FLOAT clearColor[4] = {r, g, b, a};
     immediateContext->ClearRenderTargetView((ID3D11RenderTargetView *)imageView, clearColor);
 }
 
 void GraphicsAPI_D3D11::ClearDepth(void *imageView, float d) {
+    XR_TUT_PROFILE_FUNCTION();
     immediateContext->ClearDepthStencilView((ID3D11DepthStencilView *)imageView, D3D11_CLEAR_DEPTH, d, 0);
 }
 
 void GraphicsAPI_D3D11::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {
+    XR_TUT_PROFILE_FUNCTION();
     immediateContext->OMSetRenderTargets((UINT)colorViewCount, (ID3D11RenderTargetView *const *)colorViews, (ID3D11DepthStencilView *)depthStencilView);
 }
 
@@ -767,6 +789,12 @@ void GraphicsAPI_D3D11::SetPipeline(void *pipeline) {
             element.AlignedByteOffset = (UINT)attribute.offset;
             element.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
             element.InstanceDataStepRate = 0;
+            for (const VertexInputBinding &binding : pipelineCI.vertexInputState.bindings) {
+                if (binding.bindingIndex == attribute.bindingIndex && binding.inputRate == VertexInputRate::PER_INSTANCE) {
+                    element.InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+                    element.InstanceDataStepRate = 1;
+                }
+            }
             elements.push_back(element);
         }
 
@@ -988,10 +1016,12 @@ void GraphicsAPI_D3D11::SetIndexBuffer(void *indexBuffer) {
 }
 
 void GraphicsAPI_D3D11::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     immediateContext->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
 void GraphicsAPI_D3D11::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     immediateContext->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
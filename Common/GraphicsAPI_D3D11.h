@@ -25,6 +25,7 @@ public:
     // XR_DOCS_TAG_END_GetDepthFormat_D3D11
 
     virtual void* GetGraphicsBinding() override;
+    virtual bool RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) override;
     virtual XrSwapchainImageBaseHeader* AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) override;
     virtual void FreeSwapchainImageData(XrSwapchain swapchain) override {
         swapchainImagesMap[swapchain].second.clear();
@@ -299,6 +299,17 @@ GraphicsAPI_D3D12 ::~GraphicsAPI_D3D12() {
 }
 // XR_DOCS_TAG_END_GraphicsAPI_D3D12
 
+bool GraphicsAPI_D3D12::RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) {
+    XR_TUT_PROFILE_FUNCTION();
+    OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetD3D12GraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetD3D12GraphicsRequirementsKHR), "Failed to get InstanceProcAddr for xrGetD3D12GraphicsRequirementsKHR.");
+    XrGraphicsRequirementsD3D12KHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D12_KHR};
+    OPENXR_CHECK(xrGetD3D12GraphicsRequirementsKHR(m_xrInstance, systemId, &graphicsRequirements), "Failed to get Graphics Requirements for D3D12.");
+
+    // The device can be kept if it is on the adapter that the runtime wants.
+    const LUID adapterLuid = device->GetAdapterLuid();
+    return memcmp(&graphicsRequirements.adapterLuid, &adapterLuid, sizeof(LUID)) == 0;
+}
+
 static bool DesktopSwapchainVsync = false;
 void *GraphicsAPI_D3D12::CreateDesktopSwapchain(const SwapchainCreateInfo &swapchainCI) {
     DesktopSwapchainVsync = swapchainCI.vsync;
@@ -743,6 +754,13 @@ void *GraphicsAPI_D3D12::CreateBuffer(const BufferCreateInfo &bufferCI) {
 
     D3D12_CHECK(device->CreatePlacedResource(heap, 0, &desc, initState, clear, IID_PPV_ARGS(&buffer)), "Failed to create Buffer.");
 
+    if (bufferCI.persistentlyMapped) {
+        // Resources in an UPLOAD heap can stay mapped while the GPU uses them.
+        void *mappedData = nullptr;
+        D3D12_RANGE readRange = {0, 0};
+        D3D12_CHECK(buffer->Map(0, &readRange, &mappedData), "Failed to map Resource.");
+        bufferMappedData[buffer] = mappedData;
+    }
     SetBufferData(buffer, 0, bufferCI.size, bufferCI.data);
     bufferResources[buffer] = {heap, bufferCI};
 
@@ -752,12 +770,20 @@ void *GraphicsAPI_D3D12::CreateBuffer(const BufferCreateInfo &bufferCI) {
 void GraphicsAPI_D3D12::DestroyBuffer(void *&buffer) {
     ID3D12Resource *d3d12Buffer = reinterpret_cast<ID3D12Resource *>(buffer);
     ID3D12Heap *heap = bufferResources[d3d12Buffer].first;
+    if (bufferMappedData.erase(d3d12Buffer)) {
+        d3d12Buffer->Unmap(0, nullptr);
+    }
     bufferResources.erase(d3d12Buffer);
     D3D12_SAFE_RELEASE(heap);
     D3D12_SAFE_RELEASE(d3d12Buffer);
     buffer = nullptr;
 }
 
+void *GraphicsAPI_D3D12::GetBufferMappedData(void *buffer) {
+    auto it = bufferMappedData.find((ID3D12Resource *)buffer);
+    return it != bufferMappedData.end() ? it->second : nullptr;
+}
+
 void *GraphicsAPI_D3D12::CreateShader(const ShaderCreateInfo &shaderCI) {
     D3D12_SHADER_BYTECODE *byteCode = new D3D12_SHADER_BYTECODE();
 
@@ -818,6 +844,12 @@ void *GraphicsAPI_D3D12::CreatePipeline(const PipelineCreateInfo &pipelineCI) {
         il.AlignedByteOffset = attrib.offset;
         il.InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
         il.InstanceDataStepRate = 0;
+        for (auto &binding : pipelineCI.vertexInputState.bindings) {
+            if (binding.bindingIndex == attrib.bindingIndex && binding.inputRate == VertexInputRate::PER_INSTANCE) {
+                il.InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA;
+                il.InstanceDataStepRate = 1;
+            }
+        }
         inputLayout.push_back(il);
     }
     GPSD.InputLayout = {inputLayout.data(), (UINT)inputLayout.size()};
@@ -1009,6 +1041,7 @@ void GraphicsAPI_D3D12::DestroyPipeline(void *&pipeline) {
 }
 
 void GraphicsAPI_D3D12::BeginRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     D3D12_CHECK(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&cmdAllocator)), "Failed to create CommandAllocator.");
     D3D12_CHECK(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, cmdAllocator, nullptr, IID_PPV_ARGS(&cmdList)), "Failed to create CommandList.");
 
@@ -1029,6 +1062,7 @@ void GraphicsAPI_D3D12::BeginRendering() {
 }
 
 void GraphicsAPI_D3D12::EndRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     if (currentDesktopSwapchainImage) {
         D3D12_RESOURCE_BARRIER swapchainImageBarrier;
         swapchainImageBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
@@ -1055,6 +1089,7 @@ void GraphicsAPI_D3D12::EndRendering() {
 }
 
 void GraphicsAPI_D3D12::ClearColor(void *imageView, float r, float g, float b, float a) {
+    XR_TUT_PROFILE_FUNCTION();
     ID3D12Resource *image = imageViewResources[(SIZE_T)imageView].second;
     if (imageStates[image] != D3D12_RESOURCE_STATE_RENDER_TARGET) {
         D3D12_RESOURCE_BARRIER barrier;
@@ -1073,6 +1108,7 @@ void GraphicsAPI_D3D12::ClearColor(void *imageView, float r, float g, float b, f
 }
 
 void GraphicsAPI_D3D12::ClearDepth(void *imageView, float d) {
+    XR_TUT_PROFILE_FUNCTION();
     ID3D12Resource *image = imageViewResources[(SIZE_T)imageView].second;
     if (imageStates[image] != D3D12_RESOURCE_STATE_DEPTH_WRITE) {
         D3D12_RESOURCE_BARRIER barrier;
@@ -1090,7 +1126,14 @@ void GraphicsAPI_D3D12::ClearDepth(void *imageView, float d) {
 }
 
 void GraphicsAPI_D3D12::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
+    XR_TUT_PROFILE_FUNCTION();
     ID3D12Resource *d3d12Buffer = (ID3D12Resource *)buffer;
+    auto it = bufferMappedData.find(d3d12Buffer);
+    if (it != bufferMappedData.end()) {
+        if (data)
+            memcpy((char *)it->second + offset, data, size);
+        return;
+    }
     void *mappedData = nullptr;
     D3D12_RANGE readRange = {0, 0};
     D3D12_CHECK(d3d12Buffer->Map(0, &readRange, &mappedData), "Failed to map Resource.");
@@ -1100,6 +1143,7 @@ void GraphicsAPI_D3D12::SetBufferData(void *buffer, size_t offset, size_t size,
 }
 
 void GraphicsAPI_D3D12::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {
+    XR_TUT_PROFILE_FUNCTION();
     std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> d3d12RTVs;
     d3d12RTVs.reserve(colorViewCount);
     for (size_t i = 0; i < colorViewCount; i++) {
@@ -1263,10 +1307,12 @@ void GraphicsAPI_D3D12::SetIndexBuffer(void *indexBuffer) {
 }
 
 void GraphicsAPI_D3D12::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     cmdList->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
 void GraphicsAPI_D3D12::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     cmdList->DrawInstanced(vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
@@ -25,6 +25,7 @@ public:
     virtual void PresentDesktopSwapchainImage(void* swapchain, uint32_t index) override;
 
     virtual void* GetGraphicsBinding() override;
+    virtual bool RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) override;
     virtual XrSwapchainImageBaseHeader* AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) override;
     virtual void FreeSwapchainImageData(XrSwapchain swapchain) override {
         swapchainImagesMap[swapchain].second.clear();
@@ -51,6 +52,7 @@ public:
 
     virtual void* CreateBuffer(const BufferCreateInfo& bufferCI) override;
     virtual void DestroyBuffer(void*& buffer) override;
+    virtual void* GetBufferMappedData(void* buffer) override;
 
     virtual void* CreateShader(const ShaderCreateInfo& shaderCI) override;
     virtual void DestroyShader(void*& shader) override;
@@ -105,6 +107,7 @@ private:
     std::unordered_map<SIZE_T, ID3D12DescriptorHeap*> samplerResources;
 
     std::unordered_map<ID3D12Resource*, std::pair<ID3D12Heap*, BufferCreateInfo>> bufferResources;
+    std::unordered_map<ID3D12Resource*, void*> bufferMappedData;
 
     std::unordered_map<D3D12_SHADER_BYTECODE*, std::pair<std::vector<char>, ShaderCreateInfo>> shaders;
 
@@ -18,6 +18,20 @@ void (*GetExtension(const char *functionName))() { return glXGetProcAddress((con
 void (*GetExtension(const char *functionName))() { return eglGetProcAddress(functionName); }
 #endif
 
+// Returns true if the current context exposes the named extension. A non-null GetExtension() is not enough, as
+// glXGetProcAddress() and wglGetProcAddress() can return a pointer for a function that the context does not support.
+bool HasGLExtension(const char *extensionName) {
+    PFNGLGETSTRINGIPROC glGetStringi = (PFNGLGETSTRINGIPROC)GetExtension("glGetStringi");  // 3.0+
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; i++) {
+        if (strcmp((const char *)glGetStringi(GL_EXTENSIONS, (GLuint)i), extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 #pragma region PiplineHelpers
 
 GLenum GetGLTextureTarget(const GraphicsAPI::ImageCreateInfo &imageCI) {
@@ -371,6 +385,7 @@ GraphicsAPI_OpenGL::GraphicsAPI_OpenGL() {
     GLint glMinorVersion = 0;
     glGetIntegerv(GL_MAJOR_VERSION, &glMajorVersion);
     glGetIntegerv(GL_MINOR_VERSION, &glMinorVersion);
+    bufferStorageSupported = XR_MAKE_VERSION(glMajorVersion, glMinorVersion, 0) >= XR_MAKE_VERSION(4, 4, 0) || HasGLExtension("GL_ARB_buffer_storage");
 
     glEnable(GL_DEBUG_OUTPUT);
     glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
@@ -407,6 +422,7 @@ GraphicsAPI_OpenGL::GraphicsAPI_OpenGL(XrInstance m_xrInstance, XrSystemId syste
         int requiredMinorVersion = XR_VERSION_MINOR(graphicsRequirements.minApiVersionSupported);
         std::cerr << "ERROR: OPENGL: The created OpenGL version " << glMajorVersion << "." << glMinorVersion << " doesn't meet the minimum required API version " << requiredMajorVersion << "." << requiredMinorVersion << " for OpenXR." << std::endl;
     }
+    bufferStorageSupported = XR_MAKE_VERSION(glMajorVersion, glMinorVersion, 0) >= XR_MAKE_VERSION(4, 4, 0) || HasGLExtension("GL_ARB_buffer_storage");
 
     glEnable(GL_DEBUG_OUTPUT);
     glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
@@ -420,6 +436,20 @@ GraphicsAPI_OpenGL::~GraphicsAPI_OpenGL() {
 }
 // XR_DOCS_TAG_END_GraphicsAPI_OpenGL
 
+bool GraphicsAPI_OpenGL::RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) {
+    XR_TUT_PROFILE_FUNCTION();
+    OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetOpenGLGraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetOpenGLGraphicsRequirementsKHR), "Failed to get InstanceProcAddr for xrGetOpenGLGraphicsRequirementsKHR.");
+    XrGraphicsRequirementsOpenGLKHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_OPENGL_KHR};
+    OPENXR_CHECK(xrGetOpenGLGraphicsRequirementsKHR(m_xrInstance, systemId, &graphicsRequirements), "Failed to get Graphics Requirements for OpenGL.");
+
+    // The context can be kept if its version still meets the runtime's requirements.
+    GLint glMajorVersion = 0;
+    GLint glMinorVersion = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &glMajorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &glMinorVersion);
+    return graphicsRequirements.minApiVersionSupported <= XR_MAKE_VERSION(glMajorVersion, glMinorVersion, 0);
+}
+
 void *GraphicsAPI_OpenGL::CreateDesktopSwapchain(const SwapchainCreateInfo &swapchainCI) { return nullptr; }
 void GraphicsAPI_OpenGL::DestroyDesktopSwapchain(void *&swapchain) {}
 void *GraphicsAPI_OpenGL::GetDesktopSwapchainImage(void *swapchain, uint32_t index) { return nullptr; }
@@ -465,6 +495,11 @@ void *GraphicsAPI_OpenGL::GetGraphicsBinding() {
 }
 // XR_DOCS_TAG_END_GraphicsAPI_OpenGL_GetGraphicsBinding
 
+bool GraphicsAPI_OpenGL::IsMultiviewSupported() {
+    // TYPE_2D_ARRAY image views are attached with glFramebufferTextureMultiviewOVR(). Shaders declare layout(num_views = N) in;
+    return HasGLExtension("GL_OVR_multiview2");
+}
+
 // XR_DOCS_TAG_BEGIN_GraphicsAPI_OpenGL_AllocateSwapchainImageData
 XrSwapchainImageBaseHeader *GraphicsAPI_OpenGL::AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) {
     swapchainImagesMap[swapchain].first = type;
@@ -604,13 +639,26 @@ void *GraphicsAPI_OpenGL::CreateBuffer(const BufferCreateInfo &bufferCI) {
         target = GL_ELEMENT_ARRAY_BUFFER;
     } else if (bufferCI.type == BufferCreateInfo::Type::UNIFORM) {
         target = GL_UNIFORM_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::STORAGE) {
+        target = GL_SHADER_STORAGE_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::INDIRECT) {
+        target = GL_DRAW_INDIRECT_BUFFER;
     } else {
         DEBUG_BREAK;
         std::cout << "ERROR: OPENGL: Unknown Buffer Type." << std::endl;
     }
 
     glBindBuffer(target, buffer);
-    glBufferData(target, (GLsizeiptr)bufferCI.size, bufferCI.data, GL_STATIC_DRAW);
+    if (bufferCI.persistentlyMapped && bufferStorageSupported) {
+        // Immutable, coherent storage can stay mapped while the GPU uses the buffer.
+        PFNGLBUFFERSTORAGEPROC glBufferStorage = (PFNGLBUFFERSTORAGEPROC)GetExtension("glBufferStorage");  // 4.4+ or GL_ARB_buffer_storage
+        PFNGLMAPBUFFERRANGEPROC glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)GetExtension("glMapBufferRange");  // 3.0+
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, (GLsizeiptr)bufferCI.size, bufferCI.data, flags | GL_DYNAMIC_STORAGE_BIT);
+        bufferMappedData[buffer] = glMapBufferRange(target, 0, (GLsizeiptr)bufferCI.size, flags);
+    } else {
+        glBufferData(target, (GLsizeiptr)bufferCI.size, bufferCI.data, GL_STATIC_DRAW);
+    }
     glBindBuffer(target, 0);
 
     buffers[buffer] = bufferCI;
@@ -619,11 +667,17 @@ void *GraphicsAPI_OpenGL::CreateBuffer(const BufferCreateInfo &bufferCI) {
 
 void GraphicsAPI_OpenGL::DestroyBuffer(void *&buffer) {
     GLuint glBuffer = (GLuint)(uint64_t)buffer;
+    bufferMappedData.erase(glBuffer);  // glDeleteBuffers() unmaps the buffer.
     buffers.erase(glBuffer);
     glDeleteBuffers(1, &glBuffer);
     buffer = nullptr;
 }
 
+void *GraphicsAPI_OpenGL::GetBufferMappedData(void *buffer) {
+    auto it = bufferMappedData.find((GLuint)(uint64_t)buffer);
+    return it != bufferMappedData.end() ? it->second : nullptr;
+}
+
 void *GraphicsAPI_OpenGL::CreateShader(const ShaderCreateInfo &shaderCI) {
     GLenum type = 0;
     switch (shaderCI.type) {
@@ -715,14 +769,46 @@ void *GraphicsAPI_OpenGL::CreatePipeline(const PipelineCreateInfo &pipelineCI) {
     return (void *)(uint64_t)program;
 }
 
+void *GraphicsAPI_OpenGL::CreateComputePipeline(const ComputePipelineCreateInfo &pipelineCI) {
+    GLuint program = glCreateProgram();
+    glAttachShader(program, (GLuint)(uint64_t)pipelineCI.shader);
+    glLinkProgram(program);
+
+    PFNGLVALIDATEPROGRAMPROC glValidateProgram = (PFNGLVALIDATEPROGRAMPROC)GetExtension("glValidateProgram");  // 2.0+
+    glValidateProgram(program);
+
+    GLint isLinked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+    if (isLinked == GL_FALSE) {
+        GLint maxLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+
+        std::vector<GLchar> infoLog(maxLength);
+        glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
+        std::cout << infoLog.data() << std::endl;
+        DEBUG_BREAK;
+
+        glDeleteProgram(program);
+    }
+
+    PFNGLDETACHSHADERPROC glDetachShader = (PFNGLDETACHSHADERPROC)GetExtension("glDetachShader");  // 2.0+
+    glDetachShader(program, (GLuint)(uint64_t)pipelineCI.shader);
+
+    computePipelines[program] = pipelineCI;
+
+    return (void *)(uint64_t)program;
+}
+
 void GraphicsAPI_OpenGL::DestroyPipeline(void *&pipeline) {
     GLint program = (GLuint)(uint64_t)pipeline;
     pipelines.erase(program);
+    computePipelines.erase(program);
     glDeleteProgram(program);
     pipeline = nullptr;
 }
 
 void GraphicsAPI_OpenGL::BeginRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     glGenVertexArrays(1, &vertexArray);
     glBindVertexArray(vertexArray);
 
@@ -731,6 +817,7 @@ void GraphicsAPI_OpenGL::BeginRendering() {
 }
 
 void GraphicsAPI_OpenGL::EndRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glDeleteFramebuffers(1, &setFramebuffer);
     setFramebuffer = 0;
@@ -741,7 +828,15 @@ void GraphicsAPI_OpenGL::EndRendering() {
 }
 
 void GraphicsAPI_OpenGL::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
+    XR_TUT_PROFILE_FUNCTION();
     GLuint glBuffer = (GLuint)(uint64_t)buffer;
+    auto it = bufferMappedData.find(glBuffer);
+    if (it != bufferMappedData.end()) {
+        if (data) {
+            memcpy((char *)it->second + offset, data, size);
+        }
+        return;
+    }
     const BufferCreateInfo &bufferCI = buffers[glBuffer];
 
     GLenum target = 0;
@@ -751,6 +846,10 @@ void GraphicsAPI_OpenGL::SetBufferData(void *buffer, size_t offset, size_t size,
         target = GL_ELEMENT_ARRAY_BUFFER;
     } else if (bufferCI.type == BufferCreateInfo::Type::UNIFORM) {
         target = GL_UNIFORM_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::STORAGE) {
+        target = GL_SHADER_STORAGE_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::INDIRECT) {
+        target = GL_DRAW_INDIRECT_BUFFER;
     } else {
         DEBUG_BREAK;
         std::cout << "ERROR: OPENGL: Unknown Buffer Type." << std::endl;
@@ -764,6 +863,7 @@ void GraphicsAPI_OpenGL::SetBufferData(void *buffer, size_t offset, size_t size,
 }
 
 void GraphicsAPI_OpenGL::ClearColor(void *imageView, float r, float g, float b, float a) {
+    XR_TUT_PROFILE_FUNCTION();
     glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)(uint64_t)imageView);
     glClearColor(r, g, b, a);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -771,6 +871,7 @@ void GraphicsAPI_OpenGL::ClearColor(void *imageView, float r, float g, float b,
 }
 
 void GraphicsAPI_OpenGL::ClearDepth(void *imageView, float d) {
+    XR_TUT_PROFILE_FUNCTION();
     glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)(uint64_t)imageView);
     glClearDepth(d);
     glClear(GL_DEPTH_BUFFER_BIT);
@@ -778,6 +879,7 @@ void GraphicsAPI_OpenGL::ClearDepth(void *imageView, float d) {
 }
 
 void GraphicsAPI_OpenGL::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {
+    XR_TUT_PROFILE_FUNCTION();
     // Reset Framebuffer
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glDeleteFramebuffers(1, &setFramebuffer);
@@ -849,6 +951,11 @@ void GraphicsAPI_OpenGL::SetPipeline(void *pipeline) {
     glUseProgram(program);
     setPipeline = program;
 
+    // Compute pipelines carry no fixed-function state.
+    if (computePipelines.find(program) != computePipelines.end()) {
+        return;
+    }
+
     const PipelineCreateInfo &pipelineCI = pipelines[program];
 
     // InputAssemblyState
@@ -1050,7 +1157,11 @@ void GraphicsAPI_OpenGL::SetDescriptor(const DescriptorInfo &descriptorInfo) {
     const GLuint &bindingIndex = descriptorInfo.bindingIndex;
     if (descriptorInfo.type == DescriptorInfo::Type::BUFFER) {
         PFNGLBINDBUFFERRANGEPROC glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC)GetExtension("glBindBufferRange");  // 3.0+
-        glBindBufferRange(GL_UNIFORM_BUFFER, bindingIndex, glResource, (GLintptr)descriptorInfo.bufferOffset, (GLsizeiptr)descriptorInfo.bufferSize);
+        GLenum target = descriptorInfo.readWrite ? GL_SHADER_STORAGE_BUFFER : GL_UNIFORM_BUFFER;
+        glBindBufferRange(target, bindingIndex, glResource, (GLintptr)descriptorInfo.bufferOffset, (GLsizeiptr)descriptorInfo.bufferSize);
+    } else if (descriptorInfo.type == DescriptorInfo::Type::IMAGE && descriptorInfo.readWrite) {
+        PFNGLBINDIMAGETEXTUREPROC glBindImageTexture = (PFNGLBINDIMAGETEXTUREPROC)GetExtension("glBindImageTexture");  // 4.2+
+        glBindImageTexture(bindingIndex, glResource, 0, GL_TRUE, 0, GL_READ_WRITE, (GLenum)images[glResource].format);
     } else if (descriptorInfo.type == DescriptorInfo::Type::IMAGE) {
         glActiveTexture(GL_TEXTURE0 + bindingIndex);
         glBindTexture(GetGLTextureTarget(images[glResource]), glResource);
@@ -1066,11 +1177,13 @@ void GraphicsAPI_OpenGL::UpdateDescriptors() {
 }
 
 void GraphicsAPI_OpenGL::SetVertexBuffers(void **vertexBuffers, size_t count) {
+    PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)GetExtension("glVertexAttribDivisor");  // 3.3+
+
     const VertexInputState &vertexInputState = pipelines[setPipeline].vertexInputState;
     for (size_t i = 0; i < count; i++) {
         GLuint glVertexBufferID = (GLuint)(uint64_t)vertexBuffers[i];
-        if (buffers[glVertexBufferID].type != BufferCreateInfo::Type::VERTEX) {
-            std::cout << "ERROR: OpenGL: Provided buffer is not type: VERTEX." << std::endl;
+        if (buffers[glVertexBufferID].type != BufferCreateInfo::Type::VERTEX && buffers[glVertexBufferID].type != BufferCreateInfo::Type::STORAGE) {
+            std::cout << "ERROR: OpenGL: Provided buffer is not type: VERTEX or STORAGE." << std::endl;
         }
 
         glBindBuffer(GL_ARRAY_BUFFER, (GLuint)(uint64_t)vertexBuffers[i]);
@@ -1086,8 +1199,10 @@ void GraphicsAPI_OpenGL::SetVertexBuffers(void **vertexBuffers, size_t count) {
                                                                                                                                                                                        : GL_FLOAT;
                         GLsizei stride = vertexBinding.stride;
                         const void *offset = (const void *)vertexAttribute.offset;
+                        GLuint divisor = vertexBinding.inputRate == VertexInputRate::PER_INSTANCE ? 1 : 0;
                         glEnableVertexAttribArray(attribIndex);
                         glVertexAttribPointer(attribIndex, size, type, false, stride, offset);
+                        glVertexAttribDivisor(attribIndex, divisor);
                     }
                 }
             }
@@ -1097,24 +1212,51 @@ void GraphicsAPI_OpenGL::SetVertexBuffers(void **vertexBuffers, size_t count) {
 
 void GraphicsAPI_OpenGL::SetIndexBuffer(void *indexBuffer) {
     GLuint glIndexBufferID = (GLuint)(uint64_t)indexBuffer;
-    if (buffers[glIndexBufferID].type != BufferCreateInfo::Type::INDEX) {
-        std::cout << "ERROR: OpenGL: Provided buffer is not type: INDEX." << std::endl;
+    if (buffers[glIndexBufferID].type != BufferCreateInfo::Type::INDEX && buffers[glIndexBufferID].type != BufferCreateInfo::Type::STORAGE) {
+        std::cout << "ERROR: OpenGL: Provided buffer is not type: INDEX or STORAGE." << std::endl;
     }
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glIndexBufferID);
     setIndexBuffer = glIndexBufferID;
 }
 
 void GraphicsAPI_OpenGL::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC glDrawElementsInstancedBaseVertexBaseInstance = (PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC)GetExtension("glDrawElementsInstancedBaseVertexBaseInstance");  // 4.2+
     GLenum indexType = buffers[setIndexBuffer].stride == 4 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
     glDrawElementsInstancedBaseVertexBaseInstance(ToGLTopology(pipelines[setPipeline].inputAssemblyState.topology), indexCount, indexType, nullptr, instanceCount, vertexOffset, firstInstance);
 }
 
 void GraphicsAPI_OpenGL::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC glDrawArraysInstancedBaseInstance = (PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC)GetExtension("glDrawArraysInstancedBaseInstance");  // 4.2+
     glDrawArraysInstancedBaseInstance(ToGLTopology(pipelines[setPipeline].inputAssemblyState.topology), firstVertex, vertexCount, instanceCount, firstInstance);
 }
 
+void GraphicsAPI_OpenGL::DrawIndexedIndirect(void *buffer, size_t offset, uint32_t drawCount, uint32_t stride) {
+    PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)GetExtension("glMultiDrawElementsIndirect");  // 4.3+
+    GLenum indexType = buffers[setIndexBuffer].stride == 4 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, (GLuint)(uint64_t)buffer);
+    glMultiDrawElementsIndirect(ToGLTopology(pipelines[setPipeline].inputAssemblyState.topology), indexType, (const void *)offset, drawCount, stride);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void GraphicsAPI_OpenGL::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    XR_TUT_PROFILE_FUNCTION();
+    PFNGLDISPATCHCOMPUTEPROC glDispatchCompute = (PFNGLDISPATCHCOMPUTEPROC)GetExtension("glDispatchCompute");  // 4.3+
+    PFNGLMEMORYBARRIERPROC glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)GetExtension("glMemoryBarrier");          // 4.2+
+    glDispatchCompute(groupCountX, groupCountY, groupCountZ);
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
+void GraphicsAPI_OpenGL::DispatchIndirect(void *buffer, size_t offset) {
+    PFNGLDISPATCHCOMPUTEINDIRECTPROC glDispatchComputeIndirect = (PFNGLDISPATCHCOMPUTEINDIRECTPROC)GetExtension("glDispatchComputeIndirect");  // 4.3+
+    PFNGLMEMORYBARRIERPROC glMemoryBarrier = (PFNGLMEMORYBARRIERPROC)GetExtension("glMemoryBarrier");                                          // 4.2+
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, (GLuint)(uint64_t)buffer);
+    glDispatchComputeIndirect((GLintptr)offset);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
 // XR_DOCS_TAG_BEGIN_GraphicsAPI_OpenGL_GetSupportedSwapchainFormats
 const std::vector<int64_t> GraphicsAPI_OpenGL::GetSupportedColorSwapchainFormats() {
     // https://github.com/KhronosGroup/OpenXR-SDK-Source/blob/f122f9f1fc729e2dc82e12c3ce73efa875182854/src/tests/hello_xr/graphicsplugin_opengl.cpp#L229-L236
@@ -24,7 +24,10 @@ public:
     virtual int64_t GetDepthFormat() override { return (int64_t)GL_DEPTH_COMPONENT32F; }
     // XR_DOCS_TAG_END_GetDepthFormat_OpenGL
 
+    virtual bool IsMultiviewSupported() override;
+
     virtual void* GetGraphicsBinding() override;
+    virtual bool RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) override;
     virtual XrSwapchainImageBaseHeader* AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) override;
     virtual void FreeSwapchainImageData(XrSwapchain swapchain) override {
         swapchainImagesMap[swapchain].second.clear();
@@ -46,11 +49,13 @@ public:
 
     virtual void* CreateBuffer(const BufferCreateInfo& bufferCI) override;
     virtual void DestroyBuffer(void*& buffer) override;
+    virtual void* GetBufferMappedData(void* buffer) override;
 
     virtual void* CreateShader(const ShaderCreateInfo& shaderCI) override;
     virtual void DestroyShader(void*& shader) override;
 
     virtual void* CreatePipeline(const PipelineCreateInfo& pipelineCI) override;
+    virtual void* CreateComputePipeline(const ComputePipelineCreateInfo& pipelineCI) override;
     virtual void DestroyPipeline(void*& pipeline) override;
 
     virtual void BeginRendering() override;
@@ -72,6 +77,10 @@ public:
     virtual void SetIndexBuffer(void* indexBuffer) override;
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
+    virtual void DrawIndexedIndirect(void* buffer, size_t offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+    virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) override;
+    virtual void DispatchIndirect(void* buffer, size_t offset = 0) override;
 
 private:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() override;
@@ -79,6 +88,7 @@ private:
 
 private:
     ksGpuWindow window{};
+    bool bufferStorageSupported = false;  // OpenGL 4.4 or GL_ARB_buffer_storage: glBufferStorage() for persistently mapped buffers.
 
     PFN_xrGetOpenGLGraphicsRequirementsKHR xrGetOpenGLGraphicsRequirementsKHR = nullptr;
 #if defined(XR_USE_PLATFORM_WIN32)
@@ -94,11 +104,13 @@ private:
     std::unordered_map<XrSwapchain, std::pair<SwapchainType, std::vector<XrSwapchainImageOpenGLKHR>>> swapchainImagesMap{};
 
     std::unordered_map<GLuint, BufferCreateInfo> buffers{};
+    std::unordered_map<GLuint, void *> bufferMappedData{};
     std::unordered_map<GLuint, ImageCreateInfo> images{};
     std::unordered_map<GLuint, ImageViewCreateInfo> imageViews{};
 
     GLuint setFramebuffer = 0;
     std::unordered_map<GLuint, PipelineCreateInfo> pipelines{};
+    std::unordered_map<GLuint, ComputePipelineCreateInfo> computePipelines{};
     GLuint setPipeline = 0;
     GLuint vertexArray = 0;
     GLuint setIndexBuffer = 0;
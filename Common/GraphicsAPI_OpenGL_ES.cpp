@@ -420,6 +420,20 @@ GraphicsAPI_OpenGL_ES::~GraphicsAPI_OpenGL_ES() {
 }
 // XR_DOCS_TAG_END_GraphicsAPI_OpenGL_ES
 
+bool GraphicsAPI_OpenGL_ES::RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) {
+    XR_TUT_PROFILE_FUNCTION();
+    OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetOpenGLESGraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetOpenGLESGraphicsRequirementsKHR), "Failed to get InstanceProcAddr for xrGetOpenGLESGraphicsRequirementsKHR.");
+    XrGraphicsRequirementsOpenGLESKHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_OPENGL_ES_KHR};
+    OPENXR_CHECK(xrGetOpenGLESGraphicsRequirementsKHR(m_xrInstance, systemId, &graphicsRequirements), "Failed to get Graphics Requirements for OpenGLES.");
+
+    // The context can be kept if its version still meets the runtime's requirements.
+    GLint glMajorVersion = 0;
+    GLint glMinorVersion = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &glMajorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &glMinorVersion);
+    return graphicsRequirements.minApiVersionSupported <= XR_MAKE_VERSION(glMajorVersion, glMinorVersion, 0);
+}
+
 void *GraphicsAPI_OpenGL_ES::CreateDesktopSwapchain(const SwapchainCreateInfo &swapchainCI) { return nullptr; }
 void GraphicsAPI_OpenGL_ES::DestroyDesktopSwapchain(void *&swapchain) {}
 void *GraphicsAPI_OpenGL_ES::GetDesktopSwapchainImage(void *swapchain, uint32_t index) { return nullptr; }
@@ -436,6 +450,18 @@ void *GraphicsAPI_OpenGL_ES::GetGraphicsBinding() {
 }
 // XR_DOCS_TAG_END_GraphicsAPI_OpenGL_ES_GetGraphicsBinding
 
+bool GraphicsAPI_OpenGL_ES::IsMultiviewSupported() {
+    // TYPE_2D_ARRAY image views are attached with glFramebufferTextureMultiviewOVR(). Shaders declare layout(num_views = N) in;
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; i++) {
+        if (strcmp((const char *)glGetStringi(GL_EXTENSIONS, (GLuint)i), "GL_OVR_multiview2") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // XR_DOCS_TAG_BEGIN_GraphicsAPI_OpenGL_ES_AllocateSwapchainImageData
 XrSwapchainImageBaseHeader *GraphicsAPI_OpenGL_ES::AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) {
     swapchainImagesMap[swapchain].first = type;
@@ -568,6 +594,10 @@ void *GraphicsAPI_OpenGL_ES::CreateBuffer(const BufferCreateInfo &bufferCI) {
         target = GL_ELEMENT_ARRAY_BUFFER;
     } else if (bufferCI.type == BufferCreateInfo::Type::UNIFORM) {
         target = GL_UNIFORM_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::STORAGE) {
+        target = GL_SHADER_STORAGE_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::INDIRECT) {
+        target = GL_DRAW_INDIRECT_BUFFER;
     } else {
         DEBUG_BREAK;
         std::cout << "ERROR: OPENGL: Unknown Buffer Type." << std::endl;
@@ -675,14 +705,44 @@ void *GraphicsAPI_OpenGL_ES::CreatePipeline(const PipelineCreateInfo &pipelineCI
     return (void *)(uint64_t)program;
 }
 
+void *GraphicsAPI_OpenGL_ES::CreateComputePipeline(const ComputePipelineCreateInfo &pipelineCI) {
+    GLuint program = glCreateProgram();
+    glAttachShader(program, (GLuint)(uint64_t)pipelineCI.shader);
+    glLinkProgram(program);
+
+    glValidateProgram(program);
+
+    GLint isLinked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+    if (isLinked == GL_FALSE) {
+        GLint maxLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+
+        std::vector<GLchar> infoLog(maxLength);
+        glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
+        std::cout << infoLog.data() << std::endl;
+        DEBUG_BREAK;
+
+        glDeleteProgram(program);
+    }
+
+    glDetachShader(program, (GLuint)(uint64_t)pipelineCI.shader);
+
+    computePipelines[program] = pipelineCI;
+
+    return (void *)(uint64_t)program;
+}
+
 void GraphicsAPI_OpenGL_ES::DestroyPipeline(void *&pipeline) {
     GLint program = (GLuint)(uint64_t)pipeline;
     pipelines.erase(program);
+    computePipelines.erase(program);
     glDeleteProgram(program);
     pipeline = nullptr;
 }
 
 void GraphicsAPI_OpenGL_ES::BeginRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     glGenVertexArrays(1, &vertexArray);
     glBindVertexArray(vertexArray);
 
@@ -691,6 +751,7 @@ void GraphicsAPI_OpenGL_ES::BeginRendering() {
 }
 
 void GraphicsAPI_OpenGL_ES::EndRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glDeleteFramebuffers(1, &setFramebuffer);
     setFramebuffer = 0;
@@ -701,6 +762,7 @@ void GraphicsAPI_OpenGL_ES::EndRendering() {
 }
 
 void GraphicsAPI_OpenGL_ES::ClearColor(void *imageView, float r, float g, float b, float a) {
+    XR_TUT_PROFILE_FUNCTION();
     glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)(uint64_t)imageView);
     glClearColor(r, g, b, a);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -708,6 +770,7 @@ void GraphicsAPI_OpenGL_ES::ClearColor(void *imageView, float r, float g, float
 }
 
 void GraphicsAPI_OpenGL_ES::ClearDepth(void *imageView, float d) {
+    XR_TUT_PROFILE_FUNCTION();
     glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)(uint64_t)imageView);
     glClearDepthf(d);
     glClear(GL_DEPTH_BUFFER_BIT);
@@ -715,6 +778,7 @@ void GraphicsAPI_OpenGL_ES::ClearDepth(void *imageView, float d) {
 }
 
 void GraphicsAPI_OpenGL_ES::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
+    XR_TUT_PROFILE_FUNCTION();
     GLuint glBuffer = (GLuint)(uint64_t)buffer;
     const BufferCreateInfo &bufferCI = buffers[glBuffer];
 
@@ -725,6 +789,10 @@ void GraphicsAPI_OpenGL_ES::SetBufferData(void *buffer, size_t offset, size_t si
         target = GL_ELEMENT_ARRAY_BUFFER;
     } else if (bufferCI.type == BufferCreateInfo::Type::UNIFORM) {
         target = GL_UNIFORM_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::STORAGE) {
+        target = GL_SHADER_STORAGE_BUFFER;
+    } else if (bufferCI.type == BufferCreateInfo::Type::INDIRECT) {
+        target = GL_DRAW_INDIRECT_BUFFER;
     } else {
         DEBUG_BREAK;
         std::cout << "ERROR: OPENGL: Unknown Buffer Type." << std::endl;
@@ -738,6 +806,7 @@ void GraphicsAPI_OpenGL_ES::SetBufferData(void *buffer, size_t offset, size_t si
 }
 
 void GraphicsAPI_OpenGL_ES::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {
+    XR_TUT_PROFILE_FUNCTION();
     // Reset Framebuffer
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glDeleteFramebuffers(1, &setFramebuffer);
@@ -800,6 +869,11 @@ void GraphicsAPI_OpenGL_ES::SetPipeline(void *pipeline) {
     glUseProgram(program);
     setPipeline = program;
 
+    // Compute pipelines carry no fixed-function state.
+    if (computePipelines.find(program) != computePipelines.end()) {
+        return;
+    }
+
     const PipelineCreateInfo &pipelineCI = pipelines[program];
 
     // InputAssemblyState
@@ -988,7 +1062,10 @@ void GraphicsAPI_OpenGL_ES::SetDescriptor(const DescriptorInfo &descriptorInfo)
     GLuint glResource = (GLuint)(uint64_t)descriptorInfo.resource;
     const GLuint &bindingIndex = descriptorInfo.bindingIndex;
     if (descriptorInfo.type == DescriptorInfo::Type::BUFFER) {
-        glBindBufferRange(GL_UNIFORM_BUFFER, bindingIndex, glResource, (GLintptr)descriptorInfo.bufferOffset, (GLsizeiptr)descriptorInfo.bufferSize);
+        GLenum target = descriptorInfo.readWrite ? GL_SHADER_STORAGE_BUFFER : GL_UNIFORM_BUFFER;
+        glBindBufferRange(target, bindingIndex, glResource, (GLintptr)descriptorInfo.bufferOffset, (GLsizeiptr)descriptorInfo.bufferSize);
+    } else if (descriptorInfo.type == DescriptorInfo::Type::IMAGE && descriptorInfo.readWrite) {
+        glBindImageTexture(bindingIndex, glResource, 0, GL_TRUE, 0, GL_READ_WRITE, (GLenum)images[glResource].format);
     } else if (descriptorInfo.type == DescriptorInfo::Type::IMAGE) {
         glActiveTexture(GL_TEXTURE0 + bindingIndex);
         glBindTexture(GetGLTextureTarget(images[glResource]), glResource);
@@ -1006,8 +1083,8 @@ void GraphicsAPI_OpenGL_ES::SetVertexBuffers(void **vertexBuffers, size_t count)
     const VertexInputState &vertexInputState = pipelines[setPipeline].vertexInputState;
     for (size_t i = 0; i < count; i++) {
         GLuint glVertexBufferID = (GLuint)(uint64_t)vertexBuffers[i];
-        if (buffers[glVertexBufferID].type != BufferCreateInfo::Type::VERTEX) {
-            std::cout << "ERROR: OpenGL: Provided buffer is not type: VERTEX." << std::endl;
+        if (buffers[glVertexBufferID].type != BufferCreateInfo::Type::VERTEX && buffers[glVertexBufferID].type != BufferCreateInfo::Type::STORAGE) {
+            std::cout << "ERROR: OpenGL: Provided buffer is not type: VERTEX or STORAGE." << std::endl;
         }
 
         glBindBuffer(GL_ARRAY_BUFFER, (GLuint)(uint64_t)vertexBuffers[i]);
@@ -1023,8 +1100,10 @@ void GraphicsAPI_OpenGL_ES::SetVertexBuffers(void **vertexBuffers, size_t count)
                                                                                                                                                                                        : GL_FLOAT;
                         GLsizei stride = vertexBinding.stride;
                         const void *offset = (const void *)vertexAttribute.offset;
+                        GLuint divisor = vertexBinding.inputRate == VertexInputRate::PER_INSTANCE ? 1 : 0;
                         glEnableVertexAttribArray(attribIndex);
                         glVertexAttribPointer(attribIndex, size, type, false, stride, offset);
+                        glVertexAttribDivisor(attribIndex, divisor);
                     }
                 }
             }
@@ -1034,22 +1113,47 @@ void GraphicsAPI_OpenGL_ES::SetVertexBuffers(void **vertexBuffers, size_t count)
 
 void GraphicsAPI_OpenGL_ES::SetIndexBuffer(void *indexBuffer) {
     GLuint glIndexBufferID = (GLuint)(uint64_t)indexBuffer;
-    if (buffers[glIndexBufferID].type != BufferCreateInfo::Type::INDEX) {
-        std::cout << "ERROR: OpenGL: Provided buffer is not type: INDEX." << std::endl;
+    if (buffers[glIndexBufferID].type != BufferCreateInfo::Type::INDEX && buffers[glIndexBufferID].type != BufferCreateInfo::Type::STORAGE) {
+        std::cout << "ERROR: OpenGL: Provided buffer is not type: INDEX or STORAGE." << std::endl;
     }
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glIndexBufferID);
     setIndexBuffer = glIndexBufferID;
 }
 
 void GraphicsAPI_OpenGL_ES::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     GLenum indexType = buffers[setIndexBuffer].stride == 4 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
     glDrawElementsInstanced(ToGLTopology(pipelines[setPipeline].inputAssemblyState.topology),indexCount, indexType, nullptr,instanceCount);
 }
 
 void GraphicsAPI_OpenGL_ES::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     glDrawArraysInstanced(ToGLTopology(pipelines[setPipeline].inputAssemblyState.topology), firstVertex, vertexCount, instanceCount);
 }
 
+void GraphicsAPI_OpenGL_ES::DrawIndexedIndirect(void *buffer, size_t offset, uint32_t drawCount, uint32_t stride) {
+    // OpenGL ES 3.1 has no multi-draw indirect, so issue each record separately. Each record's firstInstance must be 0.
+    GLenum indexType = buffers[setIndexBuffer].stride == 4 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, (GLuint)(uint64_t)buffer);
+    for (uint32_t i = 0; i < drawCount; i++) {
+        glDrawElementsIndirect(ToGLTopology(pipelines[setPipeline].inputAssemblyState.topology), indexType, (const void *)(offset + size_t(i) * stride));
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void GraphicsAPI_OpenGL_ES::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    XR_TUT_PROFILE_FUNCTION();
+    glDispatchCompute(groupCountX, groupCountY, groupCountZ);
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
+void GraphicsAPI_OpenGL_ES::DispatchIndirect(void *buffer, size_t offset) {
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, (GLuint)(uint64_t)buffer);
+    glDispatchComputeIndirect((GLintptr)offset);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
 // XR_DOCS_TAG_BEGIN_GraphicsAPI_OpenGL_ES_GetSupportedSwapchainFormats
 const std::vector<int64_t> GraphicsAPI_OpenGL_ES::GetSupportedColorSwapchainFormats() {
     // https://github.com/KhronosGroup/OpenXR-SDK-Source/blob/f122f9f1fc729e2dc82e12c3ce73efa875182854/src/tests/hello_xr/graphicsplugin_opengles.cpp#L208-L216
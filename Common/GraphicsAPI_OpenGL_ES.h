@@ -24,7 +24,10 @@ public:
     virtual int64_t GetDepthFormat() override { return (int64_t)GL_DEPTH_COMPONENT32F; }
     // XR_DOCS_TAG_END_GetDepthFormat_OpenGL_ES
 
+    virtual bool IsMultiviewSupported() override;
+
     virtual void* GetGraphicsBinding() override;
+    virtual bool RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) override;
     virtual XrSwapchainImageBaseHeader* AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) override;
     virtual void FreeSwapchainImageData(XrSwapchain swapchain) override {
         swapchainImagesMap[swapchain].second.clear();
@@ -51,6 +54,7 @@ public:
     virtual void DestroyShader(void*& shader) override;
 
     virtual void* CreatePipeline(const PipelineCreateInfo& pipelineCI) override;
+    virtual void* CreateComputePipeline(const ComputePipelineCreateInfo& pipelineCI) override;
     virtual void DestroyPipeline(void*& pipeline) override;
 
     virtual void BeginRendering() override;
@@ -72,6 +76,10 @@ public:
     virtual void SetIndexBuffer(void* indexBuffer) override;
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
+    virtual void DrawIndexedIndirect(void* buffer, size_t offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+    virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) override;
+    virtual void DispatchIndirect(void* buffer, size_t offset = 0) override;
 
 private:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() override;
@@ -91,6 +99,7 @@ private:
 
     GLuint setFramebuffer = 0;
     std::unordered_map<GLuint, PipelineCreateInfo> pipelines{};
+    std::unordered_map<GLuint, ComputePipelineCreateInfo> computePipelines{};
     GLuint setPipeline = 0;
     GLuint vertexArray = 0;
     GLuint setIndexBuffer = 0;
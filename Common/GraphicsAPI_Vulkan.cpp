@@ -114,13 +114,12 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan() {
 #else
     const std::vector<std::string> &instanceExtensionNames = {};
 #endif
+    for (const VkExtensionProperties &extensionProperty : instanceExtensionProperties) {
+        availableInstanceExtensions.Add(extensionProperty.extensionName);
+    }
     for (const std::string &requestExtension : instanceExtensionNames) {
-        for (const VkExtensionProperties &extensionProperty : instanceExtensionProperties) {
-            if (strcmp(requestExtension.c_str(), extensionProperty.extensionName))
-                continue;
-            else
-                activeInstanceExtensions.push_back(requestExtension.c_str());
-            break;
+        if (availableInstanceExtensions.Has(requestExtension.c_str())) {
+            activeInstanceExtensions.push_back(enabledInstanceExtensions.Add(requestExtension.c_str()));
         }
     }
 
@@ -181,18 +180,20 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan() {
 
     VULKAN_CHECK(vkEnumerateDeviceExtensionProperties(physicalDevice, 0, &deviceExtensionCount, deviceExtensionProperties.data()), "Failed to enumerate DeviceExtensionProperties.");
     const std::vector<std::string> &deviceExtensionNames = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+    for (const VkExtensionProperties &extensionProperty : deviceExtensionProperties) {
+        availableDeviceExtensions.Add(extensionProperty.extensionName);
+    }
     for (const std::string &requestExtension : deviceExtensionNames) {
-        for (const VkExtensionProperties &extensionProperty : deviceExtensionProperties) {
-            if (strcmp(requestExtension.c_str(), extensionProperty.extensionName))
-                continue;
-            else
-                activeDeviceExtensions.push_back(requestExtension.c_str());
-            break;
+        if (availableDeviceExtensions.Has(requestExtension.c_str())) {
+            activeDeviceExtensions.push_back(enabledDeviceExtensions.Add(requestExtension.c_str()));
         }
     }
 
+    // Every core feature the physical device supports is enabled. Without multiDrawIndirect, DrawIndexedIndirect()
+    // records one draw per command.
     VkPhysicalDeviceFeatures features;
     vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+    multiDrawIndirectSupported = features.multiDrawIndirect == VK_TRUE;
 
     VkDeviceCreateInfo deviceCI;
     deviceCI.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -272,13 +273,12 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
     instanceExtensionProperties.resize(instanceExtensionCount);
     VULKAN_CHECK(vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionCount, instanceExtensionProperties.data()), "Failed to enumerate InstanceExtensionProperties.");
     const std::vector<std::string> &openXrInstanceExtensionNames = GetInstanceExtensionsForOpenXR(m_xrInstance, systemId);
+    for (const VkExtensionProperties &extensionProperty : instanceExtensionProperties) {
+        availableInstanceExtensions.Add(extensionProperty.extensionName);
+    }
     for (const std::string &requestExtension : openXrInstanceExtensionNames) {
-        for (const VkExtensionProperties &extensionProperty : instanceExtensionProperties) {
-            if (strcmp(requestExtension.c_str(), extensionProperty.extensionName))
-                continue;
-            else
-                activeInstanceExtensions.push_back(requestExtension.c_str());
-            break;
+        if (availableInstanceExtensions.Has(requestExtension.c_str())) {
+            activeInstanceExtensions.push_back(enabledInstanceExtensions.Add(requestExtension.c_str()));
         }
     }
 
@@ -346,18 +346,20 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
 
     VULKAN_CHECK(vkEnumerateDeviceExtensionProperties(physicalDevice, 0, &deviceExtensionCount, deviceExtensionProperties.data()), "Failed to enumerate DeviceExtensionProperties.");
     const std::vector<std::string> &openXrDeviceExtensionNames = GetDeviceExtensionsForOpenXR(m_xrInstance, systemId);
+    for (const VkExtensionProperties &extensionProperty : deviceExtensionProperties) {
+        availableDeviceExtensions.Add(extensionProperty.extensionName);
+    }
     for (const std::string &requestExtension : openXrDeviceExtensionNames) {
-        for (const VkExtensionProperties &extensionProperty : deviceExtensionProperties) {
-            if (strcmp(requestExtension.c_str(), extensionProperty.extensionName))
-                continue;
-            else
-                activeDeviceExtensions.push_back(requestExtension.c_str());
-            break;
+        if (availableDeviceExtensions.Has(requestExtension.c_str())) {
+            activeDeviceExtensions.push_back(enabledDeviceExtensions.Add(requestExtension.c_str()));
         }
     }
 
+    // Every core feature the physical device supports is enabled. Without multiDrawIndirect, DrawIndexedIndirect()
+    // records one draw per command.
     VkPhysicalDeviceFeatures features;
     vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+    multiDrawIndirectSupported = features.multiDrawIndirect == VK_TRUE;
 
     VkDeviceCreateInfo deviceCI;
     deviceCI.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -395,6 +397,19 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
     fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
     VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &fence), "Failed to create Fence.")
 
+    // GPU timing: only when the graphics queue family can write timestamps.
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    const uint32_t timestampValidBits = queueFamilyProperties[queueFamilyIndex].timestampValidBits;
+    if (timestampValidBits > 0 && physicalDeviceProperties.limits.timestampPeriod > 0.0f) {
+        VkQueryPoolCreateInfo queryPoolCI{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        queryPoolCI.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolCI.queryCount = 2;
+        VULKAN_CHECK(vkCreateQueryPool(device, &queryPoolCI, nullptr, &timestampQueryPool), "Failed to create QueryPool.");
+        timestampPeriod = physicalDeviceProperties.limits.timestampPeriod;
+        timestampMask = timestampValidBits >= 64 ? ~uint64_t(0) : (uint64_t(1) << timestampValidBits) - 1;
+    }
+
     uint32_t maxSets = 1024;
     std::vector<VkDescriptorPoolSize> poolSizes{
         {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
@@ -416,6 +431,10 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
 GraphicsAPI_Vulkan::~GraphicsAPI_Vulkan() {
     vkDestroyDescriptorPool(device, descriptorPool, nullptr);
 
+    if (timestampQueryPool) {
+        vkDestroyQueryPool(device, timestampQueryPool, nullptr);
+    }
+
     vkDestroyFence(device, fence, nullptr);
 
     vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
@@ -426,6 +445,35 @@ GraphicsAPI_Vulkan::~GraphicsAPI_Vulkan() {
 }
 // XR_DOCS_TAG_END_GraphicsAPI_Vulkan
 
+bool GraphicsAPI_Vulkan::RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) {
+    XR_TUT_PROFILE_FUNCTION();
+    LoadPFN_XrFunctions(m_xrInstance);
+
+    XrGraphicsRequirementsVulkanKHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_VULKAN_KHR};
+    OPENXR_CHECK(xrGetVulkanGraphicsRequirementsKHR(m_xrInstance, systemId, &graphicsRequirements), "Failed to get Graphics Requirements for Vulkan.");
+
+    // The device can be kept if it was created from the physical device that the runtime wants.
+    VkPhysicalDevice physicalDeviceFromXR = VK_NULL_HANDLE;
+    OPENXR_CHECK(xrGetVulkanGraphicsDeviceKHR(m_xrInstance, systemId, instance, &physicalDeviceFromXR), "Failed to get Graphics Device for Vulkan.");
+    if (physicalDeviceFromXR != physicalDevice) {
+        return false;
+    }
+
+    // And if it has every extension the new instance requires. Extensions that were not available when the VkInstance
+    // and VkDevice were created would not be enabled by recreating them either.
+    for (const std::string &requestExtension : GetInstanceExtensionsForOpenXR(m_xrInstance, systemId)) {
+        if (availableInstanceExtensions.Has(requestExtension.c_str()) && !enabledInstanceExtensions.Has(requestExtension.c_str())) {
+            return false;
+        }
+    }
+    for (const std::string &requestExtension : GetDeviceExtensionsForOpenXR(m_xrInstance, systemId)) {
+        if (availableDeviceExtensions.Has(requestExtension.c_str()) && !enabledDeviceExtensions.Has(requestExtension.c_str())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void *GraphicsAPI_Vulkan::CreateDesktopSwapchain(const SwapchainCreateInfo &swapchainCI) {
     VkSurfaceKHR surface{};
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
@@ -585,6 +633,11 @@ XrSwapchainImageBaseHeader *GraphicsAPI_Vulkan::AllocateSwapchainImageData(XrSwa
 }
 // XR_DOCS_TAG_END_GraphicsAPI_Vulkan_AllocateSwapchainImageData
 
+void GraphicsAPI_Vulkan::FreeSwapchainImageData(XrSwapchain swapchain) {
+    swapchainImagesMap[swapchain].second.clear();
+    swapchainImagesMap.erase(swapchain);
+}
+
 void *GraphicsAPI_Vulkan::CreateImage(const ImageCreateInfo &imageCI) {
     VkImage image{};
     VkImageCreateInfo vkImageCI;
@@ -707,6 +760,11 @@ void *GraphicsAPI_Vulkan::CreateBuffer(const BufferCreateInfo &bufferCI) {
     vkBufferCI.flags = 0;
     vkBufferCI.size = static_cast<VkDeviceSize>(bufferCI.size);
     vkBufferCI.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | (bufferCI.type == BufferCreateInfo::Type::VERTEX ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT : 0) | (bufferCI.type == BufferCreateInfo::Type::INDEX ? VK_BUFFER_USAGE_INDEX_BUFFER_BIT : 0) | (bufferCI.type == BufferCreateInfo::Type::UNIFORM ? VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT : 0);
+    if (bufferCI.type == BufferCreateInfo::Type::STORAGE) {
+        vkBufferCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    } else if (bufferCI.type == BufferCreateInfo::Type::INDIRECT) {
+        vkBufferCI.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
     vkBufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     vkBufferCI.queueFamilyIndexCount = 0;
     vkBufferCI.pQueueFamilyIndices = nullptr;
@@ -729,6 +787,12 @@ void *GraphicsAPI_Vulkan::CreateBuffer(const BufferCreateInfo &bufferCI) {
     VULKAN_CHECK(vkBindBufferMemory(device, buffer, memory, 0), "Failed to bind Memory to Buffer.");
 
     bufferResources[buffer] = {memory, bufferCI};
+    if (bufferCI.persistentlyMapped) {
+        // The memory is HOST_COHERENT, so it can stay mapped while the GPU uses the buffer.
+        void *mappedData = nullptr;
+        VULKAN_CHECK(vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mappedData), "Can not map Buffer.");
+        bufferMappedData[buffer] = mappedData;
+    }
     SetBufferData((void *)buffer, 0, bufferCI.size, bufferCI.data);
 
     return (void *)buffer;
@@ -737,12 +801,20 @@ void *GraphicsAPI_Vulkan::CreateBuffer(const BufferCreateInfo &bufferCI) {
 void GraphicsAPI_Vulkan::DestroyBuffer(void *&buffer) {
     VkBuffer vkBuffer = (VkBuffer)buffer;
     VkDeviceMemory memory = bufferResources[vkBuffer].first;
+    if (bufferMappedData.erase(vkBuffer)) {
+        vkUnmapMemory(device, memory);
+    }
     vkFreeMemory(device, memory, nullptr);
     vkDestroyBuffer(device, vkBuffer, nullptr);
     bufferResources.erase(vkBuffer);
     buffer = nullptr;
 }
 
+void *GraphicsAPI_Vulkan::GetBufferMappedData(void *buffer) {
+    auto it = bufferMappedData.find((VkBuffer)buffer);
+    return it != bufferMappedData.end() ? it->second : nullptr;
+}
+
 void *GraphicsAPI_Vulkan::CreateShader(const ShaderCreateInfo &shaderCI) {
     VkShaderModule shaderModule{};
     VkShaderModuleCreateInfo shaderModuleCI;
@@ -886,7 +958,7 @@ void *GraphicsAPI_Vulkan::CreatePipeline(const PipelineCreateInfo &pipelineCI) {
     std::vector<VkVertexInputBindingDescription> vkVertexInputBindingDescriptions;
     vkVertexInputBindingDescriptions.reserve(pipelineCI.vertexInputState.bindings.size());
     for (auto &binding : pipelineCI.vertexInputState.bindings)
-        vkVertexInputBindingDescriptions.push_back({binding.bindingIndex, (uint32_t)binding.stride, VK_VERTEX_INPUT_RATE_VERTEX});
+        vkVertexInputBindingDescriptions.push_back({binding.bindingIndex, (uint32_t)binding.stride, binding.inputRate == VertexInputRate::PER_INSTANCE ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX});
 
     std::vector<VkVertexInputAttributeDescription> vkVertexInputAttributeDescriptions;
     vkVertexInputAttributeDescriptions.reserve(pipelineCI.vertexInputState.attributes.size());
@@ -1053,12 +1125,72 @@ void *GraphicsAPI_Vulkan::CreatePipeline(const PipelineCreateInfo &pipelineCI) {
     return (void *)pipeline;
 }
 
+void *GraphicsAPI_Vulkan::CreateComputePipeline(const ComputePipelineCreateInfo &pipelineCI) {
+    // Pipeline Layout and DescriptorSetLayout
+    std::vector<VkDescriptorSetLayoutBinding> descSetLayouBindings;
+    for (const DescriptorInfo &descInfo : pipelineCI.layout) {
+        VkDescriptorSetLayoutBinding descSetLayouBinding;
+        descSetLayouBinding.binding = descInfo.bindingIndex;
+        descSetLayouBinding.descriptorType = ToVkDescrtiptorType(descInfo);
+        descSetLayouBinding.descriptorCount = 1;
+        descSetLayouBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        descSetLayouBinding.pImmutableSamplers = nullptr;
+        descSetLayouBindings.push_back(descSetLayouBinding);
+    }
+
+    VkDescriptorSetLayout descSetLayout{};
+    VkDescriptorSetLayoutCreateInfo descSetLayoutCI;
+    descSetLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descSetLayoutCI.pNext = nullptr;
+    descSetLayoutCI.flags = 0;
+    descSetLayoutCI.bindingCount = static_cast<uint32_t>(descSetLayouBindings.size());
+    descSetLayoutCI.pBindings = descSetLayouBindings.data();
+    VULKAN_CHECK(vkCreateDescriptorSetLayout(device, &descSetLayoutCI, nullptr, &descSetLayout), "Failed to create DescriptorSetLayout.");
+
+    VkPipelineLayout pipelineLayout{};
+    VkPipelineLayoutCreateInfo PLCI{};
+    PLCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    PLCI.pNext = nullptr;
+    PLCI.flags = 0;
+    PLCI.setLayoutCount = 1;
+    PLCI.pSetLayouts = &descSetLayout;
+    PLCI.pushConstantRangeCount = 0;
+    PLCI.pPushConstantRanges = nullptr;
+    VULKAN_CHECK(vkCreatePipelineLayout(device, &PLCI, nullptr, &pipelineLayout), "Failed to create PipelineLayout.");
+
+    VkPipeline pipeline{};
+    VkComputePipelineCreateInfo CPCI;
+    CPCI.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    CPCI.pNext = nullptr;
+    CPCI.flags = 0;
+    CPCI.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    CPCI.stage.pNext = nullptr;
+    CPCI.stage.flags = 0;
+    CPCI.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    CPCI.stage.module = (VkShaderModule)pipelineCI.shader;
+    CPCI.stage.pName = "main";
+    CPCI.stage.pSpecializationInfo = nullptr;
+    CPCI.layout = pipelineLayout;
+    CPCI.basePipelineHandle = VK_NULL_HANDLE;
+    CPCI.basePipelineIndex = -1;
+    VULKAN_CHECK(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &CPCI, nullptr, &pipeline), "Failed to create Compute Pipeline.");
+
+    // Compute pipelines have no RenderPass, which is how they are told apart from graphics pipelines.
+    PipelineCreateInfo graphicsPipelineCI{};
+    graphicsPipelineCI.shaders = {pipelineCI.shader};
+    graphicsPipelineCI.layout = pipelineCI.layout;
+    pipelineResources[pipeline] = {pipelineLayout, descSetLayout, VK_NULL_HANDLE, graphicsPipelineCI};
+
+    return (void *)pipeline;
+}
+
 void GraphicsAPI_Vulkan::DestroyPipeline(void *&pipeline) {
     VkPipeline vkPipeline = (VkPipeline)pipeline;
     VkPipelineLayout pipelineLayout = std::get<0>(pipelineResources[vkPipeline]);
     VkDescriptorSetLayout descSetLayout = std::get<1>(pipelineResources[vkPipeline]);
     VkRenderPass renderPass = std::get<2>(pipelineResources[vkPipeline]);
     vkDestroyRenderPass(device, renderPass, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
     vkDestroyDescriptorSetLayout(device, descSetLayout, nullptr);
     vkDestroyPipeline(device, vkPipeline, nullptr);
     pipelineResources.erase(vkPipeline);
@@ -1066,6 +1198,7 @@ void GraphicsAPI_Vulkan::DestroyPipeline(void *&pipeline) {
 }
 
 void GraphicsAPI_Vulkan::BeginRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     VULKAN_CHECK(vkWaitForFences(device, 1, &fence, true, UINT64_MAX), "Failed to wait for Fence");
     VULKAN_CHECK(vkResetFences(device, 1, &fence), "Failed to reset Fence.")
 
@@ -1089,6 +1222,19 @@ void GraphicsAPI_Vulkan::BeginRendering() {
     beginInfo.pInheritanceInfo = nullptr;
     VULKAN_CHECK(vkBeginCommandBuffer(cmdBuffer, &beginInfo), "Failed to begin CommandBuffer.");
 
+    if (timestampQueryPool) {
+        // The fence wait above guarantees that the previous submission's timestamps are available.
+        if (timestampsWritten) {
+            uint64_t timestamps[2] = {0, 0};
+            if (vkGetQueryPoolResults(device, timestampQueryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+                lastRenderingGpuTime = static_cast<uint64_t>(static_cast<double>((timestamps[1] - timestamps[0]) & timestampMask) * timestampPeriod);
+            }
+            timestampsWritten = false;
+        }
+        vkCmdResetQueryPool(cmdBuffer, timestampQueryPool, 0, 2);
+        vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, 0);
+    }
+
     if (currentDesktopSwapchainImage) {
         VkImageMemoryBarrier barrier;
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -1109,6 +1255,7 @@ void GraphicsAPI_Vulkan::BeginRendering() {
 }
 
 void GraphicsAPI_Vulkan::EndRendering() {
+    XR_TUT_PROFILE_FUNCTION();
     if (inRenderPass) {
         vkCmdEndRenderPass(cmdBuffer);
         inRenderPass = false;
@@ -1132,6 +1279,11 @@ void GraphicsAPI_Vulkan::EndRendering() {
                              1, &barrier);
     }
 
+    if (timestampQueryPool) {
+        vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, 1);
+        timestampsWritten = true;
+    }
+
     VULKAN_CHECK(vkEndCommandBuffer(cmdBuffer), "Failed to end CommandBuffer.");
 
     VkPipelineStageFlags waitDstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
@@ -1151,8 +1303,16 @@ void GraphicsAPI_Vulkan::EndRendering() {
 }
 
 void GraphicsAPI_Vulkan::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
+    XR_TUT_PROFILE_FUNCTION();
     VkBuffer vkBuffer = (VkBuffer)buffer;
     VkDeviceMemory memory = bufferResources[vkBuffer].first;
+    auto it = bufferMappedData.find(vkBuffer);
+    if (it != bufferMappedData.end()) {
+        if (data) {
+            memcpy((char *)it->second + offset, data, size);
+        }
+        return;
+    }
     void *mappedData = nullptr;
     VULKAN_CHECK(vkMapMemory(device, memory, offset, size, 0, &mappedData), "Can not map Buffer.");
     if (mappedData && data) {
@@ -1164,6 +1324,7 @@ void GraphicsAPI_Vulkan::SetBufferData(void *buffer, size_t offset, size_t size,
 };
 
 void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b, float a) {
+    XR_TUT_PROFILE_FUNCTION();
     const ImageViewCreateInfo &imageViewCI = imageViewResources[(VkImageView)imageView];
 
     VkClearColorValue clearColor;
@@ -1208,6 +1369,7 @@ void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b,
 }
 
 void GraphicsAPI_Vulkan::ClearDepth(void *imageView, float d) {
+    XR_TUT_PROFILE_FUNCTION();
     const ImageViewCreateInfo &imageViewCI = imageViewResources[(VkImageView)imageView];
 
     VkClearDepthStencilValue clearDepth;
@@ -1250,6 +1412,7 @@ void GraphicsAPI_Vulkan::ClearDepth(void *imageView, float d) {
 }
 
 void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {
+    XR_TUT_PROFILE_FUNCTION();
     if (inRenderPass) {
         vkCmdEndRenderPass(cmdBuffer);
     }
@@ -1313,7 +1476,7 @@ void GraphicsAPI_Vulkan::SetScissors(Rect2D *scissors, size_t count) {
     vkCmdSetScissor(cmdBuffer, 0, static_cast<uint32_t>(vkRect2D.size()), vkRect2D.data());
 }
 void GraphicsAPI_Vulkan::SetPipeline(void *pipeline) {
-    vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)pipeline);
+    vkCmdBindPipeline(cmdBuffer, GetPipelineBindPoint((VkPipeline)pipeline), (VkPipeline)pipeline);
     setPipeline = (VkPipeline)pipeline;
 }
 
@@ -1390,7 +1553,7 @@ void GraphicsAPI_Vulkan::UpdateDescriptors() {
     vkUpdateDescriptorSets(device, static_cast<uint32_t>(vkWriteDescSets.size()), vkWriteDescSets.data(), 0, nullptr);
     writeDescSets.clear();
 
-    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descSet, 0, nullptr);
+    vkCmdBindDescriptorSets(cmdBuffer, GetPipelineBindPoint(setPipeline), pipelineLayout, 0, 1, &descSet, 0, nullptr);
     cmdBufferDescriptorSets[cmdBuffer].push_back({descSet});
 }
 
@@ -1412,13 +1575,59 @@ void GraphicsAPI_Vulkan::SetIndexBuffer(void *indexBuffer) {
 }
 
 void GraphicsAPI_Vulkan::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     vkCmdDrawIndexed(cmdBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
 void GraphicsAPI_Vulkan::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    XR_TUT_PROFILE_FUNCTION();
     vkCmdDraw(cmdBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
+void GraphicsAPI_Vulkan::DrawIndexedIndirect(void *buffer, size_t offset, uint32_t drawCount, uint32_t stride) {
+    // drawCount > 1 requires the multiDrawIndirect feature.
+    if (drawCount > 1 && !multiDrawIndirectSupported) {
+        for (uint32_t i = 0; i < drawCount; i++) {
+            vkCmdDrawIndexedIndirect(cmdBuffer, (VkBuffer)buffer, static_cast<VkDeviceSize>(offset) + static_cast<VkDeviceSize>(i) * stride, 1, stride);
+        }
+        return;
+    }
+    vkCmdDrawIndexedIndirect(cmdBuffer, (VkBuffer)buffer, static_cast<VkDeviceSize>(offset), drawCount, stride);
+}
+
+void GraphicsAPI_Vulkan::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    XR_TUT_PROFILE_FUNCTION();
+    if (inRenderPass) {
+        vkCmdEndRenderPass(cmdBuffer);
+        inRenderPass = false;
+    }
+    vkCmdDispatch(cmdBuffer, groupCountX, groupCountY, groupCountZ);
+    ComputeToGraphicsBarrier();
+}
+
+void GraphicsAPI_Vulkan::DispatchIndirect(void *buffer, size_t offset) {
+    if (inRenderPass) {
+        vkCmdEndRenderPass(cmdBuffer);
+        inRenderPass = false;
+    }
+    vkCmdDispatchIndirect(cmdBuffer, (VkBuffer)buffer, static_cast<VkDeviceSize>(offset));
+    ComputeToGraphicsBarrier();
+}
+
+VkPipelineBindPoint GraphicsAPI_Vulkan::GetPipelineBindPoint(VkPipeline pipeline) {
+    return std::get<2>(pipelineResources[pipeline]) == VK_NULL_HANDLE ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+}
+
+void GraphicsAPI_Vulkan::ComputeToGraphicsBarrier() {
+    VkMemoryBarrier barrier;
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.pNext = nullptr;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStageMask, VkDependencyFlagBits(0), 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
 // XR_DOCS_TAG_BEGIN_GraphicsAPI_Vulkan_LoadPFN_XrFunctions
 void GraphicsAPI_Vulkan::LoadPFN_XrFunctions(XrInstance m_xrInstance) {
     OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetVulkanGraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetVulkanGraphicsRequirementsKHR), "Failed to get InstanceProcAddr for xrGetVulkanGraphicsRequirementsKHR.");
@@ -58,6 +58,10 @@ XrVector3f
 XrVector4f
 XrQuaternionf
 XrMatrix4x4f
+XrSpheresSoA
+XrBoundsSoA
+XrPosesSoA
+XrProjectionCache
 
 inline static void XrVector3f_Set(XrVector3f* v, const float value);
 inline static void XrVector3f_Add(XrVector3f* result, const XrVector3f* a, const XrVector3f* b);
@@ -71,6 +75,7 @@ inline static void XrVector3f_Normalize(XrVector3f* v);
 inline static float XrVector3f_Length(const XrVector3f* v);
 
 inline static void XrQuaternionf_Lerp(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b, const float fraction);
+inline static void XrQuaternionf_Slerp(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b, const float fraction);
 inline static void XrQuaternionf_Multiply(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b;
 
 inline static void XrMatrix4x4f_CreateIdentity(XrMatrix4x4f* result);
@@ -86,6 +91,13 @@ inline static void XrMatrix4x4f_CreateProjection(XrMatrix4x4f* result, const flo
 inline static void XrMatrix4x4f_CreateProjectionFov(XrMatrix4x4f* result, const float fovDegreesLeft, const float fovDegreesRight,
                                                     const float fovDegreeUp, const float fovDegreesDown, const float nearZ,
                                                     const float farZ);
+inline static void XrMatrix4x4f_CreateProjectionReversedZ(XrMatrix4x4f* result, GraphicsAPI_Type graphicsApi, const float tanAngleLeft,
+                                                          const float tanAngleRight, const float tanAngleUp, float const tanAngleDown,
+                                                          const float nearZ, const float farZ);
+inline static void XrMatrix4x4f_CreateProjectionFovReversedZ(XrMatrix4x4f* result, GraphicsAPI_Type graphicsApi, const XrFovf fov,
+                                                             const float nearZ, const float farZ);
+inline static const XrMatrix4x4f* XrProjectionCache_Get(XrProjectionCache* cache, GraphicsAPI_Type graphicsApi, const XrFovf fov,
+                                                        const float nearZ, const float farZ, const bool reversedZ);
 inline static void XrMatrix4x4f_CreateFromQuaternion(XrMatrix4x4f* result, const XrQuaternionf* src);
 inline static void XrMatrix4x4f_CreateOffsetScaleForBounds(XrMatrix4x4f* result, const XrMatrix4x4f* matrix, const XrVector3f* mins,
                                                            const XrVector3f* maxs);
@@ -110,6 +122,38 @@ inline static void XrMatrix4x4f_TransformVector4f(XrVector4f* result, const XrMa
 inline static void XrMatrix4x4f_TransformBounds(XrVector3f* resultMins, XrVector3f* resultMaxs, const XrMatrix4x4f* matrix,
                                                 const XrVector3f* mins, const XrVector3f* maxs);
 inline static bool XrMatrix4x4f_CullBounds(const XrMatrix4x4f* mvp, const XrVector3f* mins, const XrVector3f* maxs);
+inline static void XrMatrix4x4f_GetFrustumPlanes(XrVector4f planes[6], const XrMatrix4x4f* viewProjection,
+                                                GraphicsAPI_Type graphicsApi);
+
+inline static float XrRcpSqrtFast(const float x);
+inline static void XrQuaternionf_LerpFast(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b, const float fraction);
+inline static void XrMatrix4x4f_MultiplyFast(XrMatrix4x4f* result, const XrMatrix4x4f* a, const XrMatrix4x4f* b);
+inline static void XrMatrix4x4f_InvertFast(XrMatrix4x4f* result, const XrMatrix4x4f* src);
+
+inline static void XrMatrix4x4f_MultiplyBatch(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, const size_t count);
+inline static void XrMatrix4x4f_CreateTranslationRotationScaleBatch(XrMatrix4x4f* results, const XrVector3f* translations,
+                                                                    const XrQuaternionf* rotations, const XrVector3f* scales,
+                                                                    const size_t count);
+inline static void XrMatrix4x4f_TransformVector3fBatch(XrVector3f* results, const XrMatrix4x4f* m, const XrVector3f* v,
+                                                       const size_t count);
+
+inline static bool XrFrustum_IsSphereVisible(const XrVector4f* planes, const int frustumCount, const float x, const float y,
+                                             const float z, const float radius);
+inline static bool XrFrustum_IsBoundsVisible(const XrVector4f* planes, const int frustumCount, const XrVector3f* mins,
+                                             const XrVector3f* maxs);
+inline static void XrFrustum_CullSpheresSoA(uint32_t* visibleMask, const XrVector4f* planes, const int frustumCount,
+                                            const XrSpheresSoA* spheres, const size_t count);
+inline static void XrFrustum_CullBoundsSoA(uint32_t* visibleMask, const XrVector4f* planes, const int frustumCount,
+                                           const XrBoundsSoA* bounds, const size_t count);
+
+inline static void XrQuaternionf_RotateVector3f(XrVector3f* result, const XrQuaternionf* q, const XrVector3f* v);
+inline static void XrPosef_Multiply(XrPosef* result, const XrPosef* a, const XrPosef* b);
+inline static void XrPosef_ComposeHierarchy(XrPosef* modelPoses, const XrPosef* localPoses, const int32_t* parentIndices,
+                                            const size_t count);
+inline static void XrPosef_ComposeHierarchySoA(XrPosesSoA* modelPoses, const XrPosesSoA* localPoses, const int32_t* parentIndices,
+                                               const size_t count);
+inline static void XrMatrix4x4f_CreateFromPoseBatch(XrMatrix4x4f* results, const XrPosef* poses, const size_t count);
+inline static void XrMatrix4x4f_CreateFromPosesSoA(XrMatrix4x4f* results, const XrPosesSoA* poses, const size_t count);
 
 ================================================================================================
 */
@@ -117,6 +161,22 @@ inline static bool XrMatrix4x4f_CullBounds(const XrMatrix4x4f* mvp, const XrVect
 #include <assert.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+// The batch functions use SIMD when the target supports it. Define XR_LINEAR_NO_SIMD to force the scalar versions.
+#if !defined(XR_LINEAR_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XR_LINEAR_SIMD_SSE 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define XR_LINEAR_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define XR_LINEAR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
 
 #define MATH_PI 3.14159265358979323846f
 
@@ -139,12 +199,288 @@ typedef struct XrMatrix4x4f {
     float m[16];
 } XrMatrix4x4f;
 
+// Structure-of-arrays bounding spheres for batch culling. Each array holds one element per sphere.
+typedef struct XrSpheresSoA {
+    const float* centerX;
+    const float* centerY;
+    const float* centerZ;
+    const float* radius;
+} XrSpheresSoA;
+
+// Structure-of-arrays axis aligned bounding boxes for batch culling. Each array holds one element per box.
+typedef struct XrBoundsSoA {
+    const float* minX;
+    const float* minY;
+    const float* minZ;
+    const float* maxX;
+    const float* maxY;
+    const float* maxZ;
+} XrBoundsSoA;
+
+// Projection matrix cached by XrProjectionCache_Get(). Zero-initialize before first use.
+typedef struct XrProjectionCache {
+    XrMatrix4x4f projection;
+    XrFovf fov;
+    float nearZ;
+    float farZ;
+    GraphicsAPI_Type graphicsApi;
+    bool reversedZ;
+    bool valid;
+} XrProjectionCache;
+
+// Structure-of-arrays poses for batch pose composition. Each array holds one element per pose.
+typedef struct XrPosesSoA {
+    float* orientationX;
+    float* orientationY;
+    float* orientationZ;
+    float* orientationW;
+    float* positionX;
+    float* positionY;
+    float* positionZ;
+} XrPosesSoA;
+
+#if defined(XR_LINEAR_SIMD_SSE)
+// Returns a * v, where a0-a3 are the columns of a.
+inline static __m128 XrMatrix4x4f_TransformColumnSSE(const __m128 a0, const __m128 a1, const __m128 a2, const __m128 a3,
+                                                     const __m128 v) {
+    __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+    r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+    return r;
+}
+#endif
+
+#if defined(XR_LINEAR_SIMD_AVX2)
+// Returns a * v for two vectors at once, one in each 128-bit lane. a0-a3 hold the columns of a in both lanes.
+inline static __m256 XrMatrix4x4f_TransformColumnAVX2(const __m256 a0, const __m256 a1, const __m256 a2, const __m256 a3,
+                                                      const __m256 v) {
+    __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+    r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3))));
+    return r;
+}
+#endif
+
+#if defined(XR_LINEAR_SIMD_NEON)
+// Returns a * v, where a0-a3 are the columns of a.
+inline static float32x4_t XrMatrix4x4f_TransformColumnNEON(const float32x4_t a0, const float32x4_t a1, const float32x4_t a2,
+                                                           const float32x4_t a3, const float32x4_t v) {
+    float32x4_t r = vmulq_n_f32(a0, vgetq_lane_f32(v, 0));
+    r = vaddq_f32(r, vmulq_n_f32(a1, vgetq_lane_f32(v, 1)));
+    r = vaddq_f32(r, vmulq_n_f32(a2, vgetq_lane_f32(v, 2)));
+    r = vaddq_f32(r, vmulq_n_f32(a3, vgetq_lane_f32(v, 3)));
+    return r;
+}
+
+// Transposes the 4x4 matrix held in r0-r3.
+inline static void XrMatrix4x4f_TransposeNEON(float32x4_t* r0, float32x4_t* r1, float32x4_t* r2, float32x4_t* r3) {
+    const float32x4x2_t t01 = vtrnq_f32(*r0, *r1);
+    const float32x4x2_t t23 = vtrnq_f32(*r2, *r3);
+    *r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    *r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    *r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    *r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
+
+/*
+================================================================================================
+
+Fast math
+
+The *Fast functions below trade a little accuracy for speed and are always available.
+Define XR_LINEAR_FAST_MATH to also make XrMatrix4x4f_Multiply and XrMatrix4x4f_Invert use them, which
+speeds up everything built on top (pose and view math). XrRcpSqrtFast and XrQuaternionf_LerpFast are
+not switched in, as Tests/LinearAlgebra_Benchmark measures them no faster than the default functions
+with SSE2; call them directly where the accuracy trade-off is wanted.
+XrMatrix4x4f_MultiplyFast gives the same results as XrMatrix4x4f_Multiply. XrRcpSqrtFast uses the
+hardware reciprocal square root estimate refined with one Newton-Raphson step (about 23 bits).
+XrMatrix4x4f_InvertFast uses 2x2 block inversion, which rounds differently than the cofactor
+expansion in XrMatrix4x4f_Invert.
+
+================================================================================================
+*/
+
+inline static void XrMatrix4x4f_Multiply(XrMatrix4x4f* result, const XrMatrix4x4f* a, const XrMatrix4x4f* b);
+inline static void XrMatrix4x4f_Invert(XrMatrix4x4f* result, const XrMatrix4x4f* src);
+
+inline static float XrRcpSqrtFast(const float x) {
+    const float SMALLEST_NON_DENORMAL = 1.1754943508222875e-038f;  // ( 1U << 23 )
+    if (x < SMALLEST_NON_DENORMAL) {
+        return 1.0f;
+    }
+#if defined(XR_LINEAR_SIMD_SSE)
+    const __m128 v = _mm_set_ss(x);
+    const __m128 e = _mm_rsqrt_ss(v);
+    // e * (1.5 - 0.5 * x * e * e)
+    const __m128 halfXee = _mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), v), _mm_mul_ss(e, e));
+    return _mm_cvtss_f32(_mm_mul_ss(e, _mm_sub_ss(_mm_set_ss(1.5f), halfXee)));
+#elif defined(XR_LINEAR_SIMD_NEON)
+    const float32x2_t v = vdup_n_f32(x);
+    const float32x2_t e = vrsqrte_f32(v);
+    // vrsqrts computes (3 - a * b) / 2.
+    return vget_lane_f32(vmul_f32(e, vrsqrts_f32(vmul_f32(v, e), e)), 0);
+#else
+    return 1.0f / sqrtf(x);
+#endif
+}
+
 inline static float XrRcpSqrt(const float x) {
     const float SMALLEST_NON_DENORMAL = 1.1754943508222875e-038f;  // ( 1U << 23 )
     const float rcp = (x >= SMALLEST_NON_DENORMAL) ? 1.0f / sqrtf(x) : 1.0f;
     return rcp;
 }
 
+// Normalized linear interpolation along the shortest path, see XrQuaternionf_Lerp.
+inline static void XrQuaternionf_LerpFast(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b, const float fraction) {
+#if defined(XR_LINEAR_SIMD_SSE)
+    const __m128 qa = _mm_loadu_ps(&a->x);
+    const __m128 qb = _mm_loadu_ps(&b->x);
+    __m128 dot = _mm_mul_ps(qa, qb);
+    dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+    dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+    const float fb = (_mm_cvtss_f32(dot) < 0.0f) ? -fraction : fraction;
+    const __m128 q = _mm_add_ps(_mm_mul_ps(qa, _mm_set1_ps(1.0f - fraction)), _mm_mul_ps(qb, _mm_set1_ps(fb)));
+    __m128 lengthSq = _mm_mul_ps(q, q);
+    lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(2, 3, 0, 1)));
+    lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1, 0, 3, 2)));
+    _mm_storeu_ps(&result->x, _mm_mul_ps(q, _mm_set1_ps(XrRcpSqrtFast(_mm_cvtss_f32(lengthSq)))));
+#elif defined(XR_LINEAR_SIMD_NEON)
+    const float32x4_t qa = vld1q_f32(&a->x);
+    const float32x4_t qb = vld1q_f32(&b->x);
+    const float32x4_t ab = vmulq_f32(qa, qb);
+    const float32x2_t dot = vpadd_f32(vadd_f32(vget_low_f32(ab), vget_high_f32(ab)), vdup_n_f32(0.0f));
+    const float fb = (vget_lane_f32(dot, 0) < 0.0f) ? -fraction : fraction;
+    const float32x4_t q = vaddq_f32(vmulq_n_f32(qa, 1.0f - fraction), vmulq_n_f32(qb, fb));
+    const float32x4_t qq = vmulq_f32(q, q);
+    const float32x2_t lengthSq = vpadd_f32(vadd_f32(vget_low_f32(qq), vget_high_f32(qq)), vdup_n_f32(0.0f));
+    vst1q_f32(&result->x, vmulq_n_f32(q, XrRcpSqrtFast(vget_lane_f32(lengthSq, 0))));
+#else
+    const float s = a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
+    const float fa = 1.0f - fraction;
+    const float fb = (s < 0.0f) ? -fraction : fraction;
+    const float x = a->x * fa + b->x * fb;
+    const float y = a->y * fa + b->y * fb;
+    const float z = a->z * fa + b->z * fb;
+    const float w = a->w * fa + b->w * fb;
+    const float lengthRcp = XrRcpSqrtFast(x * x + y * y + z * z + w * w);
+    result->x = x * lengthRcp;
+    result->y = y * lengthRcp;
+    result->z = z * lengthRcp;
+    result->w = w * lengthRcp;
+#endif
+}
+
+// Same results as XrMatrix4x4f_Multiply, one column per SIMD operation.
+inline static void XrMatrix4x4f_MultiplyFast(XrMatrix4x4f* result, const XrMatrix4x4f* a, const XrMatrix4x4f* b) {
+#if defined(XR_LINEAR_SIMD_SSE)
+    const __m128 a0 = _mm_loadu_ps(&a->m[0]);
+    const __m128 a1 = _mm_loadu_ps(&a->m[4]);
+    const __m128 a2 = _mm_loadu_ps(&a->m[8]);
+    const __m128 a3 = _mm_loadu_ps(&a->m[12]);
+    const __m128 r0 = XrMatrix4x4f_TransformColumnSSE(a0, a1, a2, a3, _mm_loadu_ps(&b->m[0]));
+    const __m128 r1 = XrMatrix4x4f_TransformColumnSSE(a0, a1, a2, a3, _mm_loadu_ps(&b->m[4]));
+    const __m128 r2 = XrMatrix4x4f_TransformColumnSSE(a0, a1, a2, a3, _mm_loadu_ps(&b->m[8]));
+    const __m128 r3 = XrMatrix4x4f_TransformColumnSSE(a0, a1, a2, a3, _mm_loadu_ps(&b->m[12]));
+    _mm_storeu_ps(&result->m[0], r0);
+    _mm_storeu_ps(&result->m[4], r1);
+    _mm_storeu_ps(&result->m[8], r2);
+    _mm_storeu_ps(&result->m[12], r3);
+#elif defined(XR_LINEAR_SIMD_NEON)
+    const float32x4_t a0 = vld1q_f32(&a->m[0]);
+    const float32x4_t a1 = vld1q_f32(&a->m[4]);
+    const float32x4_t a2 = vld1q_f32(&a->m[8]);
+    const float32x4_t a3 = vld1q_f32(&a->m[12]);
+    const float32x4_t r0 = XrMatrix4x4f_TransformColumnNEON(a0, a1, a2, a3, vld1q_f32(&b->m[0]));
+    const float32x4_t r1 = XrMatrix4x4f_TransformColumnNEON(a0, a1, a2, a3, vld1q_f32(&b->m[4]));
+    const float32x4_t r2 = XrMatrix4x4f_TransformColumnNEON(a0, a1, a2, a3, vld1q_f32(&b->m[8]));
+    const float32x4_t r3 = XrMatrix4x4f_TransformColumnNEON(a0, a1, a2, a3, vld1q_f32(&b->m[12]));
+    vst1q_f32(&result->m[0], r0);
+    vst1q_f32(&result->m[4], r1);
+    vst1q_f32(&result->m[8], r2);
+    vst1q_f32(&result->m[12], r3);
+#else
+    XrMatrix4x4f_Multiply(result, a, b);
+#endif
+}
+
+#if defined(XR_LINEAR_SIMD_SSE)
+// 2x2 matrix helpers for XrMatrix4x4f_InvertFast. A register holds a 2x2 matrix as (m00, m01, m10, m11).
+// Returns a * b.
+inline static __m128 XrMatrix2x2f_MultiplySSE(const __m128 a, const __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+// Returns adjugate(a) * b.
+inline static __m128 XrMatrix2x2f_AdjugateMultiplySSE(const __m128 a, const __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+// Returns a * adjugate(b).
+inline static __m128 XrMatrix2x2f_MultiplyAdjugateSSE(const __m128 a, const __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+#endif
+
+// Inverts a general 4x4 matrix. Uses 2x2 block inversion with SSE2, otherwise XrMatrix4x4f_Invert.
+inline static void XrMatrix4x4f_InvertFast(XrMatrix4x4f* result, const XrMatrix4x4f* src) {
+#if defined(XR_LINEAR_SIMD_SSE)
+    // The algorithm is layout agnostic: inverting the transpose and storing it the same way gives the inverse.
+    const __m128 c0 = _mm_loadu_ps(&src->m[0]);
+    const __m128 c1 = _mm_loadu_ps(&src->m[4]);
+    const __m128 c2 = _mm_loadu_ps(&src->m[8]);
+    const __m128 c3 = _mm_loadu_ps(&src->m[12]);
+
+    // Sub-matrices | A B |
+    //              | C D |
+    const __m128 A = _mm_movelh_ps(c0, c1);
+    const __m128 B = _mm_movehl_ps(c1, c0);
+    const __m128 C = _mm_movelh_ps(c2, c3);
+    const __m128 D = _mm_movehl_ps(c3, c2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 detSub = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+                                     _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // inverse = 1 / |M| * | X Y |, computed as adjugates X#, Y#, Z#, W#.
+    //                     | Z W |
+    const __m128 D_C = XrMatrix2x2f_AdjugateMultiplySSE(D, C);
+    const __m128 A_B = XrMatrix2x2f_AdjugateMultiplySSE(A, B);
+    __m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), XrMatrix2x2f_MultiplySSE(B, D_C));
+    __m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), XrMatrix2x2f_MultiplySSE(C, A_B));
+    __m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), XrMatrix2x2f_MultiplyAdjugateSSE(D, A_B));
+    __m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), XrMatrix2x2f_MultiplyAdjugateSSE(A, D_C));
+
+    // |M| = |A| * |D| + |B| * |C| - tr((A# * B) * (D# * C))
+    __m128 tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+    // (1/|M|, -1/|M|, -1/|M|, 1/|M|) also applies the adjugate's signs.
+    const __m128 rcpDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    X_ = _mm_mul_ps(X_, rcpDetM);
+    Y_ = _mm_mul_ps(Y_, rcpDetM);
+    Z_ = _mm_mul_ps(Z_, rcpDetM);
+    W_ = _mm_mul_ps(W_, rcpDetM);
+
+    // The shuffles complete the adjugates and reassemble the 4x4 matrix.
+    _mm_storeu_ps(&result->m[0], _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(&result->m[4], _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(&result->m[8], _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(&result->m[12], _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2)));
+#else
+    XrMatrix4x4f_Invert(result, src);
+#endif
+}
+
 inline static void XrVector3f_Set(XrVector3f* v, const float value) {
     v->x = value;
     v->y = value;
@@ -237,6 +573,28 @@ inline static void XrQuaternionf_Lerp(XrQuaternionf* result, const XrQuaternionf
     result->w = w * lengthRcp;
 }
 
+// Spherical linear interpolation along the shortest path. Nearly identical rotations use XrQuaternionf_Lerp.
+inline static void XrQuaternionf_Slerp(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b, const float fraction) {
+    float cosTheta = a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
+    float sign = 1.0f;
+    if (cosTheta < 0.0f) {
+        cosTheta = -cosTheta;
+        sign = -1.0f;
+    }
+    if (cosTheta > 0.9995f) {
+        XrQuaternionf_Lerp(result, a, b, fraction);
+        return;
+    }
+    const float theta = acosf(cosTheta);
+    const float rcpSinTheta = 1.0f / sinf(theta);
+    const float fa = sinf((1.0f - fraction) * theta) * rcpSinTheta;
+    const float fb = sign * sinf(fraction * theta) * rcpSinTheta;
+    result->x = a->x * fa + b->x * fb;
+    result->y = a->y * fa + b->y * fb;
+    result->z = a->z * fa + b->z * fb;
+    result->w = a->w * fa + b->w * fb;
+}
+
 inline static void XrQuaternionf_Multiply(XrQuaternionf* result, const XrQuaternionf* a, const XrQuaternionf* b) {
     result->x = (b->w * a->x) + (b->x * a->w) + (b->y * a->z) - (b->z * a->y);
     result->y = (b->w * a->y) - (b->x * a->z) + (b->y * a->w) + (b->z * a->x);
@@ -246,6 +604,9 @@ inline static void XrQuaternionf_Multiply(XrQuaternionf* result, const XrQuatern
 
 // Use left-multiplication to accumulate transformations.
 inline static void XrMatrix4x4f_Multiply(XrMatrix4x4f* result, const XrMatrix4x4f* a, const XrMatrix4x4f* b) {
+#if defined(XR_LINEAR_FAST_MATH) && (defined(XR_LINEAR_SIMD_SSE) || defined(XR_LINEAR_SIMD_NEON))
+    XrMatrix4x4f_MultiplyFast(result, a, b);
+#else
     result->m[0] = a->m[0] * b->m[0] + a->m[4] * b->m[1] + a->m[8] * b->m[2] + a->m[12] * b->m[3];
     result->m[1] = a->m[1] * b->m[0] + a->m[5] * b->m[1] + a->m[9] * b->m[2] + a->m[13] * b->m[3];
     result->m[2] = a->m[2] * b->m[0] + a->m[6] * b->m[1] + a->m[10] * b->m[2] + a->m[14] * b->m[3];
@@ -265,6 +626,7 @@ inline static void XrMatrix4x4f_Multiply(XrMatrix4x4f* result, const XrMatrix4x4
     result->m[13] = a->m[1] * b->m[12] + a->m[5] * b->m[13] + a->m[9] * b->m[14] + a->m[13] * b->m[15];
     result->m[14] = a->m[2] * b->m[12] + a->m[6] * b->m[13] + a->m[10] * b->m[14] + a->m[14] * b->m[15];
     result->m[15] = a->m[3] * b->m[12] + a->m[7] * b->m[13] + a->m[11] * b->m[14] + a->m[15] * b->m[15];
+#endif
 }
 
 // Creates the transpose of the given matrix.
@@ -302,6 +664,9 @@ inline static float XrMatrix4x4f_Minor(const XrMatrix4x4f* matrix, int r0, int r
 
 // Calculates the inverse of a 4x4 matrix.
 inline static void XrMatrix4x4f_Invert(XrMatrix4x4f* result, const XrMatrix4x4f* src) {
+#if defined(XR_LINEAR_FAST_MATH) && defined(XR_LINEAR_SIMD_SSE)
+    XrMatrix4x4f_InvertFast(result, src);
+#else
     const float rcpDet =
         1.0f / (src->m[0] * XrMatrix4x4f_Minor(src, 1, 2, 3, 1, 2, 3) - src->m[1] * XrMatrix4x4f_Minor(src, 1, 2, 3, 0, 2, 3) +
                 src->m[2] * XrMatrix4x4f_Minor(src, 1, 2, 3, 0, 1, 3) - src->m[3] * XrMatrix4x4f_Minor(src, 1, 2, 3, 0, 1, 2));
@@ -322,6 +687,7 @@ inline static void XrMatrix4x4f_Invert(XrMatrix4x4f* result, const XrMatrix4x4f*
     result->m[13] = XrMatrix4x4f_Minor(src, 0, 2, 3, 0, 1, 2) * rcpDet;
     result->m[14] = -XrMatrix4x4f_Minor(src, 0, 1, 3, 0, 1, 2) * rcpDet;
     result->m[15] = XrMatrix4x4f_Minor(src, 0, 1, 2, 0, 1, 2) * rcpDet;
+#endif
 }
 
 // Calculates the inverse of a rigid body transform.
@@ -555,6 +921,65 @@ inline static void XrMatrix4x4f_CreateProjectionFov(XrMatrix4x4f* result, Graphi
     XrMatrix4x4f_CreateProjection(result, graphicsApi, tanLeft, tanRight, tanUp, tanDown, nearZ, farZ);
 }
 
+// Creates a reversed-Z projection matrix: the near plane maps to depth 1 and the far plane to depth 0.
+// Render with a GREATER or GREATER_OR_EQUAL depth test and clear depth to 0. Combined with a floating point depth
+// buffer the precision is nearly uniform, so an infinite far plane (farZ <= nearZ) costs nothing.
+// For OpenGL / OpenGL ES the Z clip space stays [-1,1] (near at 1, far at -1), which only gains precision if the
+// application switches to a [0,1] depth range with glClipControl().
+inline static void XrMatrix4x4f_CreateProjectionReversedZ(XrMatrix4x4f* result, GraphicsAPI_Type graphicsApi, const float tanAngleLeft,
+                                                          const float tanAngleRight, const float tanAngleUp, float const tanAngleDown,
+                                                          const float nearZ, const float farZ) {
+    // X and Y are the same as for the forward-Z projection.
+    XrMatrix4x4f_CreateProjection(result, graphicsApi, tanAngleLeft, tanAngleRight, tanAngleUp, tanAngleDown, nearZ, farZ);
+
+    const bool minusOneToOneDepth = graphicsApi == OPENGL || graphicsApi == OPENGL_ES;
+    if (farZ <= nearZ) {
+        // place the far plane at infinity
+        result->m[10] = minusOneToOneDepth ? 1.0f : 0.0f;
+        result->m[14] = minusOneToOneDepth ? 2.0f * nearZ : nearZ;
+    } else if (minusOneToOneDepth) {
+        result->m[10] = (farZ + nearZ) / (farZ - nearZ);
+        result->m[14] = (2.0f * farZ * nearZ) / (farZ - nearZ);
+    } else {
+        result->m[10] = nearZ / (farZ - nearZ);
+        result->m[14] = (farZ * nearZ) / (farZ - nearZ);
+    }
+}
+
+// Creates a reversed-Z projection matrix based on the specified FOV.
+inline static void XrMatrix4x4f_CreateProjectionFovReversedZ(XrMatrix4x4f* result, GraphicsAPI_Type graphicsApi, const XrFovf fov,
+                                                             const float nearZ, const float farZ) {
+    const float tanLeft = tanf(fov.angleLeft);
+    const float tanRight = tanf(fov.angleRight);
+
+    const float tanDown = tanf(fov.angleDown);
+    const float tanUp = tanf(fov.angleUp);
+
+    XrMatrix4x4f_CreateProjectionReversedZ(result, graphicsApi, tanLeft, tanRight, tanUp, tanDown, nearZ, farZ);
+}
+
+// Returns the projection for the given parameters, only recomputing it when they differ from the previous call.
+// Keep one cache per view: runtimes usually report the same XrFovf every frame.
+inline static const XrMatrix4x4f* XrProjectionCache_Get(XrProjectionCache* cache, GraphicsAPI_Type graphicsApi, const XrFovf fov,
+                                                        const float nearZ, const float farZ, const bool reversedZ) {
+    if (!cache->valid || cache->graphicsApi != graphicsApi || cache->reversedZ != reversedZ || cache->nearZ != nearZ ||
+        cache->farZ != farZ || cache->fov.angleLeft != fov.angleLeft || cache->fov.angleRight != fov.angleRight ||
+        cache->fov.angleUp != fov.angleUp || cache->fov.angleDown != fov.angleDown) {
+        if (reversedZ) {
+            XrMatrix4x4f_CreateProjectionFovReversedZ(&cache->projection, graphicsApi, fov, nearZ, farZ);
+        } else {
+            XrMatrix4x4f_CreateProjectionFov(&cache->projection, graphicsApi, fov, nearZ, farZ);
+        }
+        cache->graphicsApi = graphicsApi;
+        cache->fov = fov;
+        cache->nearZ = nearZ;
+        cache->farZ = farZ;
+        cache->reversedZ = reversedZ;
+        cache->valid = true;
+    }
+    return &cache->projection;
+}
+
 // Creates a matrix that transforms the -1 to 1 cube to cover the given 'mins' and 'maxs' transformed with the given 'matrix'.
 inline static void XrMatrix4x4f_CreateOffsetScaleForBounds(XrMatrix4x4f* result, const XrMatrix4x4f* matrix, const XrVector3f* mins,
                                                            const XrVector3f* maxs) {
@@ -790,4 +1215,753 @@ inline static bool XrMatrix4x4f_CullBounds(const XrMatrix4x4f* mvp, const XrVect
     return i == 8;
 }
 
+// Extracts the left, right, bottom, top, near and far planes from a view-projection matrix (Gribb-Hartmann).
+// For reversed-Z projections the near and far planes come out swapped, which does not matter for culling.
+// Each plane is (a, b, c, d) with a unit-length normal pointing into the frustum, so a point p is inside when
+// a * p.x + b * p.y + c * p.z + d >= 0. The clip space depth range depends on the graphics API.
+// For an infinite far plane the far plane is degenerate and is returned as (0, 0, 0, 1), which never culls.
+inline static void XrMatrix4x4f_GetFrustumPlanes(XrVector4f planes[6], const XrMatrix4x4f* viewProjection,
+                                                GraphicsAPI_Type graphicsApi) {
+    const float* m = viewProjection->m;
+    const XrVector4f row0 = {m[0], m[4], m[8], m[12]};
+    const XrVector4f row1 = {m[1], m[5], m[9], m[13]};
+    const XrVector4f row2 = {m[2], m[6], m[10], m[14]};
+    const XrVector4f row3 = {m[3], m[7], m[11], m[15]};
+    const bool zeroToOneDepth = graphicsApi != OPENGL && graphicsApi != OPENGL_ES;
+
+    planes[0] = {row3.x + row0.x, row3.y + row0.y, row3.z + row0.z, row3.w + row0.w};
+    planes[1] = {row3.x - row0.x, row3.y - row0.y, row3.z - row0.z, row3.w - row0.w};
+    planes[2] = {row3.x + row1.x, row3.y + row1.y, row3.z + row1.z, row3.w + row1.w};
+    planes[3] = {row3.x - row1.x, row3.y - row1.y, row3.z - row1.z, row3.w - row1.w};
+    if (zeroToOneDepth) {
+        planes[4] = row2;
+    } else {
+        planes[4] = {row3.x + row2.x, row3.y + row2.y, row3.z + row2.z, row3.w + row2.w};
+    }
+    planes[5] = {row3.x - row2.x, row3.y - row2.y, row3.z - row2.z, row3.w - row2.w};
+
+    for (int i = 0; i < 6; i++) {
+        const float lengthSq = planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z;
+        if (lengthSq < 1e-12f) {
+            planes[i] = {0.0f, 0.0f, 0.0f, 1.0f};
+            continue;
+        }
+        const float rcpLength = XrRcpSqrt(lengthSq);
+        planes[i].x *= rcpLength;
+        planes[i].y *= rcpLength;
+        planes[i].z *= rcpLength;
+        planes[i].w *= rcpLength;
+    }
+}
+
+/*
+================================================================================================
+
+Batch functions
+
+Each function processes 'count' contiguous elements and gives the same results as calling the
+single element function in a loop, up to the sign of zero. The SIMD versions multiply and add
+in the same order as the scalar code, so this holds as long as the compiler does not contract
+them into fused multiply-adds (e.g. GCC/Clang with -mfma and -ffp-contract=fast).
+
+================================================================================================
+*/
+
+// Multiplies each matrix in 'b' by 'a': results[i] = a * b[i].
+// With 'a' as a view-projection and 'b' as model matrices this gives the per-object model-view-projections.
+// 'results' must not alias 'a', but may alias 'b'.
+inline static void XrMatrix4x4f_MultiplyBatch(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, const size_t count) {
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_AVX2)
+    {
+        const __m256 a0 = _mm256_broadcast_ps((const __m128*)&a->m[0]);
+        const __m256 a1 = _mm256_broadcast_ps((const __m128*)&a->m[4]);
+        const __m256 a2 = _mm256_broadcast_ps((const __m128*)&a->m[8]);
+        const __m256 a3 = _mm256_broadcast_ps((const __m128*)&a->m[12]);
+        for (; i + 2 <= count; i += 2) {
+            for (int c = 0; c < 16; c += 4) {
+                const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&b[i].m[c])), _mm_loadu_ps(&b[i + 1].m[c]), 1);
+                const __m256 r = XrMatrix4x4f_TransformColumnAVX2(a0, a1, a2, a3, v);
+                _mm_storeu_ps(&results[i].m[c], _mm256_castps256_ps128(r));
+                _mm_storeu_ps(&results[i + 1].m[c], _mm256_extractf128_ps(r, 1));
+            }
+        }
+    }
+#endif
+#if defined(XR_LINEAR_SIMD_SSE)
+    {
+        const __m128 a0 = _mm_loadu_ps(&a->m[0]);
+        const __m128 a1 = _mm_loadu_ps(&a->m[4]);
+        const __m128 a2 = _mm_loadu_ps(&a->m[8]);
+        const __m128 a3 = _mm_loadu_ps(&a->m[12]);
+        for (; i < count; i++) {
+            for (int c = 0; c < 16; c += 4) {
+                _mm_storeu_ps(&results[i].m[c], XrMatrix4x4f_TransformColumnSSE(a0, a1, a2, a3, _mm_loadu_ps(&b[i].m[c])));
+            }
+        }
+    }
+#elif defined(XR_LINEAR_SIMD_NEON)
+    {
+        const float32x4_t a0 = vld1q_f32(&a->m[0]);
+        const float32x4_t a1 = vld1q_f32(&a->m[4]);
+        const float32x4_t a2 = vld1q_f32(&a->m[8]);
+        const float32x4_t a3 = vld1q_f32(&a->m[12]);
+        for (; i < count; i++) {
+            for (int c = 0; c < 16; c += 4) {
+                vst1q_f32(&results[i].m[c], XrMatrix4x4f_TransformColumnNEON(a0, a1, a2, a3, vld1q_f32(&b[i].m[c])));
+            }
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        XrMatrix4x4f temp;
+        XrMatrix4x4f_Multiply(&temp, a, &b[i]);
+        results[i] = temp;
+    }
+}
+
+// Creates combined translation(rotation(scale(object))) matrices from parallel arrays.
+// The SIMD versions compose four matrices at a time.
+inline static void XrMatrix4x4f_CreateTranslationRotationScaleBatch(XrMatrix4x4f* results, const XrVector3f* translations,
+                                                                    const XrQuaternionf* rotations, const XrVector3f* scales,
+                                                                    const size_t count) {
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_SSE)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i + 4 <= count; i += 4) {
+            // Transpose four quaternions into x, y, z and w lanes.
+            __m128 x = _mm_loadu_ps(&rotations[i + 0].x);
+            __m128 y = _mm_loadu_ps(&rotations[i + 1].x);
+            __m128 z = _mm_loadu_ps(&rotations[i + 2].x);
+            __m128 w = _mm_loadu_ps(&rotations[i + 3].x);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            const __m128 sx = _mm_setr_ps(scales[i + 0].x, scales[i + 1].x, scales[i + 2].x, scales[i + 3].x);
+            const __m128 sy = _mm_setr_ps(scales[i + 0].y, scales[i + 1].y, scales[i + 2].y, scales[i + 3].y);
+            const __m128 sz = _mm_setr_ps(scales[i + 0].z, scales[i + 1].z, scales[i + 2].z, scales[i + 3].z);
+
+            // Same terms as XrMatrix4x4f_CreateFromQuaternion().
+            const __m128 x2 = _mm_add_ps(x, x);
+            const __m128 y2 = _mm_add_ps(y, y);
+            const __m128 z2 = _mm_add_ps(z, z);
+            const __m128 xx2 = _mm_mul_ps(x, x2);
+            const __m128 yy2 = _mm_mul_ps(y, y2);
+            const __m128 zz2 = _mm_mul_ps(z, z2);
+            const __m128 yz2 = _mm_mul_ps(y, z2);
+            const __m128 wx2 = _mm_mul_ps(w, x2);
+            const __m128 xy2 = _mm_mul_ps(x, y2);
+            const __m128 wz2 = _mm_mul_ps(w, z2);
+            const __m128 xz2 = _mm_mul_ps(x, z2);
+            const __m128 wy2 = _mm_mul_ps(w, y2);
+
+            // Rows are lanes: after the transposes each register holds one matrix's column.
+            __m128 c0[4] = {_mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy2), zz2), sx), _mm_mul_ps(_mm_add_ps(xy2, wz2), sx),
+                            _mm_mul_ps(_mm_sub_ps(xz2, wy2), sx), _mm_setzero_ps()};
+            __m128 c1[4] = {_mm_mul_ps(_mm_sub_ps(xy2, wz2), sy), _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx2), zz2), sy),
+                            _mm_mul_ps(_mm_add_ps(yz2, wx2), sy), _mm_setzero_ps()};
+            __m128 c2[4] = {_mm_mul_ps(_mm_add_ps(xz2, wy2), sz), _mm_mul_ps(_mm_sub_ps(yz2, wx2), sz),
+                            _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx2), yy2), sz), _mm_setzero_ps()};
+            _MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+            _MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+            _MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+            for (int k = 0; k < 4; k++) {
+                _mm_storeu_ps(&results[i + k].m[0], c0[k]);
+                _mm_storeu_ps(&results[i + k].m[4], c1[k]);
+                _mm_storeu_ps(&results[i + k].m[8], c2[k]);
+                _mm_storeu_ps(&results[i + k].m[12], _mm_setr_ps(translations[i + k].x, translations[i + k].y, translations[i + k].z, 1.0f));
+            }
+        }
+    }
+#elif defined(XR_LINEAR_SIMD_NEON)
+    {
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4) {
+            // De-interleave four quaternions into x, y, z and w lanes, and the scales into x, y and z lanes.
+            const float32x4x4_t q = vld4q_f32(&rotations[i].x);
+            const float32x4x3_t s = vld3q_f32(&scales[i].x);
+            const float32x4_t x = q.val[0], y = q.val[1], z = q.val[2], w = q.val[3];
+
+            // Same terms as XrMatrix4x4f_CreateFromQuaternion().
+            const float32x4_t x2 = vaddq_f32(x, x);
+            const float32x4_t y2 = vaddq_f32(y, y);
+            const float32x4_t z2 = vaddq_f32(z, z);
+            const float32x4_t xx2 = vmulq_f32(x, x2);
+            const float32x4_t yy2 = vmulq_f32(y, y2);
+            const float32x4_t zz2 = vmulq_f32(z, z2);
+            const float32x4_t yz2 = vmulq_f32(y, z2);
+            const float32x4_t wx2 = vmulq_f32(w, x2);
+            const float32x4_t xy2 = vmulq_f32(x, y2);
+            const float32x4_t wz2 = vmulq_f32(w, z2);
+            const float32x4_t xz2 = vmulq_f32(x, z2);
+            const float32x4_t wy2 = vmulq_f32(w, y2);
+
+            // Rows are lanes: after the transposes each register holds one matrix's column.
+            float32x4_t c0[4] = {vmulq_f32(vsubq_f32(vsubq_f32(one, yy2), zz2), s.val[0]), vmulq_f32(vaddq_f32(xy2, wz2), s.val[0]),
+                                 vmulq_f32(vsubq_f32(xz2, wy2), s.val[0]), zero};
+            float32x4_t c1[4] = {vmulq_f32(vsubq_f32(xy2, wz2), s.val[1]), vmulq_f32(vsubq_f32(vsubq_f32(one, xx2), zz2), s.val[1]),
+                                 vmulq_f32(vaddq_f32(yz2, wx2), s.val[1]), zero};
+            float32x4_t c2[4] = {vmulq_f32(vaddq_f32(xz2, wy2), s.val[2]), vmulq_f32(vsubq_f32(yz2, wx2), s.val[2]),
+                                 vmulq_f32(vsubq_f32(vsubq_f32(one, xx2), yy2), s.val[2]), zero};
+            XrMatrix4x4f_TransposeNEON(&c0[0], &c0[1], &c0[2], &c0[3]);
+            XrMatrix4x4f_TransposeNEON(&c1[0], &c1[1], &c1[2], &c1[3]);
+            XrMatrix4x4f_TransposeNEON(&c2[0], &c2[1], &c2[2], &c2[3]);
+            for (int k = 0; k < 4; k++) {
+                vst1q_f32(&results[i + k].m[0], c0[k]);
+                vst1q_f32(&results[i + k].m[4], c1[k]);
+                vst1q_f32(&results[i + k].m[8], c2[k]);
+                results[i + k].m[12] = translations[i + k].x;
+                results[i + k].m[13] = translations[i + k].y;
+                results[i + k].m[14] = translations[i + k].z;
+                results[i + k].m[15] = 1.0f;
+            }
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        // translation * rotation * scale only scales the rotation's columns and sets the translation column.
+        XrMatrix4x4f_CreateFromQuaternion(&results[i], &rotations[i]);
+        const float* scale = &scales[i].x;
+        for (int c = 0; c < 3; c++) {
+            results[i].m[c * 4 + 0] *= scale[c];
+            results[i].m[c * 4 + 1] *= scale[c];
+            results[i].m[c * 4 + 2] *= scale[c];
+        }
+        results[i].m[12] = translations[i].x;
+        results[i].m[13] = translations[i].y;
+        results[i].m[14] = translations[i].z;
+    }
+}
+
+// Transforms 3D points, including the divide by w.
+inline static void XrMatrix4x4f_TransformVector3fBatch(XrVector3f* results, const XrMatrix4x4f* m, const XrVector3f* v,
+                                                       const size_t count) {
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_AVX2)
+    {
+        const __m256 m0 = _mm256_broadcast_ps((const __m128*)&m->m[0]);
+        const __m256 m1 = _mm256_broadcast_ps((const __m128*)&m->m[4]);
+        const __m256 m2 = _mm256_broadcast_ps((const __m128*)&m->m[8]);
+        const __m256 m3 = _mm256_broadcast_ps((const __m128*)&m->m[12]);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        for (; i + 2 <= count; i += 2) {
+            const __m256 p = _mm256_setr_ps(v[i].x, v[i].y, v[i].z, 0.0f, v[i + 1].x, v[i + 1].y, v[i + 1].z, 0.0f);
+            __m256 r = _mm256_mul_ps(m0, _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm256_add_ps(r, _mm256_mul_ps(m1, _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm256_add_ps(r, _mm256_mul_ps(m2, _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm256_add_ps(r, m3);
+            r = _mm256_mul_ps(r, _mm256_div_ps(one, _mm256_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3))));
+            float out[8];
+            _mm256_storeu_ps(out, r);
+            results[i + 0].x = out[0];
+            results[i + 0].y = out[1];
+            results[i + 0].z = out[2];
+            results[i + 1].x = out[4];
+            results[i + 1].y = out[5];
+            results[i + 1].z = out[6];
+        }
+    }
+#endif
+#if defined(XR_LINEAR_SIMD_SSE)
+    {
+        const __m128 m0 = _mm_loadu_ps(&m->m[0]);
+        const __m128 m1 = _mm_loadu_ps(&m->m[4]);
+        const __m128 m2 = _mm_loadu_ps(&m->m[8]);
+        const __m128 m3 = _mm_loadu_ps(&m->m[12]);
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i < count; i++) {
+            __m128 r = _mm_mul_ps(m0, _mm_set1_ps(v[i].x));
+            r = _mm_add_ps(r, _mm_mul_ps(m1, _mm_set1_ps(v[i].y)));
+            r = _mm_add_ps(r, _mm_mul_ps(m2, _mm_set1_ps(v[i].z)));
+            r = _mm_add_ps(r, m3);
+            r = _mm_mul_ps(r, _mm_div_ps(one, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+            float out[4];
+            _mm_storeu_ps(out, r);
+            results[i].x = out[0];
+            results[i].y = out[1];
+            results[i].z = out[2];
+        }
+    }
+#elif defined(XR_LINEAR_SIMD_NEON)
+    {
+        const float32x4_t m0 = vld1q_f32(&m->m[0]);
+        const float32x4_t m1 = vld1q_f32(&m->m[4]);
+        const float32x4_t m2 = vld1q_f32(&m->m[8]);
+        const float32x4_t m3 = vld1q_f32(&m->m[12]);
+        for (; i < count; i++) {
+            float32x4_t r = vmulq_n_f32(m0, v[i].x);
+            r = vaddq_f32(r, vmulq_n_f32(m1, v[i].y));
+            r = vaddq_f32(r, vmulq_n_f32(m2, v[i].z));
+            r = vaddq_f32(r, m3);
+            r = vmulq_n_f32(r, 1.0f / vgetq_lane_f32(r, 3));
+            results[i].x = vgetq_lane_f32(r, 0);
+            results[i].y = vgetq_lane_f32(r, 1);
+            results[i].z = vgetq_lane_f32(r, 2);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        XrMatrix4x4f_TransformVector3f(&results[i], m, &v[i]);
+    }
+}
+
+/*
+================================================================================================
+
+Batch culling
+
+'planes' holds 6 planes per frustum, as returned by XrMatrix4x4f_GetFrustumPlanes(). With a
+'frustumCount' of 2 (both eyes' planes back to back) an element is visible when it intersects
+either frustum, i.e. it is tested against the combined stereo frustum in a single pass.
+Bit i of 'visibleMask' is set when element i is visible. 'visibleMask' must hold (count + 31) / 32
+words, which are overwritten. The SIMD versions test 4 (SSE2, NEON) or 8 (AVX2) elements at a time.
+
+================================================================================================
+*/
+
+inline static bool XrFrustum_IsSphereVisible(const XrVector4f* planes, const int frustumCount, const float x, const float y,
+                                             const float z, const float radius) {
+    for (int f = 0; f < frustumCount; f++) {
+        int p = 0;
+        for (; p < 6; p++) {
+            const XrVector4f* plane = &planes[f * 6 + p];
+            if (plane->x * x + plane->y * y + plane->z * z + plane->w < -radius) {
+                break;
+            }
+        }
+        if (p == 6) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline static bool XrFrustum_IsBoundsVisible(const XrVector4f* planes, const int frustumCount, const XrVector3f* mins,
+                                             const XrVector3f* maxs) {
+    for (int f = 0; f < frustumCount; f++) {
+        int p = 0;
+        for (; p < 6; p++) {
+            // Test the corner furthest along the plane normal.
+            const XrVector4f* plane = &planes[f * 6 + p];
+            const float x = plane->x >= 0.0f ? maxs->x : mins->x;
+            const float y = plane->y >= 0.0f ? maxs->y : mins->y;
+            const float z = plane->z >= 0.0f ? maxs->z : mins->z;
+            if (plane->x * x + plane->y * y + plane->z * z + plane->w < 0.0f) {
+                break;
+            }
+        }
+        if (p == 6) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline static void XrFrustum_CullSpheresSoA(uint32_t* visibleMask, const XrVector4f* planes, const int frustumCount,
+                                            const XrSpheresSoA* spheres, const size_t count) {
+    for (size_t w = 0; w < (count + 31) / 32; w++) {
+        visibleMask[w] = 0;
+    }
+
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(&spheres->centerX[i]);
+        const __m256 y = _mm256_loadu_ps(&spheres->centerY[i]);
+        const __m256 z = _mm256_loadu_ps(&spheres->centerZ[i]);
+        const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&spheres->radius[i]));
+        __m256 visible = _mm256_setzero_ps();
+        for (int f = 0; f < frustumCount; f++) {
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int p = 0; p < 6; p++) {
+                const XrVector4f* plane = &planes[f * 6 + p];
+                __m256 d = _mm256_mul_ps(_mm256_set1_ps(plane->x), x);
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane->y), y));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane->z), z));
+                d = _mm256_add_ps(d, _mm256_set1_ps(plane->w));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negRadius, _CMP_GE_OQ));
+            }
+            visible = _mm256_or_ps(visible, inside);
+        }
+        visibleMask[i >> 5] |= (uint32_t)_mm256_movemask_ps(visible) << (i & 31);
+    }
+#endif
+#if defined(XR_LINEAR_SIMD_SSE)
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&spheres->centerX[i]);
+        const __m128 y = _mm_loadu_ps(&spheres->centerY[i]);
+        const __m128 z = _mm_loadu_ps(&spheres->centerZ[i]);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres->radius[i]));
+        __m128 visible = _mm_setzero_ps();
+        for (int f = 0; f < frustumCount; f++) {
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int p = 0; p < 6; p++) {
+                const XrVector4f* plane = &planes[f * 6 + p];
+                __m128 d = _mm_mul_ps(_mm_set1_ps(plane->x), x);
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane->y), y));
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane->z), z));
+                d = _mm_add_ps(d, _mm_set1_ps(plane->w));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negRadius));
+            }
+            visible = _mm_or_ps(visible, inside);
+        }
+        visibleMask[i >> 5] |= (uint32_t)_mm_movemask_ps(visible) << (i & 31);
+    }
+#elif defined(XR_LINEAR_SIMD_NEON)
+    {
+        static const uint32_t laneBits[4] = {1, 2, 4, 8};
+        const uint32x4_t bits = vld1q_u32(laneBits);
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t x = vld1q_f32(&spheres->centerX[i]);
+            const float32x4_t y = vld1q_f32(&spheres->centerY[i]);
+            const float32x4_t z = vld1q_f32(&spheres->centerZ[i]);
+            const float32x4_t negRadius = vnegq_f32(vld1q_f32(&spheres->radius[i]));
+            uint32x4_t visible = vdupq_n_u32(0);
+            for (int f = 0; f < frustumCount; f++) {
+                uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+                for (int p = 0; p < 6; p++) {
+                    const XrVector4f* plane = &planes[f * 6 + p];
+                    float32x4_t d = vmulq_n_f32(x, plane->x);
+                    d = vaddq_f32(d, vmulq_n_f32(y, plane->y));
+                    d = vaddq_f32(d, vmulq_n_f32(z, plane->z));
+                    d = vaddq_f32(d, vdupq_n_f32(plane->w));
+                    inside = vandq_u32(inside, vcgeq_f32(d, negRadius));
+                }
+                visible = vorrq_u32(visible, inside);
+            }
+            const uint32x4_t laneMask = vandq_u32(visible, bits);
+            const uint32_t mask = vgetq_lane_u32(laneMask, 0) | vgetq_lane_u32(laneMask, 1) | vgetq_lane_u32(laneMask, 2) |
+                                  vgetq_lane_u32(laneMask, 3);
+            visibleMask[i >> 5] |= mask << (i & 31);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (XrFrustum_IsSphereVisible(planes, frustumCount, spheres->centerX[i], spheres->centerY[i], spheres->centerZ[i],
+                                      spheres->radius[i])) {
+            visibleMask[i >> 5] |= 1u << (i & 31);
+        }
+    }
+}
+
+inline static void XrFrustum_CullBoundsSoA(uint32_t* visibleMask, const XrVector4f* planes, const int frustumCount,
+                                           const XrBoundsSoA* bounds, const size_t count) {
+    for (size_t w = 0; w < (count + 31) / 32; w++) {
+        visibleMask[w] = 0;
+    }
+
+    // The planes are the same for every lane, so the corner furthest along each plane normal is picked
+    // by choosing which array to load from rather than by a per-lane select.
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        __m256 visible = _mm256_setzero_ps();
+        for (int f = 0; f < frustumCount; f++) {
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int p = 0; p < 6; p++) {
+                const XrVector4f* plane = &planes[f * 6 + p];
+                const __m256 x = _mm256_loadu_ps(plane->x >= 0.0f ? &bounds->maxX[i] : &bounds->minX[i]);
+                const __m256 y = _mm256_loadu_ps(plane->y >= 0.0f ? &bounds->maxY[i] : &bounds->minY[i]);
+                const __m256 z = _mm256_loadu_ps(plane->z >= 0.0f ? &bounds->maxZ[i] : &bounds->minZ[i]);
+                __m256 d = _mm256_mul_ps(_mm256_set1_ps(plane->x), x);
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane->y), y));
+                d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane->z), z));
+                d = _mm256_add_ps(d, _mm256_set1_ps(plane->w));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+            visible = _mm256_or_ps(visible, inside);
+        }
+        visibleMask[i >> 5] |= (uint32_t)_mm256_movemask_ps(visible) << (i & 31);
+    }
+#endif
+#if defined(XR_LINEAR_SIMD_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 visible = _mm_setzero_ps();
+        for (int f = 0; f < frustumCount; f++) {
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int p = 0; p < 6; p++) {
+                const XrVector4f* plane = &planes[f * 6 + p];
+                const __m128 x = _mm_loadu_ps(plane->x >= 0.0f ? &bounds->maxX[i] : &bounds->minX[i]);
+                const __m128 y = _mm_loadu_ps(plane->y >= 0.0f ? &bounds->maxY[i] : &bounds->minY[i]);
+                const __m128 z = _mm_loadu_ps(plane->z >= 0.0f ? &bounds->maxZ[i] : &bounds->minZ[i]);
+                __m128 d = _mm_mul_ps(_mm_set1_ps(plane->x), x);
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane->y), y));
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane->z), z));
+                d = _mm_add_ps(d, _mm_set1_ps(plane->w));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+            }
+            visible = _mm_or_ps(visible, inside);
+        }
+        visibleMask[i >> 5] |= (uint32_t)_mm_movemask_ps(visible) << (i & 31);
+    }
+#elif defined(XR_LINEAR_SIMD_NEON)
+    {
+        static const uint32_t laneBits[4] = {1, 2, 4, 8};
+        const uint32x4_t bits = vld1q_u32(laneBits);
+        for (; i + 4 <= count; i += 4) {
+            uint32x4_t visible = vdupq_n_u32(0);
+            for (int f = 0; f < frustumCount; f++) {
+                uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+                for (int p = 0; p < 6; p++) {
+                    const XrVector4f* plane = &planes[f * 6 + p];
+                    const float32x4_t x = vld1q_f32(plane->x >= 0.0f ? &bounds->maxX[i] : &bounds->minX[i]);
+                    const float32x4_t y = vld1q_f32(plane->y >= 0.0f ? &bounds->maxY[i] : &bounds->minY[i]);
+                    const float32x4_t z = vld1q_f32(plane->z >= 0.0f ? &bounds->maxZ[i] : &bounds->minZ[i]);
+                    float32x4_t d = vmulq_n_f32(x, plane->x);
+                    d = vaddq_f32(d, vmulq_n_f32(y, plane->y));
+                    d = vaddq_f32(d, vmulq_n_f32(z, plane->z));
+                    d = vaddq_f32(d, vdupq_n_f32(plane->w));
+                    inside = vandq_u32(inside, vcgeq_f32(d, vdupq_n_f32(0.0f)));
+                }
+                visible = vorrq_u32(visible, inside);
+            }
+            const uint32x4_t laneMask = vandq_u32(visible, bits);
+            const uint32_t mask = vgetq_lane_u32(laneMask, 0) | vgetq_lane_u32(laneMask, 1) | vgetq_lane_u32(laneMask, 2) |
+                                  vgetq_lane_u32(laneMask, 3);
+            visibleMask[i >> 5] |= mask << (i & 31);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        const XrVector3f mins = {bounds->minX[i], bounds->minY[i], bounds->minZ[i]};
+        const XrVector3f maxs = {bounds->maxX[i], bounds->maxY[i], bounds->maxZ[i]};
+        if (XrFrustum_IsBoundsVisible(planes, frustumCount, &mins, &maxs)) {
+            visibleMask[i >> 5] |= 1u << (i & 31);
+        }
+    }
+}
+
+/*
+================================================================================================
+
+Pose hierarchies
+
+XrPosef_Multiply(result, a, b) returns the pose b, given relative to a, in the space a is given in.
+The hierarchy functions take joints in any order where each parent comes before its children
+('parentIndices[i] < i', or -1 for a root) and produce model space poses from parent-relative ones.
+The structure-of-arrays version composes 4 joints at a time with SIMD whenever their parents have
+already been composed, so ordering joints breadth-first (by depth) makes the most of it.
+
+================================================================================================
+*/
+
+#if defined(XR_LINEAR_SIMD_SSE) || defined(XR_LINEAR_SIMD_NEON)
+// Minimal 4-wide float vector used to write the structure-of-arrays kernels below once for SSE2 and NEON.
+#if defined(XR_LINEAR_SIMD_SSE)
+typedef __m128 XrSimd4f;
+inline static XrSimd4f XrSimd4f_Load(const float* p) { return _mm_loadu_ps(p); }
+inline static void XrSimd4f_Store(float* p, const XrSimd4f v) { _mm_storeu_ps(p, v); }
+inline static XrSimd4f XrSimd4f_Set(const float x, const float y, const float z, const float w) { return _mm_setr_ps(x, y, z, w); }
+inline static XrSimd4f XrSimd4f_Set1(const float v) { return _mm_set1_ps(v); }
+inline static XrSimd4f XrSimd4f_Add(const XrSimd4f a, const XrSimd4f b) { return _mm_add_ps(a, b); }
+inline static XrSimd4f XrSimd4f_Sub(const XrSimd4f a, const XrSimd4f b) { return _mm_sub_ps(a, b); }
+inline static XrSimd4f XrSimd4f_Mul(const XrSimd4f a, const XrSimd4f b) { return _mm_mul_ps(a, b); }
+inline static void XrSimd4f_Transpose(XrSimd4f* r0, XrSimd4f* r1, XrSimd4f* r2, XrSimd4f* r3) { _MM_TRANSPOSE4_PS(*r0, *r1, *r2, *r3); }
+#else
+typedef float32x4_t XrSimd4f;
+inline static XrSimd4f XrSimd4f_Load(const float* p) { return vld1q_f32(p); }
+inline static void XrSimd4f_Store(float* p, const XrSimd4f v) { vst1q_f32(p, v); }
+inline static XrSimd4f XrSimd4f_Set(const float x, const float y, const float z, const float w) {
+    const float v[4] = {x, y, z, w};
+    return vld1q_f32(v);
+}
+inline static XrSimd4f XrSimd4f_Set1(const float v) { return vdupq_n_f32(v); }
+inline static XrSimd4f XrSimd4f_Add(const XrSimd4f a, const XrSimd4f b) { return vaddq_f32(a, b); }
+inline static XrSimd4f XrSimd4f_Sub(const XrSimd4f a, const XrSimd4f b) { return vsubq_f32(a, b); }
+inline static XrSimd4f XrSimd4f_Mul(const XrSimd4f a, const XrSimd4f b) { return vmulq_f32(a, b); }
+inline static void XrSimd4f_Transpose(XrSimd4f* r0, XrSimd4f* r1, XrSimd4f* r2, XrSimd4f* r3) { XrMatrix4x4f_TransposeNEON(r0, r1, r2, r3); }
+#endif
+
+// Writes the matrices of four poses given as x, y, z and w lanes.
+inline static void XrMatrix4x4f_CreateFromPoses4(XrMatrix4x4f* results, const XrSimd4f x, const XrSimd4f y, const XrSimd4f z,
+                                                 const XrSimd4f w, const XrSimd4f px, const XrSimd4f py, const XrSimd4f pz) {
+    // Same terms as XrMatrix4x4f_CreateFromQuaternion().
+    const XrSimd4f one = XrSimd4f_Set1(1.0f);
+    const XrSimd4f zero = XrSimd4f_Set1(0.0f);
+    const XrSimd4f x2 = XrSimd4f_Add(x, x);
+    const XrSimd4f y2 = XrSimd4f_Add(y, y);
+    const XrSimd4f z2 = XrSimd4f_Add(z, z);
+    const XrSimd4f xx2 = XrSimd4f_Mul(x, x2);
+    const XrSimd4f yy2 = XrSimd4f_Mul(y, y2);
+    const XrSimd4f zz2 = XrSimd4f_Mul(z, z2);
+    const XrSimd4f yz2 = XrSimd4f_Mul(y, z2);
+    const XrSimd4f wx2 = XrSimd4f_Mul(w, x2);
+    const XrSimd4f xy2 = XrSimd4f_Mul(x, y2);
+    const XrSimd4f wz2 = XrSimd4f_Mul(w, z2);
+    const XrSimd4f xz2 = XrSimd4f_Mul(x, z2);
+    const XrSimd4f wy2 = XrSimd4f_Mul(w, y2);
+
+    // Rows are lanes: after the transposes each register holds one matrix's column.
+    XrSimd4f c0[4] = {XrSimd4f_Sub(XrSimd4f_Sub(one, yy2), zz2), XrSimd4f_Add(xy2, wz2), XrSimd4f_Sub(xz2, wy2), zero};
+    XrSimd4f c1[4] = {XrSimd4f_Sub(xy2, wz2), XrSimd4f_Sub(XrSimd4f_Sub(one, xx2), zz2), XrSimd4f_Add(yz2, wx2), zero};
+    XrSimd4f c2[4] = {XrSimd4f_Add(xz2, wy2), XrSimd4f_Sub(yz2, wx2), XrSimd4f_Sub(XrSimd4f_Sub(one, xx2), yy2), zero};
+    XrSimd4f c3[4] = {px, py, pz, one};
+    XrSimd4f_Transpose(&c0[0], &c0[1], &c0[2], &c0[3]);
+    XrSimd4f_Transpose(&c1[0], &c1[1], &c1[2], &c1[3]);
+    XrSimd4f_Transpose(&c2[0], &c2[1], &c2[2], &c2[3]);
+    XrSimd4f_Transpose(&c3[0], &c3[1], &c3[2], &c3[3]);
+    for (int k = 0; k < 4; k++) {
+        XrSimd4f_Store(&results[k].m[0], c0[k]);
+        XrSimd4f_Store(&results[k].m[4], c1[k]);
+        XrSimd4f_Store(&results[k].m[8], c2[k]);
+        XrSimd4f_Store(&results[k].m[12], c3[k]);
+    }
+}
+#endif
+
+// Rotates a vector by a unit quaternion.
+inline static void XrQuaternionf_RotateVector3f(XrVector3f* result, const XrQuaternionf* q, const XrVector3f* v) {
+    // t = 2 * cross(q.xyz, v), result = v + q.w * t + cross(q.xyz, t)
+    const float tx = 2.0f * (q->y * v->z - q->z * v->y);
+    const float ty = 2.0f * (q->z * v->x - q->x * v->z);
+    const float tz = 2.0f * (q->x * v->y - q->y * v->x);
+    const XrVector3f r = {v->x + q->w * tx + (q->y * tz - q->z * ty), v->y + q->w * ty + (q->z * tx - q->x * tz),
+                          v->z + q->w * tz + (q->x * ty - q->y * tx)};
+    *result = r;
+}
+
+// Composes two poses: the pose 'b', given relative to 'a', transformed into the space 'a' is given in.
+// 'result' may alias 'a' or 'b'.
+inline static void XrPosef_Multiply(XrPosef* result, const XrPosef* a, const XrPosef* b) {
+    XrQuaternionf orientation;
+    XrQuaternionf_Multiply(&orientation, &b->orientation, &a->orientation);
+    XrVector3f position;
+    XrQuaternionf_RotateVector3f(&position, &a->orientation, &b->position);
+    XrVector3f_Add(&position, &position, &a->position);
+    result->orientation = orientation;
+    result->position = position;
+}
+
+// Converts parent-relative joint poses into model space poses. 'modelPoses' may alias 'localPoses'.
+inline static void XrPosef_ComposeHierarchy(XrPosef* modelPoses, const XrPosef* localPoses, const int32_t* parentIndices,
+                                            const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const int32_t parent = parentIndices[i];
+        assert(parent < (int32_t)i);
+        if (parent < 0) {
+            modelPoses[i] = localPoses[i];
+        } else {
+            XrPosef_Multiply(&modelPoses[i], &modelPoses[parent], &localPoses[i]);
+        }
+    }
+}
+
+// Structure-of-arrays version of XrPosef_ComposeHierarchy. 'modelPoses' may alias 'localPoses'.
+inline static void XrPosef_ComposeHierarchySoA(XrPosesSoA* modelPoses, const XrPosesSoA* localPoses, const int32_t* parentIndices,
+                                               const size_t count) {
+    XrPosesSoA* m = modelPoses;
+    const XrPosesSoA* l = localPoses;
+    size_t i = 0;
+    while (i < count) {
+#if defined(XR_LINEAR_SIMD_SSE) || defined(XR_LINEAR_SIMD_NEON)
+        if (i + 4 <= count && parentIndices[i + 0] < (int32_t)i && parentIndices[i + 1] < (int32_t)i &&
+            parentIndices[i + 2] < (int32_t)i && parentIndices[i + 3] < (int32_t)i) {
+            // Gather the four parents, using the identity pose for roots.
+            float pose[7][4];
+            for (int k = 0; k < 4; k++) {
+                const int32_t parent = parentIndices[i + k];
+                pose[0][k] = parent < 0 ? 0.0f : m->orientationX[parent];
+                pose[1][k] = parent < 0 ? 0.0f : m->orientationY[parent];
+                pose[2][k] = parent < 0 ? 0.0f : m->orientationZ[parent];
+                pose[3][k] = parent < 0 ? 1.0f : m->orientationW[parent];
+                pose[4][k] = parent < 0 ? 0.0f : m->positionX[parent];
+                pose[5][k] = parent < 0 ? 0.0f : m->positionY[parent];
+                pose[6][k] = parent < 0 ? 0.0f : m->positionZ[parent];
+            }
+            const XrSimd4f ax = XrSimd4f_Load(pose[0]), ay = XrSimd4f_Load(pose[1]), az = XrSimd4f_Load(pose[2]), aw = XrSimd4f_Load(pose[3]);
+            const XrSimd4f apx = XrSimd4f_Load(pose[4]), apy = XrSimd4f_Load(pose[5]), apz = XrSimd4f_Load(pose[6]);
+            const XrSimd4f bx = XrSimd4f_Load(&l->orientationX[i]), by = XrSimd4f_Load(&l->orientationY[i]);
+            const XrSimd4f bz = XrSimd4f_Load(&l->orientationZ[i]), bw = XrSimd4f_Load(&l->orientationW[i]);
+            const XrSimd4f bpx = XrSimd4f_Load(&l->positionX[i]), bpy = XrSimd4f_Load(&l->positionY[i]), bpz = XrSimd4f_Load(&l->positionZ[i]);
+
+            // orientation = a.orientation * b.orientation
+            const XrSimd4f qx = XrSimd4f_Sub(XrSimd4f_Add(XrSimd4f_Add(XrSimd4f_Mul(aw, bx), XrSimd4f_Mul(ax, bw)), XrSimd4f_Mul(ay, bz)), XrSimd4f_Mul(az, by));
+            const XrSimd4f qy = XrSimd4f_Add(XrSimd4f_Add(XrSimd4f_Sub(XrSimd4f_Mul(aw, by), XrSimd4f_Mul(ax, bz)), XrSimd4f_Mul(ay, bw)), XrSimd4f_Mul(az, bx));
+            const XrSimd4f qz = XrSimd4f_Add(XrSimd4f_Sub(XrSimd4f_Add(XrSimd4f_Mul(aw, bz), XrSimd4f_Mul(ax, by)), XrSimd4f_Mul(ay, bx)), XrSimd4f_Mul(az, bw));
+            const XrSimd4f qw = XrSimd4f_Sub(XrSimd4f_Sub(XrSimd4f_Sub(XrSimd4f_Mul(aw, bw), XrSimd4f_Mul(ax, bx)), XrSimd4f_Mul(ay, by)), XrSimd4f_Mul(az, bz));
+
+            // position = a.position + rotate(a.orientation, b.position)
+            const XrSimd4f two = XrSimd4f_Set1(2.0f);
+            const XrSimd4f tx = XrSimd4f_Mul(two, XrSimd4f_Sub(XrSimd4f_Mul(ay, bpz), XrSimd4f_Mul(az, bpy)));
+            const XrSimd4f ty = XrSimd4f_Mul(two, XrSimd4f_Sub(XrSimd4f_Mul(az, bpx), XrSimd4f_Mul(ax, bpz)));
+            const XrSimd4f tz = XrSimd4f_Mul(two, XrSimd4f_Sub(XrSimd4f_Mul(ax, bpy), XrSimd4f_Mul(ay, bpx)));
+            const XrSimd4f rx = XrSimd4f_Add(XrSimd4f_Add(bpx, XrSimd4f_Mul(aw, tx)), XrSimd4f_Sub(XrSimd4f_Mul(ay, tz), XrSimd4f_Mul(az, ty)));
+            const XrSimd4f ry = XrSimd4f_Add(XrSimd4f_Add(bpy, XrSimd4f_Mul(aw, ty)), XrSimd4f_Sub(XrSimd4f_Mul(az, tx), XrSimd4f_Mul(ax, tz)));
+            const XrSimd4f rz = XrSimd4f_Add(XrSimd4f_Add(bpz, XrSimd4f_Mul(aw, tz)), XrSimd4f_Sub(XrSimd4f_Mul(ax, ty), XrSimd4f_Mul(ay, tx)));
+
+            XrSimd4f_Store(&m->orientationX[i], qx);
+            XrSimd4f_Store(&m->orientationY[i], qy);
+            XrSimd4f_Store(&m->orientationZ[i], qz);
+            XrSimd4f_Store(&m->orientationW[i], qw);
+            XrSimd4f_Store(&m->positionX[i], XrSimd4f_Add(rx, apx));
+            XrSimd4f_Store(&m->positionY[i], XrSimd4f_Add(ry, apy));
+            XrSimd4f_Store(&m->positionZ[i], XrSimd4f_Add(rz, apz));
+            i += 4;
+            continue;
+        }
+#endif
+        const int32_t parent = parentIndices[i];
+        assert(parent < (int32_t)i);
+        XrPosef local = {{l->orientationX[i], l->orientationY[i], l->orientationZ[i], l->orientationW[i]},
+                         {l->positionX[i], l->positionY[i], l->positionZ[i]}};
+        if (parent >= 0) {
+            const XrPosef parentPose = {{m->orientationX[parent], m->orientationY[parent], m->orientationZ[parent], m->orientationW[parent]},
+                                        {m->positionX[parent], m->positionY[parent], m->positionZ[parent]}};
+            XrPosef_Multiply(&local, &parentPose, &local);
+        }
+        m->orientationX[i] = local.orientation.x;
+        m->orientationY[i] = local.orientation.y;
+        m->orientationZ[i] = local.orientation.z;
+        m->orientationW[i] = local.orientation.w;
+        m->positionX[i] = local.position.x;
+        m->positionY[i] = local.position.y;
+        m->positionZ[i] = local.position.z;
+        i++;
+    }
+}
+
+// Converts poses into rigid body matrices.
+inline static void XrMatrix4x4f_CreateFromPoseBatch(XrMatrix4x4f* results, const XrPosef* poses, const size_t count) {
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_SSE) || defined(XR_LINEAR_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        XrSimd4f x = XrSimd4f_Load(&poses[i + 0].orientation.x);
+        XrSimd4f y = XrSimd4f_Load(&poses[i + 1].orientation.x);
+        XrSimd4f z = XrSimd4f_Load(&poses[i + 2].orientation.x);
+        XrSimd4f w = XrSimd4f_Load(&poses[i + 3].orientation.x);
+        XrSimd4f_Transpose(&x, &y, &z, &w);
+        const XrSimd4f px = XrSimd4f_Set(poses[i + 0].position.x, poses[i + 1].position.x, poses[i + 2].position.x, poses[i + 3].position.x);
+        const XrSimd4f py = XrSimd4f_Set(poses[i + 0].position.y, poses[i + 1].position.y, poses[i + 2].position.y, poses[i + 3].position.y);
+        const XrSimd4f pz = XrSimd4f_Set(poses[i + 0].position.z, poses[i + 1].position.z, poses[i + 2].position.z, poses[i + 3].position.z);
+        XrMatrix4x4f_CreateFromPoses4(&results[i], x, y, z, w, px, py, pz);
+    }
+#endif
+    for (; i < count; i++) {
+        XrMatrix4x4f_CreateFromQuaternion(&results[i], &poses[i].orientation);
+        results[i].m[12] = poses[i].position.x;
+        results[i].m[13] = poses[i].position.y;
+        results[i].m[14] = poses[i].position.z;
+    }
+}
+
+// Structure-of-arrays version of XrMatrix4x4f_CreateFromPoseBatch.
+inline static void XrMatrix4x4f_CreateFromPosesSoA(XrMatrix4x4f* results, const XrPosesSoA* poses, const size_t count) {
+    size_t i = 0;
+#if defined(XR_LINEAR_SIMD_SSE) || defined(XR_LINEAR_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        XrMatrix4x4f_CreateFromPoses4(&results[i], XrSimd4f_Load(&poses->orientationX[i]), XrSimd4f_Load(&poses->orientationY[i]),
+                                      XrSimd4f_Load(&poses->orientationZ[i]), XrSimd4f_Load(&poses->orientationW[i]),
+                                      XrSimd4f_Load(&poses->positionX[i]), XrSimd4f_Load(&poses->positionY[i]),
+                                      XrSimd4f_Load(&poses->positionZ[i]));
+    }
+#endif
+    for (; i < count; i++) {
+        const XrQuaternionf orientation = {poses->orientationX[i], poses->orientationY[i], poses->orientationZ[i], poses->orientationW[i]};
+        XrMatrix4x4f_CreateFromQuaternion(&results[i], &orientation);
+        results[i].m[12] = poses->positionX[i];
+        results[i].m[13] = poses->positionY[i];
+        results[i].m[14] = poses->positionZ[i];
+    }
+}
+
 #endif  // XR_LINEAR_H_
@@ -46,6 +46,46 @@ void *uniformBuffer_Frag = nullptr;
 void *vertexShader = nullptr, *fragmentShader = nullptr;
 void *pipeline = nullptr;
 
+// Instanced cuboids: one per-instance vertex stream holding each cuboid's model matrix and color.
+constexpr uint32_t maxCuboidInstances = 64;
+void *instanceBuffer = nullptr;
+void *vertexShader_Instanced = nullptr;
+void *pipeline_Instanced = nullptr;
+
+struct CuboidInstance {
+    XrMatrix4x4f model;
+    XrVector4f color;
+};
+CuboidInstance cuboidInstances[maxCuboidInstances];
+
+// GPU frustum culling: a compute pass tests each cuboid's AABB against every view's frustum and appends the
+// survivors into culledInstanceBuffer, counting them in the instanceCount of a single indirect draw.
+// Only used by the APIs that implement compute; the others fall back to RenderCuboidsInstanced().
+bool gpuCulling = false;
+void *computeShader_FrustumCull = nullptr;
+void *pipeline_FrustumCull = nullptr;
+void *cullConstantsBuffer = nullptr;
+void *cullObjectBuffer = nullptr;
+void *culledInstanceBuffer = nullptr;
+void *indirectArgsBuffer = nullptr;
+
+constexpr uint32_t maxCullViews = 2;
+struct CullConstants {
+    XrVector4f planes[maxCullViews * 6];
+    uint32_t objectCount;
+    uint32_t viewCount;
+    uint32_t pad1;
+    uint32_t pad2;
+};
+struct CullObject {
+    XrMatrix4x4f model;
+    XrVector4f boundsMin;
+    XrVector4f boundsMax;
+    XrVector4f color;
+};
+CullConstants cullConstants;
+CullObject cullObjects[maxCuboidInstances];
+
 struct CameraConstants {
     XrMatrix4x4f viewProj;
     XrMatrix4x4f modelViewProj;
@@ -108,12 +148,22 @@ void CreateResources() {
     uniformBuffer_Vert = graphicsAPI->CreateBuffer(
         {GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(CameraConstants), &cameraConstants});
 
+    instanceBuffer = graphicsAPI->CreateBuffer(
+        {GraphicsAPI::BufferCreateInfo::Type::VERTEX, sizeof(CuboidInstance), sizeof(cuboidInstances),
+         &cuboidInstances});
+
     if (apiType == OPENGL_ES) {
         std::string vertexSource = ReadTextFile("VertexShader_GLES.glsl");
         vertexShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
 
         std::string fragmentSource = ReadTextFile("PixelShader_GLES.glsl");
         fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+        std::string vertexInstancedSource = ReadTextFile("VertexShader_Instanced_GLES.glsl");
+        vertexShader_Instanced = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexInstancedSource.data(), vertexInstancedSource.size()});
+
+        std::string computeFrustumCullSource = ReadTextFile("ComputeShader_FrustumCull_GLES.glsl");
+        computeShader_FrustumCull = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::COMPUTE, computeFrustumCullSource.data(), computeFrustumCullSource.size()});
     }
     if (apiType == OPENGL) {
         std::string vertexSource = ReadTextFile("VertexShader.glsl");
@@ -121,6 +171,12 @@ void CreateResources() {
 
         std::string fragmentSource = ReadTextFile("PixelShader.glsl");
         fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+        std::string vertexInstancedSource = ReadTextFile("VertexShader_Instanced.glsl");
+        vertexShader_Instanced = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexInstancedSource.data(), vertexInstancedSource.size()});
+
+        std::string computeFrustumCullSource = ReadTextFile("ComputeShader_FrustumCull.glsl");
+        computeShader_FrustumCull = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::COMPUTE, computeFrustumCullSource.data(), computeFrustumCullSource.size()});
     }
     if (apiType == VULKAN) {
         std::vector<char> vertexSource = ReadBinaryFile("VertexShader.spv");
@@ -128,6 +184,12 @@ void CreateResources() {
 
         std::vector<char> fragmentSource = ReadBinaryFile("PixelShader.spv");
         fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+        std::vector<char> vertexInstancedSource = ReadBinaryFile("VertexShader_Instanced.spv");
+        vertexShader_Instanced = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexInstancedSource.data(), vertexInstancedSource.size()});
+
+        std::vector<char> computeFrustumCullSource = ReadBinaryFile("ComputeShader_FrustumCull.spv");
+        computeShader_FrustumCull = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::COMPUTE, computeFrustumCullSource.data(), computeFrustumCullSource.size()});
     }
     if (apiType == D3D11) {
         std::vector<char> vertexSource = ReadBinaryFile("VertexShader_5_0.cso");
@@ -135,6 +197,9 @@ void CreateResources() {
 
         std::vector<char> fragmentSource = ReadBinaryFile("PixelShader_5_0.cso");
         fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+        std::vector<char> vertexInstancedSource = ReadBinaryFile("VertexShader_Instanced_5_0.cso");
+        vertexShader_Instanced = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexInstancedSource.data(), vertexInstancedSource.size()});
     }
     if (apiType == D3D12) {
         std::vector<char> vertexSource = ReadBinaryFile("VertexShader_5_1.cso");
@@ -142,6 +207,9 @@ void CreateResources() {
 
         std::vector<char> fragmentSource = ReadBinaryFile("PixelShader_5_1.cso");
         fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+        std::vector<char> vertexInstancedSource = ReadBinaryFile("VertexShader_Instanced_5_1.cso");
+        vertexShader_Instanced = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexInstancedSource.data(), vertexInstancedSource.size()});
     }
 
     GraphicsAPI::PipelineCreateInfo pipelineCI;
@@ -151,18 +219,67 @@ void CreateResources() {
     pipelineCI.inputAssemblyState = {GraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, false};
     pipelineCI.rasterisationState = {false, false, GraphicsAPI::PolygonMode::FILL, GraphicsAPI::CullMode::BACK, GraphicsAPI::FrontFace::COUNTER_CLOCKWISE, false, 0.0f, 0.0f, 0.0f, 1.0f};
     pipelineCI.multisampleState = {1, false, 1.0f, 0xFFFFFFFF, false, false};
-    pipelineCI.depthStencilState = {false, false, GraphicsAPI::CompareOp::GREATER, false, false, {}, {}, 0.0f, 1.0f};
+    // Reversed-Z: the projection maps near to 1 and far to 0, so clear depth to 0.0f and keep the nearer fragment.
+    pipelineCI.depthStencilState = {true, true, GraphicsAPI::CompareOp::GREATER_OR_EQUAL, false, false, {}, {}, 0.0f, 1.0f};
     pipelineCI.colorBlendState = {false, GraphicsAPI::LogicOp::NO_OP, {{true, GraphicsAPI::BlendFactor::SRC_ALPHA, GraphicsAPI::BlendFactor::ONE_MINUS_SRC_ALPHA, GraphicsAPI::BlendOp::ADD, GraphicsAPI::BlendFactor::ONE, GraphicsAPI::BlendFactor::ZERO, GraphicsAPI::BlendOp::ADD, (GraphicsAPI::ColorComponentBit)15}}, {0.0f, 0.0f, 0.0f, 0.0f}};
     pipelineCI.colorFormats = {swapchainFormat};
     pipelineCI.depthFormat = graphicsAPI->GetDepthFormat();
     pipelineCI.layout = {{1, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false}, {0, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::FRAGMENT, false}};
     pipeline = graphicsAPI->CreatePipeline(pipelineCI);
+
+    // Same state as above, but binding 1 is a per-instance stream of CuboidInstance.
+    GraphicsAPI::PipelineCreateInfo instancedPipelineCI = pipelineCI;
+    instancedPipelineCI.shaders = {vertexShader_Instanced, fragmentShader};
+    instancedPipelineCI.vertexInputState.attributes = {
+        {0, 0, GraphicsAPI::VertexType::VEC4, 0, "TEXCOORD"},
+        {1, 1, GraphicsAPI::VertexType::VEC4, offsetof(CuboidInstance, model) + 0 * sizeof(XrVector4f), "TEXCOORD"},
+        {2, 1, GraphicsAPI::VertexType::VEC4, offsetof(CuboidInstance, model) + 1 * sizeof(XrVector4f), "TEXCOORD"},
+        {3, 1, GraphicsAPI::VertexType::VEC4, offsetof(CuboidInstance, model) + 2 * sizeof(XrVector4f), "TEXCOORD"},
+        {4, 1, GraphicsAPI::VertexType::VEC4, offsetof(CuboidInstance, model) + 3 * sizeof(XrVector4f), "TEXCOORD"},
+        {5, 1, GraphicsAPI::VertexType::VEC4, offsetof(CuboidInstance, color), "TEXCOORD"}};
+    instancedPipelineCI.vertexInputState.bindings = {
+        {0, 0, 4 * sizeof(float), GraphicsAPI::VertexInputRate::PER_VERTEX},
+        {1, 0, sizeof(CuboidInstance), GraphicsAPI::VertexInputRate::PER_INSTANCE}};
+    pipeline_Instanced = graphicsAPI->CreatePipeline(instancedPipelineCI);
+
+    gpuCulling = computeShader_FrustumCull != nullptr;
+    if (gpuCulling) {
+        cullConstantsBuffer = graphicsAPI->CreateBuffer(
+            {GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(CullConstants), &cullConstants});
+        cullObjectBuffer = graphicsAPI->CreateBuffer(
+            {GraphicsAPI::BufferCreateInfo::Type::STORAGE, sizeof(CullObject), sizeof(cullObjects), nullptr});
+        culledInstanceBuffer = graphicsAPI->CreateBuffer(
+            {GraphicsAPI::BufferCreateInfo::Type::STORAGE, sizeof(CuboidInstance), sizeof(cuboidInstances), nullptr});
+        GraphicsAPI::DrawIndexedIndirectCommand drawCommand = {36, 0, 0, 0, 0};
+        indirectArgsBuffer = graphicsAPI->CreateBuffer(
+            {GraphicsAPI::BufferCreateInfo::Type::INDIRECT, sizeof(drawCommand), sizeof(drawCommand), &drawCommand});
+
+        GraphicsAPI::ComputePipelineCreateInfo cullPipelineCI;
+        cullPipelineCI.shader = computeShader_FrustumCull;
+        cullPipelineCI.layout = {
+            {0, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, false},
+            {1, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, true},
+            {2, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, true},
+            {3, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, true}};
+        pipeline_FrustumCull = graphicsAPI->CreateComputePipeline(cullPipelineCI);
+    }
 }
 
 void DestroyResources() {
+    if (gpuCulling) {
+        graphicsAPI->DestroyPipeline(pipeline_FrustumCull);
+        graphicsAPI->DestroyShader(computeShader_FrustumCull);
+        graphicsAPI->DestroyBuffer(indirectArgsBuffer);
+        graphicsAPI->DestroyBuffer(culledInstanceBuffer);
+        graphicsAPI->DestroyBuffer(cullObjectBuffer);
+        graphicsAPI->DestroyBuffer(cullConstantsBuffer);
+    }
+    graphicsAPI->DestroyPipeline(pipeline_Instanced);
     graphicsAPI->DestroyPipeline(pipeline);
+    graphicsAPI->DestroyShader(vertexShader_Instanced);
     graphicsAPI->DestroyShader(fragmentShader);
     graphicsAPI->DestroyShader(vertexShader);
+    graphicsAPI->DestroyBuffer(instanceBuffer);
     graphicsAPI->DestroyBuffer(uniformBuffer_Vert);
     graphicsAPI->DestroyBuffer(uniformBuffer_Frag);
     graphicsAPI->DestroyBuffer(indexBuffer);
@@ -187,14 +304,137 @@ void RenderCuboid(XrPosef pose, XrVector3f scale) {
     graphicsAPI->DrawIndexed(36);
 }
 
-void DrawTestObject()
-{
+// Draws 'count' cuboids with a single instanced draw. The per-instance model matrices and colors are
+// uploaded into instanceBuffer, which is bound as a PER_INSTANCE vertex stream alongside the cube vertices.
+void RenderCuboidsInstanced(const XrPosef *poses, const XrVector3f *scales, const XrVector4f *instanceColors, uint32_t count) {
+    if (count > maxCuboidInstances) {
+        std::cerr << "WARNING: Clamping instanced cuboid count " << count << " to " << maxCuboidInstances << "." << std::endl;
+        count = maxCuboidInstances;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        XrMatrix4x4f_CreateTranslationRotationScale(&cuboidInstances[i].model, &poses[i].position, &poses[i].orientation, &scales[i]);
+        cuboidInstances[i].color = instanceColors[i];
+    }
+
+    graphicsAPI->SetPipeline(pipeline_Instanced);
+
+    graphicsAPI->SetBufferData(instanceBuffer, 0, sizeof(CuboidInstance) * count, cuboidInstances);
+    graphicsAPI->SetBufferData(uniformBuffer_Vert, 0, sizeof(CameraConstants), &cameraConstants);
+    graphicsAPI->SetDescriptor({1, uniformBuffer_Vert, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false});
+    graphicsAPI->SetDescriptor({0, uniformBuffer_Frag, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::FRAGMENT, false});
+    graphicsAPI->UpdateDescriptors();
 
+    void *vertexBuffers[] = {vertexBuffer, instanceBuffer};
+    graphicsAPI->SetVertexBuffers(vertexBuffers, 2);
+    graphicsAPI->SetIndexBuffer(indexBuffer);
+
+    graphicsAPI->DrawIndexed(36, count);
+}
+
+// Culls 'count' unit cuboids against the frusta of 'viewCount' views on the GPU. Survivors are compacted into
+// culledInstanceBuffer and counted in indirectArgsBuffer, ready for DrawCuboidsIndirect().
+// Records a dispatch, so call it before SetRenderAttachments().
+void CullCuboidsGPU(const XrMatrix4x4f *viewProjs, uint32_t viewCount, const XrPosef *poses, const XrVector3f *scales, const XrVector4f *instanceColors, uint32_t count) {
+    if (count > maxCuboidInstances) {
+        std::cerr << "WARNING: Clamping culled cuboid count " << count << " to " << maxCuboidInstances << "." << std::endl;
+        count = maxCuboidInstances;
+    }
+    if (viewCount > maxCullViews) {
+        std::cerr << "WARNING: Clamping cull view count " << viewCount << " to " << maxCullViews << "." << std::endl;
+        viewCount = maxCullViews;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        XrMatrix4x4f_CreateTranslationRotationScale(&cullObjects[i].model, &poses[i].position, &poses[i].orientation, &scales[i]);
+        cullObjects[i].boundsMin = {-0.5f, -0.5f, -0.5f, 1.0f};
+        cullObjects[i].boundsMax = {+0.5f, +0.5f, +0.5f, 1.0f};
+        cullObjects[i].color = instanceColors[i];
+    }
+    for (uint32_t i = 0; i < viewCount; i++) {
+        XrMatrix4x4f_GetFrustumPlanes(&cullConstants.planes[i * 6], &viewProjs[i], apiType);
+    }
+    cullConstants.objectCount = count;
+    cullConstants.viewCount = viewCount;
+
+    // Reset the instance count; the compute shader atomically increments it for each surviving cuboid.
+    GraphicsAPI::DrawIndexedIndirectCommand drawCommand = {36, 0, 0, 0, 0};
+    graphicsAPI->SetBufferData(indirectArgsBuffer, 0, sizeof(drawCommand), &drawCommand);
+    graphicsAPI->SetBufferData(cullObjectBuffer, 0, sizeof(CullObject) * count, cullObjects);
+    graphicsAPI->SetBufferData(cullConstantsBuffer, 0, sizeof(CullConstants), &cullConstants);
+
+    graphicsAPI->SetPipeline(pipeline_FrustumCull);
+    graphicsAPI->SetDescriptor({0, cullConstantsBuffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, false, 0, sizeof(CullConstants)});
+    graphicsAPI->SetDescriptor({1, cullObjectBuffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, true, 0, sizeof(CullObject) * count});
+    graphicsAPI->SetDescriptor({2, culledInstanceBuffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, true, 0, sizeof(CuboidInstance) * maxCuboidInstances});
+    graphicsAPI->SetDescriptor({3, indirectArgsBuffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::COMPUTE, true, 0, sizeof(drawCommand)});
+    graphicsAPI->UpdateDescriptors();
+
+    constexpr uint32_t groupSize = 64;  // Matches local_size_x in ComputeShader_FrustumCull.
+    graphicsAPI->Dispatch((count + groupSize - 1) / groupSize);
+}
+
+// Draws the cuboids that survived CullCuboidsGPU() with one indirect draw. The instance count is never read back to the CPU.
+void DrawCuboidsIndirect() {
+    graphicsAPI->SetPipeline(pipeline_Instanced);
+
+    graphicsAPI->SetBufferData(uniformBuffer_Vert, 0, sizeof(CameraConstants), &cameraConstants);
+    graphicsAPI->SetDescriptor({1, uniformBuffer_Vert, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false});
+    graphicsAPI->SetDescriptor({0, uniformBuffer_Frag, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::FRAGMENT, false});
+    graphicsAPI->UpdateDescriptors();
+
+    void *vertexBuffers[] = {vertexBuffer, culledInstanceBuffer};
+    graphicsAPI->SetVertexBuffers(vertexBuffers, 2);
+    graphicsAPI->SetIndexBuffer(indexBuffer);
+
+    graphicsAPI->DrawIndexedIndirect(indirectArgsBuffer);
+}
+
+XrPosef testPoses[maxCuboidInstances];
+XrVector3f testScales[maxCuboidInstances];
+XrVector4f testColors[maxCuboidInstances];
+uint32_t testCount = 0;
+
+// Culls the test cuboids against the frusta of 'viewCount' views on the CPU, using their bounding spheres,
+// and compacts the survivors to the front of the test arrays.
+void CullCuboidsCPU(const XrMatrix4x4f *viewProjs, uint32_t viewCount) {
+    XrVector4f planes[maxCullViews * 6];
+    viewCount = std::min(viewCount, maxCullViews);
+    for (uint32_t i = 0; i < viewCount; i++) {
+        XrMatrix4x4f_GetFrustumPlanes(&planes[i * 6], &viewProjs[i], apiType);
+    }
+
+    float centerX[maxCuboidInstances], centerY[maxCuboidInstances], centerZ[maxCuboidInstances], radius[maxCuboidInstances];
+    for (uint32_t i = 0; i < testCount; i++) {
+        centerX[i] = testPoses[i].position.x;
+        centerY[i] = testPoses[i].position.y;
+        centerZ[i] = testPoses[i].position.z;
+        radius[i] = 0.5f * XrVector3f_Length(&testScales[i]);
+    }
+    const XrSpheresSoA spheres = {centerX, centerY, centerZ, radius};
+    uint32_t visibleMask[(maxCuboidInstances + 31) / 32];
+    XrFrustum_CullSpheresSoA(visibleMask, planes, int(viewCount), &spheres, testCount);
+
+    uint32_t visibleCount = 0;
+    for (uint32_t i = 0; i < testCount; i++) {
+        if (visibleMask[i / 32] & (1u << (i % 32))) {
+            testPoses[visibleCount] = testPoses[i];
+            testScales[visibleCount] = testScales[i];
+            testColors[visibleCount] = testColors[i];
+            visibleCount++;
+        }
+    }
+    testCount = visibleCount;
+}
+
+// Animates the test cuboids and culls them, on the GPU when supported.
+// Call before SetRenderAttachments(), then call DrawTestObject() inside the render pass.
+void UpdateTestObject()
+{
 	// Compute the view-projection transform.
 	// All matrices (including OpenXR's) are column-major, right-handed.
-	XrMatrix4x4f proj;
+	// Reversed-Z with an infinite far plane to match the GREATER_OR_EQUAL depth test; cached while the FOV is unchanged.
+	static XrProjectionCache projCache = {};
 	XrFovf fov={-.5f,.5f,.5f,-.5f};
-	XrMatrix4x4f_CreateProjectionFov(&proj, OPENGL_ES, fov, 0.05f, 100.0f);
+	const XrMatrix4x4f& proj = *XrProjectionCache_Get(&projCache, apiType, fov, 0.05f, 0.0f, true);
 	XrMatrix4x4f toView;
 	XrVector3f scale1m{1.0f, 1.0f, 1.0f};
 	XrVector3f view_position={0,0,0};
@@ -204,12 +444,11 @@ void DrawTestObject()
 	XrMatrix4x4f_InvertRigidBody(&view, &toView);
 	XrMatrix4x4f_Multiply(&cameraConstants.viewProj, &proj, &view);
 
-	// Let's draw a cuboid at the floor. Scale it by 2 in the X and Z, and 0.1 in the Y,
-	RenderCuboid({{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, -1.5f, 0.0f}}, {2.0f, 0.1f, 2.0f});
 	float scale=1.0f;
 	static float time=0.f;
 	time+=0.1f;
     float angleRad=float(time)*0.002f;
+	testCount=0;
 	for(int i=0;i<4;i++)
 	{
 		float x=scale*(float(i)-1.5f);
@@ -222,11 +461,31 @@ void DrawTestObject()
 				XrQuaternionf q;
 				XrVector3f axis={0,0.707f,0.707f};
 				XrQuaternionf_CreateFromAxisAngle(&q,&axis,angleRad);
-				RenderCuboid({q, {x,y,z}}, {0.1f, 0.2f, 0.1f});
-
+				testPoses[testCount]={q, {x,y,z}};
+				testScales[testCount]={0.1f, 0.2f, 0.1f};
+				testColors[testCount]={0.25f+0.25f*float(i), 0.25f+0.25f*float(j), 0.25f+0.25f*float(k), 1.0f};
+				testCount++;
 			}
 		}
 	}
+	if (gpuCulling) {
+		// A single view here; a stereo renderer passes both eyes' view-projections to cull against their union.
+		CullCuboidsGPU(&cameraConstants.viewProj, 1, testPoses, testScales, testColors, testCount);
+	} else {
+		CullCuboidsCPU(&cameraConstants.viewProj, 1);
+	}
+}
+
+void DrawTestObject()
+{
+	// Let's draw a cuboid at the floor. Scale it by 2 in the X and Z, and 0.1 in the Y,
+	RenderCuboid({{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, -1.5f, 0.0f}}, {2.0f, 0.1f, 2.0f});
+	// All 64 cuboids share the same mesh, so draw them with one instanced call.
+	if (gpuCulling) {
+		DrawCuboidsIndirect();
+	} else {
+		RenderCuboidsInstanced(testPoses, testScales, testColors, testCount);
+	}
 }
 
 int main() {
@@ -308,111 +567,7 @@ int main() {
     imageViewCI.layerCount = 1;
     void *depthImageView = graphicsAPI->CreateImageView(imageViewCI);
 
-    //CreateResources();
-
-    struct CameraConstants {
-        XrMatrix4x4f viewProj;
-        XrMatrix4x4f modelViewProj;
-        XrMatrix4x4f model;
-    };
-    CameraConstants cameraConstants;
-
-    XrVector4f colors[6] = {
-        {1.00f, 0.00f, 0.00f, 1.00f},
-        {0.10f, 0.00f, 0.00f, 1.00f},
-        {0.00f, 0.60f, 0.00f, 1.00f},
-        {0.00f, 0.10f, 0.00f, 1.00f},
-        {0.00f, 0.20f, 1.00f, 1.00f},
-        {0.00f, 0.02f, 0.10f, 1.00f}};
-
-    constexpr XrVector4f vertexPositions[] = {
-        {+0.5f, +0.5f, +0.5f, 1.0f},
-        {+0.5f, +0.5f, -0.5f, 1.0f},
-        {+0.5f, -0.5f, +0.5f, 1.0f},
-        {+0.5f, -0.5f, -0.5f, 1.0f},
-        {-0.5f, +0.5f, +0.5f, 1.0f},
-        {-0.5f, +0.5f, -0.5f, 1.0f},
-        {-0.5f, -0.5f, +0.5f, 1.0f},
-        {-0.5f, -0.5f, -0.5f, 1.0f}};
-
-#define CUBE_FACE(V1, V2, V3, V4, V5, V6) vertexPositions[V1], vertexPositions[V2], vertexPositions[V3], vertexPositions[V4], vertexPositions[V5], vertexPositions[V6],
-
-    XrVector4f cubeVertices[] = {
-        CUBE_FACE(2, 1, 0, 2, 3, 1)  // -X
-        CUBE_FACE(6, 4, 5, 6, 5, 7)  // +X
-        CUBE_FACE(0, 1, 5, 0, 5, 4)  // -Y
-        CUBE_FACE(2, 6, 7, 2, 7, 3)  // +Y
-        CUBE_FACE(0, 4, 6, 0, 6, 2)  // -Z
-        CUBE_FACE(1, 3, 7, 1, 7, 5)  // +Z
-    };
-
-    uint32_t cubeIndices[36] = {
-        0, 1, 2, 3, 4, 5,        // -X
-        6, 7, 8, 9, 10, 11,      // +X
-        12, 13, 14, 15, 16, 17,  // -Y
-        18, 19, 20, 21, 22, 23,  // +Y
-        24, 25, 26, 27, 28, 29,  // -Z
-        30, 31, 32, 33, 34, 35,  // +Z
-    };
-
-    void* vertexBuffer = graphicsAPI->CreateBuffer(
-        {GraphicsAPI::BufferCreateInfo::Type::VERTEX, sizeof(float) * 4, sizeof(cubeVertices),
-         &cubeVertices});
-
-    void* indexBuffer = graphicsAPI->CreateBuffer(
-        {GraphicsAPI::BufferCreateInfo::Type::INDEX, sizeof(uint32_t), sizeof(cubeIndices),
-         &cubeIndices});
-
-    void* uniformBuffer_Frag = graphicsAPI->CreateBuffer(
-        {GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(colors), colors});
-
-    void* uniformBuffer_Vert = graphicsAPI->CreateBuffer(
-        {GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(CameraConstants), &cameraConstants});
-
-    void *vertexShader = nullptr;
-    void *fragmentShader =  nullptr;
-    if (apiType == OPENGL) {
-        std::string vertexSource = ReadTextFile("VertexShader.glsl");
-        vertexShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
-
-        std::string fragmentSource = ReadTextFile("PixelShader.glsl");
-        fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
-    }
-    if (apiType == VULKAN) {
-        std::vector<char> vertexSource = ReadBinaryFile("VertexShader.spv");
-        vertexShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
-
-        std::vector<char> fragmentSource = ReadBinaryFile("PixelShader.spv");
-        fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
-    }
-    if (apiType == D3D11) {
-        std::vector<char> vertexSource = ReadBinaryFile("VertexShader_5_0.cso");
-        vertexShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
-
-        std::vector<char> fragmentSource = ReadBinaryFile("PixelShader_5_0.cso");
-        fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
-    }
-    if (apiType == D3D12) {
-        std::vector<char> vertexSource = ReadBinaryFile("VertexShader_5_1.cso");
-        vertexShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
-
-        std::vector<char> fragmentSource = ReadBinaryFile("PixelShader_5_1.cso");
-        fragmentShader = graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
-    }
-
-    GraphicsAPI::PipelineCreateInfo pipelineCI;
-    pipelineCI.shaders = {vertexShader, fragmentShader};
-    pipelineCI.vertexInputState.attributes = {{0, 0, GraphicsAPI::VertexType::VEC4, 0, "TEXCOORD"}};
-    pipelineCI.vertexInputState.bindings = {{0, 0, 4 * sizeof(float)}};
-    pipelineCI.inputAssemblyState = {GraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, false};
-    pipelineCI.rasterisationState = {false, false, GraphicsAPI::PolygonMode::FILL, GraphicsAPI::CullMode::BACK, GraphicsAPI::FrontFace::COUNTER_CLOCKWISE, false, 0.0f, 0.0f, 0.0f, 1.0f};
-    pipelineCI.multisampleState = {1, false, 1.0f, 0xFFFFFFFF, false, false};
-    pipelineCI.depthStencilState = {true, true, GraphicsAPI::CompareOp::LESS_OR_EQUAL, false, false, {}, {}, 0.0f, 1.0f};
-    pipelineCI.colorBlendState = {false, GraphicsAPI::LogicOp::NO_OP, {{true, GraphicsAPI::BlendFactor::SRC_ALPHA, GraphicsAPI::BlendFactor::ONE_MINUS_SRC_ALPHA, GraphicsAPI::BlendOp::ADD, GraphicsAPI::BlendFactor::ONE, GraphicsAPI::BlendFactor::ZERO, GraphicsAPI::BlendOp::ADD, (GraphicsAPI::ColorComponentBit)15}}, {0.0f, 0.0f, 0.0f, 0.0f}};
-    pipelineCI.colorFormats = {swapchainFormat};
-    pipelineCI.depthFormat = graphicsAPI->GetDepthFormat();
-    pipelineCI.layout = {{1, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false}, {0, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::FRAGMENT, false}};
-    void* pipeline = graphicsAPI->CreatePipeline(pipelineCI);
+    CreateResources();
 
     // Main Render Loop
     while (!g_WindowQuit) {
@@ -424,7 +579,10 @@ int main() {
         // Rendering
         graphicsAPI->BeginRendering();
         graphicsAPI->ClearColor(swapchainImageViews[imageIndex], 0.22f, 0.17f, 0.35f, 1.00f);
-        graphicsAPI->ClearDepth(depthImageView, 1.0f);
+        graphicsAPI->ClearDepth(depthImageView, 0.0f);  // Reversed-Z
+
+        // The culling dispatch must be recorded before the render pass begins.
+        UpdateTestObject();
 
         graphicsAPI->SetRenderAttachments(&swapchainImageViews[imageIndex], 1, depthImageView, width, height, pipeline);
         GraphicsAPI::Viewport viewport = {0.0f, 0.0f, (float)width, (float)height, 0.0f, 1.0f};
@@ -432,53 +590,14 @@ int main() {
         graphicsAPI->SetViewports(&viewport, 1);
         graphicsAPI->SetScissors(&scissor, 1);
 
-        float fov_deg_v = 90.0f;
-        float fov_deg_h = fov_deg_v * (float(height) / float(width));
-        XrFovf fov;
-        fov.angleLeft = -(fov_deg_h /2.0f);
-        fov.angleRight = +(fov_deg_h / 2.0f);
-        fov.angleUp = -(fov_deg_v / 2.0f);
-        fov.angleDown = +(fov_deg_v / 2.0f);
-
-        XrMatrix4x4f proj;
-        XrMatrix4x4f_CreateProjectionFov(&proj, D3D11, fov, 0.05f, 100.0f);
-
-        XrMatrix4x4f view = {
-            1.0f, 0.0f, 0.0f, 0.0f,
-            0.0f, 1.0f, 0.0f, 0.0f,
-            0.0f, 0.0f, 1.0f, 0.0f,
-            0.0f, 0.0f, 0.0f, 1.0f
-        };
-        XrMatrix4x4f_Multiply(&cameraConstants.viewProj, &proj, &view);
-        XrVector3f scale = {1.0f, 1.0f, 1.0f};
-        XrPosef pose = { {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -2.0f} };
-        XrMatrix4x4f_CreateTranslationRotationScale(&cameraConstants.model, &pose.position, &pose.orientation, &scale);
-        XrMatrix4x4f_Multiply(&cameraConstants.modelViewProj, &cameraConstants.viewProj, &cameraConstants.model);
-
-        graphicsAPI->SetPipeline(pipeline);
-
-        graphicsAPI->SetBufferData(uniformBuffer_Vert, 0, sizeof(CameraConstants), &cameraConstants);
-        graphicsAPI->SetDescriptor({1, uniformBuffer_Vert, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false});
-        graphicsAPI->SetBufferData(uniformBuffer_Frag, 0, sizeof(colors), (void*)colors);
-        graphicsAPI->SetDescriptor({0, uniformBuffer_Frag, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::FRAGMENT, false});
-        graphicsAPI->UpdateDescriptors();
-
-        graphicsAPI->SetVertexBuffers(&vertexBuffer, 1);
-        graphicsAPI->SetIndexBuffer(indexBuffer);
-        graphicsAPI->DrawIndexed(36);
+        DrawTestObject();
 
         graphicsAPI->EndRendering();
 
         graphicsAPI->PresentDesktopSwapchainImage(swapchain, imageIndex);
     }
 
-    graphicsAPI->DestroyPipeline(pipeline);
-    graphicsAPI->DestroyShader(fragmentShader);
-    graphicsAPI->DestroyShader(vertexShader);
-    graphicsAPI->DestroyBuffer(uniformBuffer_Vert);
-    graphicsAPI->DestroyBuffer(uniformBuffer_Frag);
-    graphicsAPI->DestroyBuffer(indexBuffer);
-    graphicsAPI->DestroyBuffer(vertexBuffer);
+    DestroyResources();
 
     FreeLibrary(RenderDoc);
 }
@@ -0,0 +1,74 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#version 310 es
+layout(local_size_x = 64) in;
+// One set of 6 inward-facing planes per view. An object survives if it intersects any view's frustum.
+layout(std140, binding = 0) uniform CullConstants {
+    vec4 planes[12];
+    uint objectCount;
+    uint viewCount;
+    uint pad1;
+    uint pad2;
+};
+struct CullObject {
+    mat4 model;
+    vec4 boundsMin;  // Object space AABB.
+    vec4 boundsMax;
+    vec4 color;
+};
+struct Instance {
+    mat4 model;
+    vec4 color;
+};
+layout(std430, binding = 1) readonly buffer Objects {
+    CullObject objects[];
+};
+layout(std430, binding = 2) writeonly buffer Instances {
+    Instance instances[];
+};
+// DrawIndexedIndirectCommand. instanceCount must be reset to 0 before the dispatch.
+layout(std430, binding = 3) buffer IndirectArgs {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+bool IsInsideFrustum(uint view, vec3 center, vec3 extents) {
+    for (uint i = 0; i < 6; i++) {
+        vec4 plane = planes[view * 6 + i];
+        float radius = dot(abs(plane.xyz), extents);
+        if (dot(plane.xyz, center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= objectCount) {
+        return;
+    }
+    CullObject object = objects[index];
+
+    // Transform the AABB into a world space AABB.
+    vec3 center = 0.5 * (object.boundsMin.xyz + object.boundsMax.xyz);
+    vec3 extents = 0.5 * (object.boundsMax.xyz - object.boundsMin.xyz);
+    mat3 absModel = mat3(abs(object.model[0].xyz), abs(object.model[1].xyz), abs(object.model[2].xyz));
+    vec3 worldCenter = (object.model * vec4(center, 1.0)).xyz;
+    vec3 worldExtents = absModel * extents;
+
+    bool visible = false;
+    for (uint view = 0; view < viewCount && !visible; view++) {
+        visible = IsInsideFrustum(view, worldCenter, worldExtents);
+    }
+    if (visible) {
+        uint slot = atomicAdd(instanceCount, 1u);
+        instances[slot].model = object.model;
+        instances[slot].color = object.color;
+    }
+}
@@ -0,0 +1,13 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#version 450
+layout(location = 0) in vec2 i_FloorPosition;
+layout(location = 0) out vec4 o_Color;
+void main() {
+    // A checkerboard of 0.5 m tiles.
+    vec2 tile = floor(i_FloorPosition * 2.0);
+    float checker = mod(tile.x + tile.y, 2.0);
+    o_Color = vec4(mix(vec3(0.3), vec3(0.5), checker), 1.0);
+}
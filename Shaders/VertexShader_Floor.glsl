@@ -0,0 +1,20 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#version 450
+#extension GL_KHR_vulkan_glsl : enable
+// The constants of the view being drawn, written by the tutorial's UpdateViewConstants() and LateLatchViews().
+layout(std140, binding = 0) uniform ViewConstants {
+    mat4 viewProj;
+    mat4 view;
+};
+layout(location = 0) out vec2 o_FloorPosition;
+// A 4 x 4 m floor quad, 1.5 m below the origin of the local space, as two triangles without a vertex buffer.
+const vec2 positions[6] = vec2[6](vec2(-2.0, -2.0), vec2(2.0, -2.0), vec2(2.0, 2.0),
+                                  vec2(-2.0, -2.0), vec2(2.0, 2.0), vec2(-2.0, 2.0));
+void main() {
+    vec2 position = positions[gl_VertexIndex];
+    o_FloorPosition = position;
+    gl_Position = viewProj * vec4(position.x, -1.5, position.y, 1.0);
+}
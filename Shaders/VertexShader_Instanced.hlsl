@@ -0,0 +1,50 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+cbuffer CameraConstants : register(b0)
+{
+    float4x4 viewProj;
+    float4x4 modelViewProj;
+    float4x4 model;
+    float4 color;
+    float4 pad1;
+    float4 pad2;
+    float4 pad3;
+};
+cbuffer Normals : register(b1)
+{
+    float4 normals[6];
+};
+
+struct VS_IN
+{
+    uint vertexId : SV_VertexId;
+    float4 a_Positions : TEXCOORD0;
+    // Per-instance data: TEXCOORD1-4 are the model matrix columns.
+    float4 a_Model0 : TEXCOORD1;
+    float4 a_Model1 : TEXCOORD2;
+    float4 a_Model2 : TEXCOORD3;
+    float4 a_Model3 : TEXCOORD4;
+    float4 a_Color : TEXCOORD5;
+};
+struct VS_OUT
+{
+    float4 o_Position : SV_Position;
+    nointerpolation float2 o_TexCoord : TEXCOORD0;
+    float3 o_Normal : TEXCOORD1;
+    nointerpolation float3 o_Color : TEXCOORD2;
+};
+
+VS_OUT main(VS_IN IN)
+{
+    VS_OUT OUT;
+    float4 worldPosition = IN.a_Model0 * IN.a_Positions.x + IN.a_Model1 * IN.a_Positions.y + IN.a_Model2 * IN.a_Positions.z + IN.a_Model3 * IN.a_Positions.w;
+    OUT.o_Position = mul(viewProj, worldPosition);
+    int face = IN.vertexId / 6;
+    OUT.o_TexCoord = float2(float(face), 0);
+    float4 normal = normals[face];
+    OUT.o_Normal = (IN.a_Model0 * normal.x + IN.a_Model1 * normal.y + IN.a_Model2 * normal.z).xyz;
+    OUT.o_Color = IN.a_Color.rgb;
+    return OUT;
+}
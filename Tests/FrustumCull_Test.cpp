@@ -0,0 +1,264 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+// Checks the draw command and instances that Shaders/ComputeShader_FrustumCull.glsl compacts for GraphicsAPI_Test's
+// DrawCuboidsIndirect(). The shader is run on the CPU, one invocation at a time in a shuffled order, as the GPU makes
+// no promise about the order of its atomicAdd()s. Its output is compared with XrMatrix4x4f_TransformBounds() and
+// XrFrustum_IsBoundsVisible() from xr_linear_algebra.h, on the scene of GraphicsAPI_Test and on random scenes.
+
+#include <GraphicsAPI.h>
+#include <xr_linear_algebra.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+// The same layouts as GraphicsAPI_Test/main.cpp and the std140 and std430 blocks of the shader.
+constexpr uint32_t maxCuboidInstances = 64;
+constexpr uint32_t maxCullViews = 2;
+constexpr uint32_t groupSize = 64;  // local_size_x in ComputeShader_FrustumCull.
+struct CuboidInstance {
+    XrMatrix4x4f model;
+    XrVector4f color;
+};
+struct CullConstants {
+    XrVector4f planes[maxCullViews * 6];
+    uint32_t objectCount;
+    uint32_t viewCount;
+    uint32_t pad1;
+    uint32_t pad2;
+};
+struct CullObject {
+    XrMatrix4x4f model;
+    XrVector4f boundsMin;
+    XrVector4f boundsMax;
+    XrVector4f color;
+};
+static_assert(sizeof(CuboidInstance) == 80, "Instance in ComputeShader_FrustumCull.glsl is 80 bytes.");
+static_assert(sizeof(CullConstants) == 208, "CullConstants in ComputeShader_FrustumCull.glsl is 208 bytes.");
+static_assert(sizeof(CullObject) == 112, "CullObject in ComputeShader_FrustumCull.glsl is 112 bytes.");
+static_assert(sizeof(GraphicsAPI::DrawIndexedIndirectCommand) == 20, "IndirectArgs in ComputeShader_FrustumCull.glsl is 20 bytes.");
+
+std::mt19937 randomEngine(20231);
+
+float RandomFloat(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(randomEngine);
+}
+
+XrQuaternionf RandomRotation() {
+    const XrQuaternionf q = {RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)};
+    const float lengthRcp = XrRcpSqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return {q.x * lengthRcp, q.y * lengthRcp, q.z * lengthRcp, q.w * lengthRcp};
+}
+
+// IsInsideFrustum() of the shader.
+bool IsInsideFrustum(const CullConstants &constants, uint32_t view, const XrVector3f &center, const XrVector3f &extents) {
+    for (uint32_t i = 0; i < 6; i++) {
+        const XrVector4f &plane = constants.planes[view * 6 + i];
+        const float radius = fabsf(plane.x) * extents.x + fabsf(plane.y) * extents.y + fabsf(plane.z) * extents.z;
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// main() of the shader for one invocation. The atomicAdd() is not atomic here, as the invocations run one at a time.
+void RunInvocation(uint32_t index, const CullConstants &constants, const CullObject *objects, CuboidInstance *instances, GraphicsAPI::DrawIndexedIndirectCommand &indirectArgs) {
+    if (index >= constants.objectCount) {
+        return;
+    }
+    const CullObject &object = objects[index];
+
+    const XrVector3f center = {0.5f * (object.boundsMin.x + object.boundsMax.x), 0.5f * (object.boundsMin.y + object.boundsMax.y), 0.5f * (object.boundsMin.z + object.boundsMax.z)};
+    const XrVector3f extents = {0.5f * (object.boundsMax.x - object.boundsMin.x), 0.5f * (object.boundsMax.y - object.boundsMin.y), 0.5f * (object.boundsMax.z - object.boundsMin.z)};
+    const float *m = object.model.m;
+    const XrVector3f worldCenter = {m[0] * center.x + m[4] * center.y + m[8] * center.z + m[12],
+                                    m[1] * center.x + m[5] * center.y + m[9] * center.z + m[13],
+                                    m[2] * center.x + m[6] * center.y + m[10] * center.z + m[14]};
+    const XrVector3f worldExtents = {fabsf(m[0]) * extents.x + fabsf(m[4]) * extents.y + fabsf(m[8]) * extents.z,
+                                     fabsf(m[1]) * extents.x + fabsf(m[5]) * extents.y + fabsf(m[9]) * extents.z,
+                                     fabsf(m[2]) * extents.x + fabsf(m[6]) * extents.y + fabsf(m[10]) * extents.z};
+
+    bool visible = false;
+    for (uint32_t view = 0; view < constants.viewCount && !visible; view++) {
+        visible = IsInsideFrustum(constants, view, worldCenter, worldExtents);
+    }
+    if (visible) {
+        const uint32_t slot = indirectArgs.instanceCount++;
+        instances[slot].model = object.model;
+        instances[slot].color = object.color;
+    }
+}
+
+// Whether a corner of the world bounds is too close to a plane for the shader and XrFrustum_IsBoundsVisible(), which
+// round differently, to be expected to agree.
+bool IsOnPlane(const XrVector4f *planes, uint32_t viewCount, const XrVector3f &mins, const XrVector3f &maxs) {
+    for (uint32_t i = 0; i < viewCount * 6; i++) {
+        const XrVector4f &plane = planes[i];
+        const float x = plane.x >= 0.0f ? maxs.x : mins.x;
+        const float y = plane.y >= 0.0f ? maxs.y : mins.y;
+        const float z = plane.z >= 0.0f ? maxs.z : mins.z;
+        if (fabsf(plane.x * x + plane.y * y + plane.z * z + plane.w) < 1e-4f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int failureCount = 0;
+
+void Check(bool passed, const char *scene, const char *what) {
+    if (!passed) {
+        std::printf("FAILED: %s: %s.\n", scene, what);
+        failureCount++;
+    }
+}
+
+// Culls the cuboids as CullCuboidsGPU() does, with the color's x holding the cuboid's index, and checks the result.
+// Returns the number of instances drawn.
+uint32_t TestCull(const char *scene, GraphicsAPI_Type apiType, const XrMatrix4x4f *viewProjs, uint32_t viewCount, const XrPosef *poses, const XrVector3f *scales, uint32_t count) {
+    CullConstants constants = {};
+    std::vector<CullObject> objects(count);
+    for (uint32_t i = 0; i < count; i++) {
+        XrMatrix4x4f_CreateTranslationRotationScale(&objects[i].model, &poses[i].position, &poses[i].orientation, &scales[i]);
+        objects[i].boundsMin = {-0.5f, -0.5f, -0.5f, 1.0f};
+        objects[i].boundsMax = {+0.5f, +0.5f, +0.5f, 1.0f};
+        objects[i].color = {float(i), 0.0f, 0.0f, 1.0f};
+    }
+    for (uint32_t i = 0; i < viewCount; i++) {
+        XrMatrix4x4f_GetFrustumPlanes(&constants.planes[i * 6], &viewProjs[i], apiType);
+    }
+    constants.objectCount = count;
+    constants.viewCount = viewCount;
+
+    // The instances past the count must be left alone, so they start out as a pattern that no cuboid writes.
+    CuboidInstance instances[maxCuboidInstances];
+    memset(instances, 0xFF, sizeof(instances));
+    GraphicsAPI::DrawIndexedIndirectCommand indirectArgs = {36, 0, 0, 0, 0};
+    const uint32_t invocationCount = (count + groupSize - 1) / groupSize * groupSize;
+    std::vector<uint32_t> invocations(invocationCount);
+    for (uint32_t i = 0; i < invocationCount; i++) {
+        invocations[i] = i;
+    }
+    std::shuffle(invocations.begin(), invocations.end(), randomEngine);
+    for (uint32_t index : invocations) {
+        RunInvocation(index, constants, objects.data(), instances, indirectArgs);
+    }
+
+    Check(indirectArgs.indexCount == 36 && indirectArgs.firstIndex == 0 && indirectArgs.vertexOffset == 0 && indirectArgs.firstInstance == 0, scene, "the dispatch changed the draw command");
+    Check(indirectArgs.instanceCount <= count, scene, "more instances than cuboids");
+    std::vector<bool> drawn(count, false);
+    for (uint32_t slot = 0; slot < std::min(indirectArgs.instanceCount, count); slot++) {
+        const float index = instances[slot].color.x;
+        const bool isCuboid = index >= 0.0f && index < float(count) && index == floorf(index);
+        Check(isCuboid, scene, "an instance is not one of the cuboids");
+        if (!isCuboid) {
+            continue;
+        }
+        const uint32_t i = uint32_t(index);
+        Check(!drawn[i], scene, "a cuboid is drawn twice");
+        Check(memcmp(&instances[slot].model, &objects[i].model, sizeof(XrMatrix4x4f)) == 0, scene, "an instance has the model matrix of a different cuboid");
+        drawn[i] = true;
+    }
+    for (uint32_t slot = indirectArgs.instanceCount; slot < maxCuboidInstances; slot++) {
+        const CuboidInstance *instance = &instances[slot];
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(instance);
+        Check(std::all_of(bytes, bytes + sizeof(CuboidInstance), [](uint8_t byte) { return byte == 0xFF; }), scene, "an instance past the instance count was written");
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const XrVector3f mins = {-0.5f, -0.5f, -0.5f};
+        const XrVector3f maxs = {+0.5f, +0.5f, +0.5f};
+        XrVector3f worldMins, worldMaxs;
+        XrMatrix4x4f_TransformBounds(&worldMins, &worldMaxs, &objects[i].model, &mins, &maxs);
+        if (IsOnPlane(constants.planes, viewCount, worldMins, worldMaxs)) {
+            continue;
+        }
+        const bool visible = XrFrustum_IsBoundsVisible(constants.planes, int(viewCount), &worldMins, &worldMaxs);
+        Check(drawn[i] == visible, scene, visible ? "a visible cuboid is not drawn" : "a culled cuboid is drawn");
+    }
+    return indirectArgs.instanceCount;
+}
+
+XrMatrix4x4f ViewProjection(GraphicsAPI_Type apiType, XrPosef viewPose) {
+    // The reversed-Z projection with an infinite far plane of GraphicsAPI_Test.
+    XrProjectionCache projCache = {};
+    const XrFovf fov = {-.5f, .5f, .5f, -.5f};
+    const XrMatrix4x4f &proj = *XrProjectionCache_Get(&projCache, apiType, fov, 0.05f, 0.0f, true);
+    const XrVector3f scale1m = {1.0f, 1.0f, 1.0f};
+    XrMatrix4x4f toView;
+    XrMatrix4x4f_CreateTranslationRotationScale(&toView, &viewPose.position, &viewPose.orientation, &scale1m);
+    XrMatrix4x4f view;
+    XrMatrix4x4f_InvertRigidBody(&view, &toView);
+    XrMatrix4x4f viewProj;
+    XrMatrix4x4f_Multiply(&viewProj, &proj, &view);
+    return viewProj;
+}
+
+// The 4x4x4 grid of UpdateTestObject() seen from its origin, from which only the half in front of the view is visible.
+void TestGraphicsAPITestScene(GraphicsAPI_Type apiType) {
+    XrPosef poses[maxCuboidInstances];
+    XrVector3f scales[maxCuboidInstances];
+    uint32_t count = 0;
+    const XrVector3f axis = {0, 0.707f, 0.707f};
+    XrQuaternionf q;
+    XrQuaternionf_CreateFromAxisAngle(&q, &axis, 0.3f);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            for (int k = 0; k < 4; k++) {
+                poses[count] = {q, {float(i) - 1.5f, float(j) - 1.5f, float(k) - 1.5f}};
+                scales[count] = {0.1f, 0.2f, 0.1f};
+                count++;
+            }
+        }
+    }
+    const XrMatrix4x4f viewProjs[maxCullViews] = {ViewProjection(apiType, {{0, 0, 0, 1}, {-0.032f, 0, 0}}), ViewProjection(apiType, {{0, 0, 0, 1}, {0.032f, 0, 0}})};
+    const uint32_t monoCount = TestCull("GraphicsAPI_Test scene, 1 view", apiType, viewProjs, 1, poses, scales, count);
+    const uint32_t stereoCount = TestCull("GraphicsAPI_Test scene, 2 views", apiType, viewProjs, 2, poses, scales, count);
+    Check(monoCount > 0 && monoCount <= count / 2, "GraphicsAPI_Test scene, 1 view", "not only a part of the cuboids in front of the view is drawn");
+    Check(stereoCount >= monoCount && stereoCount <= count / 2, "GraphicsAPI_Test scene, 2 views", "the union of the views is not drawn");
+}
+
+void TestRandomScene(GraphicsAPI_Type apiType, uint32_t viewCount, uint32_t count) {
+    XrPosef poses[maxCuboidInstances];
+    XrVector3f scales[maxCuboidInstances];
+    for (uint32_t i = 0; i < count; i++) {
+        poses[i] = {RandomRotation(), {RandomFloat(-8.0f, 8.0f), RandomFloat(-8.0f, 8.0f), RandomFloat(-8.0f, 8.0f)}};
+        scales[i] = {RandomFloat(0.05f, 2.0f), RandomFloat(0.05f, 2.0f), RandomFloat(0.05f, 2.0f)};
+    }
+    XrMatrix4x4f viewProjs[maxCullViews];
+    for (uint32_t i = 0; i < viewCount; i++) {
+        viewProjs[i] = ViewProjection(apiType, {RandomRotation(), {RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)}});
+    }
+    TestCull("Random scene", apiType, viewProjs, viewCount, poses, scales, count);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    for (GraphicsAPI_Type apiType : {VULKAN, OPENGL}) {
+        TestGraphicsAPITestScene(apiType);
+        for (uint32_t viewCount = 1; viewCount <= maxCullViews; viewCount++) {
+            for (uint32_t count : {0u, 1u, 7u, 63u, maxCuboidInstances}) {
+                for (int repeat = 0; repeat < 100; repeat++) {
+                    TestRandomScene(apiType, viewCount, count);
+                }
+            }
+        }
+    }
+
+    if (failureCount > 0) {
+        std::printf("%d checks failed.\n", failureCount);
+        return EXIT_FAILURE;
+    }
+    std::printf("All checks passed.\n");
+    return EXIT_SUCCESS;
+}
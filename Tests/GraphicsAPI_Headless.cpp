@@ -0,0 +1,165 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+// Definitions of GraphicsAPI_Vulkan that need no Vulkan instance or GPU, so that the tutorial's frame pipeline can
+// run against MockRuntime.cpp. Resources are opaque handles, except buffers, which are host memory so that the
+// tutorial's mapped uniform buffer writes still land somewhere. Nothing is rendered.
+//
+// XR_MOCK_GPU_BOUND_SUBMISSION selects a BeginRendering()/EndRendering() submission, counted from 1, that keeps the
+// emulated GPU busy for 40 ms. As in GraphicsAPI_Vulkan, the next BeginRendering() waits for it and then reports its
+// GPU time; every other submission reports no GPU time.
+//
+// Draws are only counted, along with how many of them had a uniform buffer bound, and the counts are printed when the
+// GraphicsAPI is destroyed.
+
+#include <GraphicsAPI_Vulkan.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace {
+uintptr_t nextHandle = 0x1000;
+
+const char *gpuBoundSubmissionValue = std::getenv("XR_MOCK_GPU_BOUND_SUBMISSION");
+const int gpuBoundSubmission = gpuBoundSubmissionValue ? std::atoi(gpuBoundSubmissionValue) : 0;
+const std::chrono::milliseconds gpuBoundTime(40);
+int submissionCount = 0;
+uint64_t drawCount = 0;
+uint64_t drawWithBufferCount = 0;
+bool bufferDescriptorSet = false;
+
+void *NewHandle() {
+    return reinterpret_cast<void *>(nextHandle++);
+}
+}  // namespace
+
+GraphicsAPI_Vulkan::GraphicsAPI_Vulkan() {
+}
+
+GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId systemId) {
+    // There is no VkInstance or VkDevice, so the graphics binding passed to xrCreateSession() holds null handles;
+    // MockRuntime.cpp does not read them.
+    queueFamilyIndex = 0;
+    queueIndex = 0;
+}
+
+GraphicsAPI_Vulkan::~GraphicsAPI_Vulkan() {
+    std::cout << "GraphicsAPI_Headless: " << drawCount << " draws, " << drawWithBufferCount << " with a uniform buffer." << std::endl;
+}
+
+void *GraphicsAPI_Vulkan::CreateDesktopSwapchain(const SwapchainCreateInfo &swapchainCI) { return nullptr; }
+void GraphicsAPI_Vulkan::DestroyDesktopSwapchain(void *&swapchain) { swapchain = nullptr; }
+void *GraphicsAPI_Vulkan::GetDesktopSwapchainImage(void *swapchain, uint32_t index) { return nullptr; }
+void GraphicsAPI_Vulkan::AcquireDesktopSwapchanImage(void *swapchain, uint32_t &index) { index = 0; }
+void GraphicsAPI_Vulkan::PresentDesktopSwapchainImage(void *swapchain, uint32_t index) {}
+
+void *GraphicsAPI_Vulkan::GetGraphicsBinding() {
+    graphicsBinding = {XR_TYPE_GRAPHICS_BINDING_VULKAN_KHR};
+    graphicsBinding.queueFamilyIndex = queueFamilyIndex;
+    graphicsBinding.queueIndex = queueIndex;
+    return &graphicsBinding;
+}
+
+bool GraphicsAPI_Vulkan::RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) {
+    return true;
+}
+
+XrSwapchainImageBaseHeader *GraphicsAPI_Vulkan::AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) {
+    swapchainImagesMap[swapchain].first = type;
+    swapchainImagesMap[swapchain].second.resize(count, {XR_TYPE_SWAPCHAIN_IMAGE_VULKAN_KHR});
+    for (XrSwapchainImageVulkanKHR &swapchainImage : swapchainImagesMap[swapchain].second) {
+        swapchainImage.image = (VkImage)NewHandle();
+    }
+    return reinterpret_cast<XrSwapchainImageBaseHeader *>(swapchainImagesMap[swapchain].second.data());
+}
+
+void GraphicsAPI_Vulkan::FreeSwapchainImageData(XrSwapchain swapchain) {
+    for (XrSwapchainImageVulkanKHR &swapchainImage : swapchainImagesMap[swapchain].second) {
+        imageStates.erase(swapchainImage.image);
+    }
+    swapchainImagesMap.erase(swapchain);
+}
+
+void *GraphicsAPI_Vulkan::CreateImage(const ImageCreateInfo &imageCI) { return NewHandle(); }
+void GraphicsAPI_Vulkan::DestroyImage(void *&image) { image = nullptr; }
+
+void *GraphicsAPI_Vulkan::CreateImageView(const ImageViewCreateInfo &imageViewCI) { return NewHandle(); }
+void GraphicsAPI_Vulkan::DestroyImageView(void *&imageView) { imageView = nullptr; }
+
+void *GraphicsAPI_Vulkan::CreateSampler(const SamplerCreateInfo &samplerCI) { return NewHandle(); }
+void GraphicsAPI_Vulkan::DestroySampler(void *&sampler) { sampler = nullptr; }
+
+void *GraphicsAPI_Vulkan::CreateBuffer(const BufferCreateInfo &bufferCI) {
+    void *buffer = calloc(1, bufferCI.size);
+    if (buffer && bufferCI.data) {
+        memcpy(buffer, bufferCI.data, bufferCI.size);
+    }
+    return buffer;
+}
+void GraphicsAPI_Vulkan::DestroyBuffer(void *&buffer) {
+    free(buffer);
+    buffer = nullptr;
+}
+void *GraphicsAPI_Vulkan::GetBufferMappedData(void *buffer) { return buffer; }
+
+void *GraphicsAPI_Vulkan::CreateShader(const ShaderCreateInfo &shaderCI) { return NewHandle(); }
+void GraphicsAPI_Vulkan::DestroyShader(void *&shader) { shader = nullptr; }
+
+void *GraphicsAPI_Vulkan::CreatePipeline(const PipelineCreateInfo &pipelineCI) { return NewHandle(); }
+void *GraphicsAPI_Vulkan::CreateComputePipeline(const ComputePipelineCreateInfo &pipelineCI) { return NewHandle(); }
+void GraphicsAPI_Vulkan::DestroyPipeline(void *&pipeline) { pipeline = nullptr; }
+
+void GraphicsAPI_Vulkan::BeginRendering() {
+    lastRenderingGpuTime = 0;
+    if (submissionCount > 0 && submissionCount == gpuBoundSubmission) {
+        std::this_thread::sleep_for(gpuBoundTime);
+        lastRenderingGpuTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(gpuBoundTime).count());
+    }
+}
+void GraphicsAPI_Vulkan::EndRendering() {
+    submissionCount++;
+}
+
+void GraphicsAPI_Vulkan::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
+    if (buffer && data) {
+        memcpy(static_cast<char *>(buffer) + offset, data, size);
+    }
+}
+
+void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b, float a) {}
+void GraphicsAPI_Vulkan::ClearDepth(void *imageView, float d) {}
+
+void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {}
+void GraphicsAPI_Vulkan::SetViewports(Viewport *viewports, size_t count) {}
+void GraphicsAPI_Vulkan::SetScissors(Rect2D *scissors, size_t count) {}
+
+void GraphicsAPI_Vulkan::SetPipeline(void *pipeline) {}
+void GraphicsAPI_Vulkan::SetDescriptor(const DescriptorInfo &descriptorInfo) {
+    bufferDescriptorSet |= descriptorInfo.type == DescriptorInfo::Type::BUFFER && descriptorInfo.resource != nullptr;
+}
+void GraphicsAPI_Vulkan::UpdateDescriptors() {}
+void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {}
+void GraphicsAPI_Vulkan::SetIndexBuffer(void *indexBuffer) {}
+void GraphicsAPI_Vulkan::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {}
+void GraphicsAPI_Vulkan::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    drawCount++;
+    drawWithBufferCount += bufferDescriptorSet ? 1 : 0;
+    bufferDescriptorSet = false;
+}
+void GraphicsAPI_Vulkan::DrawIndexedIndirect(void *buffer, size_t offset, uint32_t drawCount, uint32_t stride) {}
+
+void GraphicsAPI_Vulkan::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {}
+void GraphicsAPI_Vulkan::DispatchIndirect(void *buffer, size_t offset) {}
+
+const std::vector<int64_t> GraphicsAPI_Vulkan::GetSupportedColorSwapchainFormats() {
+    return {VK_FORMAT_R8G8B8A8_SRGB};
+}
+
+const std::vector<int64_t> GraphicsAPI_Vulkan::GetSupportedDepthSwapchainFormats() {
+    return {VK_FORMAT_D32_SFLOAT};
+}
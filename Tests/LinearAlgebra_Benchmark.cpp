@@ -0,0 +1,244 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+// Times the *Fast functions in xr_linear_algebra.h against the default functions they stand in for, and
+// XrQuaternionf_Slerp against both quaternion lerps, over the same random inputs. Only the *Fast functions measured
+// faster here are switched in by XR_LINEAR_FAST_MATH. The timings are only printed; the process fails if a *Fast
+// function is less accurate than its documentation allows.
+
+#include <GraphicsAPI.h>
+#include <xr_linear_algebra.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#if defined(XR_LINEAR_FAST_MATH)
+#error "The reference functions would call the *Fast functions: build the benchmark without XR_LINEAR_FAST_MATH."
+#endif
+
+namespace {
+const size_t InputCount = 1024;
+const int RepeatCount = 2000;
+
+std::mt19937 randomEngine(20231);
+
+float RandomFloat(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(randomEngine);
+}
+
+XrQuaternionf RandomRotation() {
+    const XrQuaternionf q = {RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)};
+    const float lengthRcp = XrRcpSqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return {q.x * lengthRcp, q.y * lengthRcp, q.z * lengthRcp, q.w * lengthRcp};
+}
+
+// A rotation, scale and translation, so that the matrix is well conditioned for XrMatrix4x4f_Invert.
+XrMatrix4x4f RandomTransform() {
+    const XrVector3f translation = {RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f)};
+    const XrQuaternionf rotation = RandomRotation();
+    const XrVector3f scale = {RandomFloat(0.5f, 2.0f), RandomFloat(0.5f, 2.0f), RandomFloat(0.5f, 2.0f)};
+    XrMatrix4x4f m;
+    XrMatrix4x4f_CreateTranslationRotationScale(&m, &translation, &rotation, &scale);
+    return m;
+}
+
+struct Inputs {
+    std::vector<float> scalars;
+    std::vector<XrQuaternionf> quaternionsA;
+    std::vector<XrQuaternionf> quaternionsB;
+    std::vector<float> fractions;
+    std::vector<XrMatrix4x4f> matricesA;
+    std::vector<XrMatrix4x4f> matricesB;
+};
+
+// Calls 'function' on every input index RepeatCount times and returns the average time of one call in nanoseconds.
+// The functions add their results into 'sink', so that the calls can not be optimized away.
+template <typename Function>
+double TimeCalls(Function function) {
+    volatile float sink = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (int repeat = 0; repeat < RepeatCount; repeat++) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < InputCount; i++) {
+            sum += function(i);
+        }
+        sink = sink + sum;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    return nanoseconds / (double(RepeatCount) * double(InputCount));
+}
+
+void PrintTiming(const char *function, double nanoseconds, double referenceNanoseconds) {
+    std::printf("  %-34s %8.2f ns", function, nanoseconds);
+    if (referenceNanoseconds > 0.0) {
+        std::printf("  (%.2fx)", referenceNanoseconds / nanoseconds);
+    }
+    std::printf("\n");
+}
+
+int failureCount = 0;
+
+void CheckError(const char *function, double maxError, double allowedError) {
+    std::printf("  %-34s max error %.3g\n", function, maxError);
+    if (!(maxError <= allowedError)) {
+        std::printf("FAILED: %s: the max error %.3g is more than %.3g.\n", function, maxError, allowedError);
+        failureCount++;
+    }
+}
+
+void BenchmarkRcpSqrt(const Inputs &inputs) {
+    const std::vector<float> &x = inputs.scalars;
+    const double reference = TimeCalls([&](size_t i) { return XrRcpSqrt(x[i]); });
+    const double fast = TimeCalls([&](size_t i) { return XrRcpSqrtFast(x[i]); });
+    PrintTiming("XrRcpSqrt", reference, 0.0);
+    PrintTiming("XrRcpSqrtFast", fast, reference);
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < InputCount; i++) {
+        const double expected = XrRcpSqrt(x[i]);
+        maxError = std::fmax(maxError, std::fabs(XrRcpSqrtFast(x[i]) - expected) / expected);
+    }
+    // One Newton-Raphson step gives about 23 bits.
+    CheckError("XrRcpSqrtFast (relative)", maxError, 1.0e-6);
+}
+
+void BenchmarkQuaternionLerp(const Inputs &inputs) {
+    const std::vector<XrQuaternionf> &a = inputs.quaternionsA;
+    const std::vector<XrQuaternionf> &b = inputs.quaternionsB;
+    const std::vector<float> &t = inputs.fractions;
+    const double reference = TimeCalls([&](size_t i) {
+        XrQuaternionf q;
+        XrQuaternionf_Lerp(&q, &a[i], &b[i], t[i]);
+        return q.x + q.w;
+    });
+    const double fast = TimeCalls([&](size_t i) {
+        XrQuaternionf q;
+        XrQuaternionf_LerpFast(&q, &a[i], &b[i], t[i]);
+        return q.x + q.w;
+    });
+    const double slerp = TimeCalls([&](size_t i) {
+        XrQuaternionf q;
+        XrQuaternionf_Slerp(&q, &a[i], &b[i], t[i]);
+        return q.x + q.w;
+    });
+    PrintTiming("XrQuaternionf_Lerp", reference, 0.0);
+    PrintTiming("XrQuaternionf_LerpFast", fast, reference);
+    PrintTiming("XrQuaternionf_Slerp", slerp, reference);
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < InputCount; i++) {
+        XrQuaternionf expected, q;
+        XrQuaternionf_Lerp(&expected, &a[i], &b[i], t[i]);
+        XrQuaternionf_LerpFast(&q, &a[i], &b[i], t[i]);
+        maxError = std::fmax(maxError, std::fabs(q.x - expected.x));
+        maxError = std::fmax(maxError, std::fabs(q.y - expected.y));
+        maxError = std::fmax(maxError, std::fabs(q.z - expected.z));
+        maxError = std::fmax(maxError, std::fabs(q.w - expected.w));
+    }
+    CheckError("XrQuaternionf_LerpFast", maxError, 1.0e-6);
+}
+
+void BenchmarkMatrixMultiply(const Inputs &inputs) {
+    const std::vector<XrMatrix4x4f> &a = inputs.matricesA;
+    const std::vector<XrMatrix4x4f> &b = inputs.matricesB;
+    const double reference = TimeCalls([&](size_t i) {
+        XrMatrix4x4f m;
+        XrMatrix4x4f_Multiply(&m, &a[i], &b[i]);
+        return m.m[0] + m.m[15];
+    });
+    const double fast = TimeCalls([&](size_t i) {
+        XrMatrix4x4f m;
+        XrMatrix4x4f_MultiplyFast(&m, &a[i], &b[i]);
+        return m.m[0] + m.m[15];
+    });
+    PrintTiming("XrMatrix4x4f_Multiply", reference, 0.0);
+    PrintTiming("XrMatrix4x4f_MultiplyFast", fast, reference);
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < InputCount; i++) {
+        XrMatrix4x4f expected, m;
+        XrMatrix4x4f_Multiply(&expected, &a[i], &b[i]);
+        XrMatrix4x4f_MultiplyFast(&m, &a[i], &b[i]);
+        for (int j = 0; j < 16; j++) {
+            maxError = std::fmax(maxError, std::fabs(m.m[j] - expected.m[j]));
+        }
+    }
+    // Documented to give the same results.
+    CheckError("XrMatrix4x4f_MultiplyFast", maxError, 0.0);
+}
+
+void BenchmarkMatrixInvert(const Inputs &inputs) {
+    const std::vector<XrMatrix4x4f> &a = inputs.matricesA;
+    const double reference = TimeCalls([&](size_t i) {
+        XrMatrix4x4f m;
+        XrMatrix4x4f_Invert(&m, &a[i]);
+        return m.m[0] + m.m[15];
+    });
+    const double fast = TimeCalls([&](size_t i) {
+        XrMatrix4x4f m;
+        XrMatrix4x4f_InvertFast(&m, &a[i]);
+        return m.m[0] + m.m[15];
+    });
+    PrintTiming("XrMatrix4x4f_Invert", reference, 0.0);
+    PrintTiming("XrMatrix4x4f_InvertFast", fast, reference);
+
+    // The two inversions round differently, so both are measured by how far the product with the source is from
+    // the identity.
+    double maxError = 0.0;
+    double maxReferenceError = 0.0;
+    for (size_t i = 0; i < InputCount; i++) {
+        XrMatrix4x4f expected, m, identity, referenceIdentity;
+        XrMatrix4x4f_Invert(&expected, &a[i]);
+        XrMatrix4x4f_InvertFast(&m, &a[i]);
+        XrMatrix4x4f_Multiply(&referenceIdentity, &a[i], &expected);
+        XrMatrix4x4f_Multiply(&identity, &a[i], &m);
+        for (int j = 0; j < 16; j++) {
+            const float one = (j % 5 == 0) ? 1.0f : 0.0f;
+            maxReferenceError = std::fmax(maxReferenceError, std::fabs(referenceIdentity.m[j] - one));
+            maxError = std::fmax(maxError, std::fabs(identity.m[j] - one));
+        }
+    }
+    std::printf("  %-34s max error %.3g\n", "XrMatrix4x4f_Invert (A * inv(A))", maxReferenceError);
+    CheckError("XrMatrix4x4f_InvertFast (A * inv(A))", maxError, std::fmax(1.0e-4, 4.0 * maxReferenceError));
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    Inputs inputs;
+    for (size_t i = 0; i < InputCount; i++) {
+        inputs.scalars.push_back(RandomFloat(1.0e-3f, 1.0e3f));
+        inputs.quaternionsA.push_back(RandomRotation());
+        inputs.quaternionsB.push_back(RandomRotation());
+        inputs.fractions.push_back(RandomFloat(0.0f, 1.0f));
+        inputs.matricesA.push_back(RandomTransform());
+        inputs.matricesB.push_back(RandomTransform());
+    }
+
+#if defined(XR_LINEAR_SIMD_AVX2)
+    std::printf("Average time per call, AVX2 build:\n");
+#elif defined(XR_LINEAR_SIMD_SSE)
+    std::printf("Average time per call, SSE2 build:\n");
+#elif defined(XR_LINEAR_SIMD_NEON)
+    std::printf("Average time per call, NEON build:\n");
+#else
+    std::printf("Average time per call, scalar build:\n");
+#endif
+    BenchmarkRcpSqrt(inputs);
+    BenchmarkQuaternionLerp(inputs);
+    BenchmarkMatrixMultiply(inputs);
+    BenchmarkMatrixInvert(inputs);
+
+    if (failureCount > 0) {
+        std::printf("%d checks failed.\n", failureCount);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+// Checks that the batch functions in xr_linear_algebra.h give bit-exact results against the single element functions
+// called in a loop, as documented, up to the sign of zero. The counts cover the SIMD loops and their scalar tails.
+
+#include <GraphicsAPI.h>
+#include <xr_linear_algebra.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+std::mt19937 randomEngine(20231);
+
+float RandomFloat(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(randomEngine);
+}
+
+XrVector3f RandomVector3f(float min, float max) {
+    return {RandomFloat(min, max), RandomFloat(min, max), RandomFloat(min, max)};
+}
+
+XrQuaternionf RandomRotation() {
+    const XrQuaternionf q = {RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)};
+    const float lengthRcp = XrRcpSqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return {q.x * lengthRcp, q.y * lengthRcp, q.z * lengthRcp, q.w * lengthRcp};
+}
+
+XrMatrix4x4f RandomMatrix() {
+    XrMatrix4x4f m;
+    for (float &element : m.m) {
+        element = RandomFloat(-4.0f, 4.0f);
+    }
+    return m;
+}
+
+// The SIMD and scalar code can differ in the sign of a zero result, which compares equal.
+bool SameFloat(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) == 0 || (a == 0.0f && b == 0.0f);
+}
+
+bool SameFloats(const float *a, const float *b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!SameFloat(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int failureCount = 0;
+
+void Check(bool passed, const char *function, size_t count, size_t index) {
+    if (!passed) {
+        std::printf("FAILED: %s, count %zu: element %zu differs from the single element function.\n", function, count, index);
+        failureCount++;
+    }
+}
+
+void TestMultiplyBatch(size_t count) {
+    const XrMatrix4x4f a = RandomMatrix();
+    std::vector<XrMatrix4x4f> b(count);
+    for (XrMatrix4x4f &m : b) {
+        m = RandomMatrix();
+    }
+    std::vector<XrMatrix4x4f> results(count);
+    XrMatrix4x4f_MultiplyBatch(results.data(), &a, b.data(), count);
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f expected;
+        XrMatrix4x4f_Multiply(&expected, &a, &b[i]);
+        Check(SameFloats(results[i].m, expected.m, 16), "XrMatrix4x4f_MultiplyBatch", count, i);
+    }
+
+    // 'results' may alias 'b'.
+    XrMatrix4x4f_MultiplyBatch(b.data(), &a, b.data(), count);
+    for (size_t i = 0; i < count; i++) {
+        Check(SameFloats(b[i].m, results[i].m, 16), "XrMatrix4x4f_MultiplyBatch in place", count, i);
+    }
+}
+
+void TestCreateTranslationRotationScaleBatch(size_t count) {
+    std::vector<XrVector3f> translations(count);
+    std::vector<XrQuaternionf> rotations(count);
+    std::vector<XrVector3f> scales(count);
+    for (size_t i = 0; i < count; i++) {
+        translations[i] = RandomVector3f(-10.0f, 10.0f);
+        rotations[i] = RandomRotation();
+        scales[i] = RandomVector3f(0.1f, 3.0f);
+    }
+    std::vector<XrMatrix4x4f> results(count);
+    XrMatrix4x4f_CreateTranslationRotationScaleBatch(results.data(), translations.data(), rotations.data(), scales.data(), count);
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f expected;
+        XrMatrix4x4f_CreateTranslationRotationScale(&expected, &translations[i], &rotations[i], &scales[i]);
+        Check(SameFloats(results[i].m, expected.m, 16), "XrMatrix4x4f_CreateTranslationRotationScaleBatch", count, i);
+    }
+}
+
+void TestTransformVector3fBatch(size_t count) {
+    // A perspective projection, so that the divide by w is exercised.
+    XrMatrix4x4f projection;
+    XrMatrix4x4f_CreateProjection(&projection, VULKAN, -1.0f, 1.0f, 1.0f, -1.0f, 0.05f, 100.0f);
+    XrMatrix4x4f view = RandomMatrix();
+    XrMatrix4x4f m;
+    XrMatrix4x4f_Multiply(&m, &projection, &view);
+
+    std::vector<XrVector3f> v(count);
+    for (XrVector3f &point : v) {
+        point = RandomVector3f(-20.0f, 20.0f);
+    }
+    std::vector<XrVector3f> results(count);
+    XrMatrix4x4f_TransformVector3fBatch(results.data(), &m, v.data(), count);
+    for (size_t i = 0; i < count; i++) {
+        XrVector3f expected;
+        XrMatrix4x4f_TransformVector3f(&expected, &m, &v[i]);
+        Check(SameFloats(&results[i].x, &expected.x, 3), "XrMatrix4x4f_TransformVector3fBatch", count, i);
+    }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+#if defined(XR_LINEAR_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    // Skipped, with CTest's SKIP_RETURN_CODE, rather than failed with an illegal instruction.
+    if (!__builtin_cpu_supports("avx2")) {
+        std::printf("The CPU does not support AVX2.\n");
+        return 77;
+    }
+#endif
+#if defined(XR_LINEAR_SIMD_AVX2)
+    std::printf("Testing the AVX2 batch functions.\n");
+#elif defined(XR_LINEAR_SIMD_SSE)
+    std::printf("Testing the SSE2 batch functions.\n");
+#elif defined(XR_LINEAR_SIMD_NEON)
+    std::printf("Testing the NEON batch functions.\n");
+#else
+    std::printf("Testing the scalar batch functions.\n");
+#endif
+
+    for (size_t count = 0; count <= 19; count++) {
+        TestMultiplyBatch(count);
+        TestCreateTranslationRotationScaleBatch(count);
+        TestTransformVector3fBatch(count);
+    }
+    TestMultiplyBatch(1000);
+    TestCreateTranslationRotationScaleBatch(1000);
+    TestTransformVector3fBatch(1000);
+
+    if (failureCount > 0) {
+        std::printf("%d checks failed.\n", failureCount);
+        return EXIT_FAILURE;
+    }
+    std::printf("All checks passed.\n");
+    return EXIT_SUCCESS;
+}
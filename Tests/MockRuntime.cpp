@@ -0,0 +1,703 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+// An in-process OpenXR runtime that the tutorial links against instead of openxr_loader. It runs one session at a
+// time through its state changes, paces xrWaitFrame() at 90 Hz and checks the order of the frame calls made by the
+// tutorial's frame pipeline. When the process exits, it prints a report and fails the process if any check failed.
+//
+// The scenario is selected with environment variables:
+//  XR_MOCK_FRAMES                    Frames per session before the session ends. Default: 120.
+//  XR_MOCK_SESSION_LOSS_PENDING      Number of sessions that end with XR_SESSION_STATE_LOSS_PENDING.
+//  XR_MOCK_WAIT_FRAME_SESSION_LOST   Number of sessions in which xrWaitFrame() returns XR_ERROR_SESSION_LOST half way.
+//  XR_MOCK_SYNC_ACTIONS_SESSION_LOST Number of sessions in which xrSyncActions() returns XR_ERROR_SESSION_LOST half way.
+//  XR_MOCK_INSTANCE_LOSS             Number of sessions that end with XrEventDataInstanceLossPending.
+//  XR_MOCK_DEBUG_MESSAGES            Frames in each session that raise two debug utils messages which share a messageId.
+//  XR_MOCK_FORM_FACTOR_UNAVAILABLE   Number of xrGetSystem() calls, from the first, that return XR_ERROR_FORM_FACTOR_UNAVAILABLE.
+//  XR_MOCK_SWAPCHAIN_WAIT_TIMEOUTS   Number of xrWaitSwapchainImage() calls, from half way through the first session, that
+//                                    return XR_TIMEOUT_EXPIRED.
+// The last session always ends with XR_SESSION_STATE_STOPPING, after which the tutorial exits.
+
+#include <openxr/openxr.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+int GetEnvInt(const char *name, int defaultValue) {
+    const char *value = std::getenv(name);
+    return value ? std::atoi(value) : defaultValue;
+}
+
+struct MockRuntime {
+    std::mutex mutex;
+
+    // Scenario
+    const int framesPerSession = GetEnvInt("XR_MOCK_FRAMES", 120);
+    int sessionLossPendingCount = GetEnvInt("XR_MOCK_SESSION_LOSS_PENDING", 0);
+    int waitFrameSessionLostCount = GetEnvInt("XR_MOCK_WAIT_FRAME_SESSION_LOST", 0);
+    int syncActionsSessionLostCount = GetEnvInt("XR_MOCK_SYNC_ACTIONS_SESSION_LOST", 0);
+    int instanceLossCount = GetEnvInt("XR_MOCK_INSTANCE_LOSS", 0);
+    const int debugMessageFrames = GetEnvInt("XR_MOCK_DEBUG_MESSAGES", 0);
+    int formFactorUnavailableCount = GetEnvInt("XR_MOCK_FORM_FACTOR_UNAVAILABLE", 0);
+    int swapchainWaitTimeoutCount = GetEnvInt("XR_MOCK_SWAPCHAIN_WAIT_TIMEOUTS", 0);
+    const int expectedSessions = 1 + sessionLossPendingCount + waitFrameSessionLostCount + syncActionsSessionLostCount + instanceLossCount;
+    // The tutorial destroys the XrInstance and creates a new one after each XR_ERROR_FORM_FACTOR_UNAVAILABLE.
+    const int expectedInstances = 1 + instanceLossCount + formFactorUnavailableCount;
+
+    // Instance and session
+    XrInstance instance = XR_NULL_HANDLE;
+    XrSession session = XR_NULL_HANDLE;
+    uintptr_t nextHandle = 0x100;
+    std::map<std::string, XrPath> paths;
+    bool actionSetsAttached = false;
+    std::deque<XrEventDataBuffer> events;
+    bool sessionRunning = false;
+    bool sessionLost = false;
+    bool sessionEnding = false;
+    bool sessionStopping = false;
+    bool exitReached = false;
+
+    // Frames
+    std::chrono::steady_clock::time_point nextFrameTime;
+    int sessionFramesWaited = 0;
+    int framesWaitPending = 0;
+    bool frameBegun = false;
+
+    // Swapchains: the images acquired, and of those the images waited on, which are released in that order.
+    struct SwapchainState {
+        uint32_t acquiredCount = 0;
+        uint32_t waitedCount = 0;
+    };
+    std::map<XrSwapchain, SwapchainState> swapchains;
+    static const uint32_t swapchainImageCount = 3;
+
+    // Report
+    int instancesCreated = 0;
+    int sessionsCreated = 0;
+    int framesWaited = 0;
+    int framesBegun = 0;
+    int framesEnded = 0;
+    int errors = 0;
+
+    // Debug utils
+    PFN_xrDebugUtilsMessengerCallbackEXT debugCallback = nullptr;
+    void *debugUserData = nullptr;
+
+    ~MockRuntime() {
+        if (!exitReached) {
+            Error("the last session never reached XR_SESSION_STATE_EXITING");
+        }
+        if (sessionsCreated != expectedSessions) {
+            Error("sessions created did not match the scenario");
+        }
+        if (instancesCreated != expectedInstances) {
+            Error("instances created did not match the scenario");
+        }
+        std::fprintf(stderr, "MockRuntime: instances=%d/%d sessions=%d/%d frames waited=%d begun=%d ended=%d errors=%d\n",
+                     instancesCreated, expectedInstances, sessionsCreated, expectedSessions, framesWaited, framesBegun, framesEnded, errors);
+        if (errors > 0) {
+            std::fflush(stderr);
+            std::_Exit(EXIT_FAILURE);
+        }
+    }
+
+    void Error(const char *message) {
+        std::fprintf(stderr, "MockRuntime: ERROR: %s\n", message);
+        errors++;
+    }
+
+    template <typename T>
+    T NewHandle() {
+        return reinterpret_cast<T>(nextHandle++);
+    }
+
+    void PushEvent(const XrEventDataBaseHeader &event, size_t size) {
+        XrEventDataBuffer buffer{XR_TYPE_EVENT_DATA_BUFFER};
+        std::memcpy(&buffer, &event, size);
+        events.push_back(buffer);
+    }
+
+    void PushSessionState(XrSessionState state) {
+        XrEventDataSessionStateChanged sessionStateChanged{XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED};
+        sessionStateChanged.session = session;
+        sessionStateChanged.state = state;
+        PushEvent(reinterpret_cast<const XrEventDataBaseHeader &>(sessionStateChanged), sizeof(sessionStateChanged));
+    }
+
+    // Ends the current session in the way selected by the scenario.
+    void EndSessionForScenario() {
+        sessionEnding = true;
+        if (instanceLossCount > 0) {
+            instanceLossCount--;
+            XrEventDataInstanceLossPending instanceLossPending{XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING};
+            instanceLossPending.lossTime = 0;
+            PushEvent(reinterpret_cast<const XrEventDataBaseHeader &>(instanceLossPending), sizeof(instanceLossPending));
+            PushSessionState(XR_SESSION_STATE_LOSS_PENDING);
+        } else if (sessionLossPendingCount > 0) {
+            sessionLossPendingCount--;
+            PushSessionState(XR_SESSION_STATE_LOSS_PENDING);
+        } else {
+            sessionStopping = true;
+            PushSessionState(XR_SESSION_STATE_STOPPING);
+        }
+    }
+};
+
+MockRuntime runtime;
+
+void SendDebugMessage(const char *messageId, const char *functionName, const char *message) {
+    PFN_xrDebugUtilsMessengerCallbackEXT debugCallback = nullptr;
+    void *debugUserData = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(runtime.mutex);
+        debugCallback = runtime.debugCallback;
+        debugUserData = runtime.debugUserData;
+    }
+    if (debugCallback) {
+        XrDebugUtilsMessengerCallbackDataEXT callbackData{XR_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT};
+        callbackData.messageId = messageId;
+        callbackData.functionName = functionName;
+        callbackData.message = message;
+        debugCallback(XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT, &callbackData, debugUserData);
+    }
+}
+
+XrResult CheckSession(XrSession session) {
+    if (session == XR_NULL_HANDLE || session != runtime.session) {
+        runtime.Error("call with an invalid XrSession");
+        return XR_ERROR_HANDLE_INVALID;
+    }
+    return runtime.sessionLost ? XR_ERROR_SESSION_LOST : XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL CreateDebugUtilsMessengerEXT(XrInstance instance, const XrDebugUtilsMessengerCreateInfoEXT *createInfo, XrDebugUtilsMessengerEXT *messenger) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    runtime.debugCallback = createInfo->userCallback;
+    runtime.debugUserData = createInfo->userData;
+    *messenger = runtime.NewHandle<XrDebugUtilsMessengerEXT>();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL DestroyDebugUtilsMessengerEXT(XrDebugUtilsMessengerEXT messenger) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    runtime.debugCallback = nullptr;
+    runtime.debugUserData = nullptr;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL LocateSpacesKHR(XrSession session, const XrSpacesLocateInfoKHR *locateInfo, XrSpaceLocationsKHR *spaceLocations) {
+    for (uint32_t i = 0; i < locateInfo->spaceCount && i < spaceLocations->locationCount; i++) {
+        spaceLocations->locations[i].locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+        spaceLocations->locations[i].pose = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, -0.5f}};
+    }
+    return XR_SUCCESS;
+}
+}  // namespace
+
+// Instance
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEnumerateApiLayerProperties(uint32_t propertyCapacityInput, uint32_t *propertyCountOutput, XrApiLayerProperties *properties) {
+    *propertyCountOutput = 0;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEnumerateInstanceExtensionProperties(const char *layerName, uint32_t propertyCapacityInput, uint32_t *propertyCountOutput, XrExtensionProperties *properties) {
+    static const char *extensionNames[] = {
+        "XR_EXT_debug_utils",
+        "XR_KHR_vulkan_enable",
+        "XR_KHR_composition_layer_depth",
+        "XR_KHR_locate_spaces",
+    };
+    const uint32_t extensionCount = static_cast<uint32_t>(sizeof(extensionNames) / sizeof(extensionNames[0]));
+    *propertyCountOutput = extensionCount;
+    if (propertyCapacityInput == 0) {
+        return XR_SUCCESS;
+    }
+    if (propertyCapacityInput < extensionCount) {
+        return XR_ERROR_SIZE_INSUFFICIENT;
+    }
+    for (uint32_t i = 0; i < extensionCount; i++) {
+        std::strncpy(properties[i].extensionName, extensionNames[i], XR_MAX_EXTENSION_NAME_SIZE);
+        properties[i].extensionVersion = 1;
+    }
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateInstance(const XrInstanceCreateInfo *createInfo, XrInstance *instance) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (runtime.instance != XR_NULL_HANDLE) {
+        runtime.Error("xrCreateInstance() called while an XrInstance exists");
+    }
+    runtime.instance = runtime.NewHandle<XrInstance>();
+    runtime.instancesCreated++;
+    *instance = runtime.instance;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrDestroyInstance(XrInstance instance) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (runtime.session != XR_NULL_HANDLE) {
+        runtime.Error("xrDestroyInstance() called while an XrSession exists");
+    }
+    runtime.instance = XR_NULL_HANDLE;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetInstanceProperties(XrInstance instance, XrInstanceProperties *instanceProperties) {
+    std::strncpy(instanceProperties->runtimeName, "MockRuntime", XR_MAX_RUNTIME_NAME_SIZE);
+    instanceProperties->runtimeVersion = XR_MAKE_VERSION(1, 0, 0);
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetInstanceProcAddr(XrInstance instance, const char *name, PFN_xrVoidFunction *function) {
+    *function = nullptr;
+    if (std::strcmp(name, "xrCreateDebugUtilsMessengerEXT") == 0) {
+        *function = reinterpret_cast<PFN_xrVoidFunction>(&CreateDebugUtilsMessengerEXT);
+    } else if (std::strcmp(name, "xrDestroyDebugUtilsMessengerEXT") == 0) {
+        *function = reinterpret_cast<PFN_xrVoidFunction>(&DestroyDebugUtilsMessengerEXT);
+    } else if (std::strcmp(name, "xrLocateSpacesKHR") == 0) {
+        *function = reinterpret_cast<PFN_xrVoidFunction>(&LocateSpacesKHR);
+    }
+    return *function ? XR_SUCCESS : XR_ERROR_FUNCTION_UNSUPPORTED;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]) {
+    switch (value) {
+    case XR_SUCCESS:
+        std::strncpy(buffer, "XR_SUCCESS", XR_MAX_RESULT_STRING_SIZE);
+        break;
+    case XR_ERROR_SESSION_LOST:
+        std::strncpy(buffer, "XR_ERROR_SESSION_LOST", XR_MAX_RESULT_STRING_SIZE);
+        break;
+    case XR_ERROR_INSTANCE_LOST:
+        std::strncpy(buffer, "XR_ERROR_INSTANCE_LOST", XR_MAX_RESULT_STRING_SIZE);
+        break;
+    default:
+        std::snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "XR_UNKNOWN_RESULT_%d", static_cast<int>(value));
+        break;
+    }
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrStructureTypeToString(XrInstance instance, XrStructureType value, char buffer[XR_MAX_STRUCTURE_NAME_SIZE]) {
+    std::snprintf(buffer, XR_MAX_STRUCTURE_NAME_SIZE, "XR_UNKNOWN_STRUCTURE_TYPE_%d", static_cast<int>(value));
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrPollEvent(XrInstance instance, XrEventDataBuffer *eventData) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (runtime.events.empty()) {
+        return XR_EVENT_UNAVAILABLE;
+    }
+    *eventData = runtime.events.front();
+    runtime.events.pop_front();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrStringToPath(XrInstance instance, const char *pathString, XrPath *path) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const std::map<std::string, XrPath>::iterator it = runtime.paths.emplace(pathString, XrPath(runtime.paths.size() + 1)).first;
+    *path = it->second;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    for (const std::pair<const std::string, XrPath> &entry : runtime.paths) {
+        if (entry.second == path) {
+            *bufferCountOutput = static_cast<uint32_t>(entry.first.size() + 1);
+            if (bufferCapacityInput == 0) {
+                return XR_SUCCESS;
+            }
+            if (bufferCapacityInput < *bufferCountOutput) {
+                return XR_ERROR_SIZE_INSUFFICIENT;
+            }
+            std::memcpy(buffer, entry.first.c_str(), *bufferCountOutput);
+            return XR_SUCCESS;
+        }
+    }
+    return XR_ERROR_PATH_INVALID;
+}
+
+// System
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetSystem(XrInstance instance, const XrSystemGetInfo *getInfo, XrSystemId *systemId) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (runtime.formFactorUnavailableCount > 0) {
+        runtime.formFactorUnavailableCount--;
+        return XR_ERROR_FORM_FACTOR_UNAVAILABLE;
+    }
+    *systemId = 1;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties *properties) {
+    std::strncpy(properties->systemName, "MockRuntime System", XR_MAX_SYSTEM_NAME_SIZE);
+    properties->graphicsProperties.maxSwapchainImageWidth = 4096;
+    properties->graphicsProperties.maxSwapchainImageHeight = 4096;
+    properties->graphicsProperties.maxLayerCount = 16;
+    properties->trackingProperties.orientationTracking = XR_TRUE;
+    properties->trackingProperties.positionTracking = XR_TRUE;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEnumerateViewConfigurationViews(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t viewCapacityInput, uint32_t *viewCountOutput, XrViewConfigurationView *views) {
+    *viewCountOutput = 2;
+    for (uint32_t i = 0; i < viewCapacityInput && i < 2; i++) {
+        views[i].recommendedImageRectWidth = 1024;
+        views[i].recommendedImageRectHeight = 1024;
+        views[i].maxImageRectWidth = 4096;
+        views[i].maxImageRectHeight = 4096;
+        views[i].recommendedSwapchainSampleCount = 1;
+        views[i].maxSwapchainSampleCount = 1;
+    }
+    return XR_SUCCESS;
+}
+
+// Session
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateSession(XrInstance instance, const XrSessionCreateInfo *createInfo, XrSession *session) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (runtime.session != XR_NULL_HANDLE) {
+        runtime.Error("xrCreateSession() called while an XrSession exists");
+    }
+    runtime.session = runtime.NewHandle<XrSession>();
+    runtime.sessionsCreated++;
+    runtime.sessionRunning = false;
+    runtime.sessionLost = false;
+    runtime.sessionEnding = false;
+    runtime.sessionStopping = false;
+    runtime.actionSetsAttached = false;
+    runtime.sessionFramesWaited = 0;
+    runtime.framesWaitPending = 0;
+    runtime.frameBegun = false;
+    runtime.PushSessionState(XR_SESSION_STATE_IDLE);
+    runtime.PushSessionState(XR_SESSION_STATE_READY);
+    *session = runtime.session;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrDestroySession(XrSession session) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (session != runtime.session) {
+        runtime.Error("xrDestroySession() called with an invalid XrSession");
+        return XR_ERROR_HANDLE_INVALID;
+    }
+    if (runtime.sessionRunning && !runtime.sessionLost && !runtime.sessionEnding) {
+        runtime.Error("xrDestroySession() called on a running session");
+    }
+    runtime.session = XR_NULL_HANDLE;
+    runtime.sessionRunning = false;
+    runtime.events.clear();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrBeginSession(XrSession session, const XrSessionBeginInfo *beginInfo) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const XrResult sessionResult = CheckSession(session);
+    if (XR_FAILED(sessionResult)) {
+        return sessionResult;
+    }
+    runtime.sessionRunning = true;
+    runtime.nextFrameTime = std::chrono::steady_clock::now();
+    runtime.PushSessionState(XR_SESSION_STATE_SYNCHRONIZED);
+    runtime.PushSessionState(XR_SESSION_STATE_VISIBLE);
+    runtime.PushSessionState(XR_SESSION_STATE_FOCUSED);
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEndSession(XrSession session) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const XrResult sessionResult = CheckSession(session);
+    if (XR_FAILED(sessionResult)) {
+        return sessionResult;
+    }
+    if (runtime.frameBegun) {
+        runtime.Error("xrEndSession() called between xrBeginFrame() and xrEndFrame()");
+    }
+    runtime.sessionRunning = false;
+    runtime.PushSessionState(XR_SESSION_STATE_IDLE);
+    if (runtime.sessionStopping) {
+        runtime.PushSessionState(XR_SESSION_STATE_EXITING);
+        runtime.exitReached = true;
+    }
+    return XR_SUCCESS;
+}
+
+// Frames
+
+XRAPI_ATTR XrResult XRAPI_CALL xrWaitFrame(XrSession session, const XrFrameWaitInfo *frameWaitInfo, XrFrameState *frameState) {
+    std::chrono::steady_clock::time_point frameTime;
+    {
+        std::lock_guard<std::mutex> lock(runtime.mutex);
+        const XrResult sessionResult = CheckSession(session);
+        if (XR_FAILED(sessionResult)) {
+            return sessionResult;
+        }
+        if (!runtime.sessionRunning) {
+            return XR_ERROR_SESSION_NOT_RUNNING;
+        }
+        // Like a compositor, a frame that is more than a display period late skips the display times it missed.
+        frameTime = runtime.nextFrameTime;
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        while (frameTime + std::chrono::microseconds(11111) < now) {
+            frameTime += std::chrono::microseconds(11111);
+        }
+        runtime.nextFrameTime = frameTime + std::chrono::microseconds(11111);
+    }
+    std::this_thread::sleep_until(frameTime);
+
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    if (runtime.waitFrameSessionLostCount > 0 && runtime.sessionFramesWaited == runtime.framesPerSession / 2) {
+        runtime.waitFrameSessionLostCount--;
+        runtime.sessionLost = true;
+        return XR_ERROR_SESSION_LOST;
+    }
+    runtime.framesWaited++;
+    runtime.framesWaitPending++;
+    frameState->predictedDisplayTime = static_cast<XrTime>(std::chrono::duration_cast<std::chrono::nanoseconds>(frameTime.time_since_epoch()).count()) + 22222222;
+    frameState->predictedDisplayPeriod = 11111111;
+    frameState->shouldRender = XR_TRUE;
+    if (++runtime.sessionFramesWaited == runtime.framesPerSession && !runtime.sessionEnding) {
+        runtime.EndSessionForScenario();
+    }
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrBeginFrame(XrSession session, const XrFrameBeginInfo *frameBeginInfo) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const XrResult sessionResult = CheckSession(session);
+    if (XR_FAILED(sessionResult)) {
+        return sessionResult;
+    }
+    if (runtime.framesWaitPending == 0) {
+        runtime.Error("xrBeginFrame() called without a preceding xrWaitFrame()");
+    } else {
+        runtime.framesWaitPending--;
+    }
+    if (runtime.frameBegun) {
+        runtime.Error("xrBeginFrame() called before xrEndFrame(): the previous frame was discarded");
+    }
+    runtime.frameBegun = true;
+    runtime.framesBegun++;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEndFrame(XrSession session, const XrFrameEndInfo *frameEndInfo) {
+    bool sendDebugMessages = false;
+    {
+        std::lock_guard<std::mutex> lock(runtime.mutex);
+        const XrResult sessionResult = CheckSession(session);
+        if (XR_FAILED(sessionResult)) {
+            return sessionResult;
+        }
+        if (!runtime.frameBegun) {
+            runtime.Error("xrEndFrame() called without a preceding xrBeginFrame()");
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+        runtime.frameBegun = false;
+        runtime.framesEnded++;
+        sendDebugMessages = runtime.sessionFramesWaited <= runtime.debugMessageFrames;
+    }
+    // The messages stop after the first frames, so their repeat counts must be reported while the session runs.
+    if (sendDebugMessages) {
+        SendDebugMessage("OpenXR-Loader", "xrEndFrame", "First mock message");
+        SendDebugMessage("OpenXR-Loader", "xrEndFrame", "Second mock message");
+    }
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrLocateViews(XrSession session, const XrViewLocateInfo *viewLocateInfo, XrViewState *viewState, uint32_t viewCapacityInput, uint32_t *viewCountOutput, XrView *views) {
+    *viewCountOutput = 2;
+    viewState->viewStateFlags = XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_TRACKED_BIT | XR_VIEW_STATE_POSITION_TRACKED_BIT;
+    for (uint32_t i = 0; i < viewCapacityInput && i < 2; i++) {
+        views[i].pose = {{0.0f, 0.0f, 0.0f, 1.0f}, {i == 0 ? -0.032f : 0.032f, 1.6f, 0.0f}};
+        views[i].fov = {-0.8f, 0.8f, 0.8f, -0.8f};
+    }
+    return XR_SUCCESS;
+}
+
+// Swapchains
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEnumerateSwapchainFormats(XrSession session, uint32_t formatCapacityInput, uint32_t *formatCountOutput, int64_t *formats) {
+    // VK_FORMAT_R8G8B8A8_SRGB and VK_FORMAT_D32_SFLOAT.
+    *formatCountOutput = 2;
+    if (formatCapacityInput >= 2) {
+        formats[0] = 43;
+        formats[1] = 126;
+    }
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo *createInfo, XrSwapchain *swapchain) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    *swapchain = runtime.NewHandle<XrSwapchain>();
+    runtime.swapchains[*swapchain] = {};
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrDestroySwapchain(XrSwapchain swapchain) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    runtime.swapchains.erase(swapchain);
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrEnumerateSwapchainImages(XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t *imageCountOutput, XrSwapchainImageBaseHeader *images) {
+    *imageCountOutput = MockRuntime::swapchainImageCount;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo *acquireInfo, uint32_t *index) {
+    static uint32_t acquireCount = 0;
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    MockRuntime::SwapchainState &state = runtime.swapchains[swapchain];
+    if (state.acquiredCount == MockRuntime::swapchainImageCount) {
+        runtime.Error("xrAcquireSwapchainImage() called with every image already acquired");
+        return XR_ERROR_CALL_ORDER_INVALID;
+    }
+    state.acquiredCount++;
+    *index = acquireCount++ % MockRuntime::swapchainImageCount;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo *waitInfo) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    MockRuntime::SwapchainState &state = runtime.swapchains[swapchain];
+    if (state.waitedCount == state.acquiredCount) {
+        runtime.Error("xrWaitSwapchainImage() called without an acquired image to wait on");
+        return XR_ERROR_CALL_ORDER_INVALID;
+    }
+    if (runtime.swapchainWaitTimeoutCount > 0 && runtime.sessionsCreated == 1 && runtime.sessionFramesWaited >= runtime.framesPerSession / 2) {
+        runtime.swapchainWaitTimeoutCount--;
+        return XR_TIMEOUT_EXPIRED;
+    }
+    state.waitedCount++;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo *releaseInfo) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    MockRuntime::SwapchainState &state = runtime.swapchains[swapchain];
+    if (state.waitedCount == 0) {
+        runtime.Error("xrReleaseSwapchainImage() called without a waited image to release");
+        return XR_ERROR_CALL_ORDER_INVALID;
+    }
+    state.acquiredCount--;
+    state.waitedCount--;
+    return XR_SUCCESS;
+}
+
+// Spaces
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo *createInfo, XrSpace *space) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    *space = runtime.NewHandle<XrSpace>();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo *createInfo, XrSpace *space) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    *space = runtime.NewHandle<XrSpace>();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrDestroySpace(XrSpace space) {
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation *location) {
+    location->locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+    location->pose = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, -0.5f}};
+    return XR_SUCCESS;
+}
+
+// Actions
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo *createInfo, XrActionSet *actionSet) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    *actionSet = runtime.NewHandle<XrActionSet>();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrDestroyActionSet(XrActionSet actionSet) {
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo *createInfo, XrAction *action) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    *action = runtime.NewHandle<XrAction>();
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrSuggestInteractionProfileBindings(XrInstance instance, const XrInteractionProfileSuggestedBinding *suggestedBindings) {
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo *attachInfo) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const XrResult sessionResult = CheckSession(session);
+    if (XR_FAILED(sessionResult)) {
+        return sessionResult;
+    }
+    // Both hands get the simple controller profile as soon as the action sets are attached.
+    runtime.actionSetsAttached = true;
+    XrEventDataInteractionProfileChanged interactionProfileChanged{XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED};
+    interactionProfileChanged.session = session;
+    runtime.PushEvent(reinterpret_cast<const XrEventDataBaseHeader &>(interactionProfileChanged), sizeof(interactionProfileChanged));
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetCurrentInteractionProfile(XrSession session, XrPath topLevelUserPath, XrInteractionProfileState *interactionProfile) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const XrResult sessionResult = CheckSession(session);
+    if (XR_FAILED(sessionResult)) {
+        return sessionResult;
+    }
+    if (!runtime.actionSetsAttached) {
+        runtime.Error("xrGetCurrentInteractionProfile() called before xrAttachSessionActionSets()");
+        return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+    }
+    if (topLevelUserPath != runtime.paths["/user/hand/left"] && topLevelUserPath != runtime.paths["/user/hand/right"]) {
+        runtime.Error("xrGetCurrentInteractionProfile() called with an unknown top level user path");
+        return XR_ERROR_PATH_UNSUPPORTED;
+    }
+    const std::map<std::string, XrPath>::iterator it = runtime.paths.emplace("/interaction_profiles/khr/simple_controller", XrPath(runtime.paths.size() + 1)).first;
+    interactionProfile->interactionProfile = it->second;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrSyncActions(XrSession session, const XrActionsSyncInfo *syncInfo) {
+    std::lock_guard<std::mutex> lock(runtime.mutex);
+    const XrResult sessionResult = CheckSession(session);
+    if (XR_FAILED(sessionResult)) {
+        return sessionResult;
+    }
+    if (runtime.syncActionsSessionLostCount > 0 && runtime.sessionFramesWaited >= runtime.framesPerSession / 2) {
+        runtime.syncActionsSessionLostCount--;
+        runtime.sessionLost = true;
+        return XR_ERROR_SESSION_LOST;
+    }
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetActionStateBoolean(XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateBoolean *state) {
+    state->currentState = XR_FALSE;
+    state->isActive = XR_TRUE;
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetActionStateFloat(XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateFloat *state) {
+    state->currentState = 0.0f;
+    state->isActive = XR_TRUE;
+    return XR_SUCCESS;
+}
@@ -174,24 +174,5 @@ public:
 
 #endif
 
-#ifdef __ANDROID__
-#include <android/log.h>
-#include <sstream>
-
-#define XR_TUT_LOG_TAG "openxr_tutorial"
-#define XR_TUT_LOG(...) {                                                           \
-        std::ostringstream ostr;                                                    \
-        ostr<<__VA_ARGS__;                                                          \
-        __android_log_write(ANDROID_LOG_DEBUG, XR_TUT_LOG_TAG, ostr.str().c_str()); \
-    }
-#define XR_TUT_LOG_ERROR(...) {                                                     \
-        std::ostringstream ostr;                                                    \
-        ostr<<__VA_ARGS__;                                                          \
-        __android_log_write(ANDROID_LOG_ERROR, XR_TUT_LOG_TAG, ostr.str().c_str()); \
-    }
-#else
-#include <iostream>
-
-#define XR_TUT_LOG(...) std::cout << __VA_ARGS__ << "\n"
-#define XR_TUT_LOG_ERROR(...) std::cerr << __VA_ARGS__ << "\n"
-#endif
+// XR_TUT_LOG() and XR_TUT_LOG_ERROR() write through the asynchronous logger.
+#include <Logger.h>
@@ -79,3 +79,25 @@ int64_t GraphicsAPI::SelectDepthSwapchainFormat(const std::vector<int64_t> &form
     return *swapchainFormatIt;
 }
 // XR_DOCS_TAG_END_GraphicsAPI_SelectSwapchainFormats
+
+// Compute is optional: backends without support report an error.
+void *GraphicsAPI::CreateComputePipeline(const ComputePipelineCreateInfo &pipelineCI) {
+    std::cout << "ERROR: Compute pipelines are not supported by this GraphicsAPI." << std::endl;
+    DEBUG_BREAK;
+    return nullptr;
+}
+
+void GraphicsAPI::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    std::cout << "ERROR: Dispatch is not supported by this GraphicsAPI." << std::endl;
+    DEBUG_BREAK;
+}
+
+void GraphicsAPI::DispatchIndirect(void *buffer, size_t offset) {
+    std::cout << "ERROR: DispatchIndirect is not supported by this GraphicsAPI." << std::endl;
+    DEBUG_BREAK;
+}
+
+void GraphicsAPI::DrawIndexedIndirect(void *buffer, size_t offset, uint32_t drawCount, uint32_t stride) {
+    std::cout << "ERROR: DrawIndexedIndirect is not supported by this GraphicsAPI." << std::endl;
+    DEBUG_BREAK;
+}
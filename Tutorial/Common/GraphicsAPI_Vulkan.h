@@ -25,11 +25,9 @@ public:
     // XR_DOCS_TAG_END_GetDepthFormat_Vulkan
 
     virtual void* GetGraphicsBinding() override;
+    virtual bool RebindToInstance(XrInstance m_xrInstance, XrSystemId systemId) override;
     virtual XrSwapchainImageBaseHeader* AllocateSwapchainImageData(XrSwapchain swapchain, SwapchainType type, uint32_t count) override;
-    virtual void FreeSwapchainImageData(XrSwapchain swapchain) override {
-        swapchainImagesMap[swapchain].second.clear();
-        swapchainImagesMap.erase(swapchain);
-    }
+    virtual void FreeSwapchainImageData(XrSwapchain swapchain) override;
     virtual XrSwapchainImageBaseHeader* GetSwapchainImageData(XrSwapchain swapchain, uint32_t index) override { return (XrSwapchainImageBaseHeader*)&swapchainImagesMap[swapchain].second[index]; }
     // XR_DOCS_TAG_BEGIN_GetSwapchainImage_Vulkan
     virtual void* GetSwapchainImage(XrSwapchain swapchain, uint32_t index) override {
@@ -51,15 +49,18 @@ public:
 
     virtual void* CreateBuffer(const BufferCreateInfo& bufferCI) override;
     virtual void DestroyBuffer(void*& buffer) override;
+    virtual void* GetBufferMappedData(void* buffer) override;
 
     virtual void* CreateShader(const ShaderCreateInfo& shaderCI) override;
     virtual void DestroyShader(void*& shader) override;
 
     virtual void* CreatePipeline(const PipelineCreateInfo& pipelineCI) override;
+    virtual void* CreateComputePipeline(const ComputePipelineCreateInfo& pipelineCI) override;
     virtual void DestroyPipeline(void*& pipeline) override;
 
     virtual void BeginRendering() override;
     virtual void EndRendering() override;
+    virtual uint64_t GetLastRenderingGpuTime() override { return lastRenderingGpuTime; }
 
     virtual void SetBufferData(void* buffer, size_t offset, size_t size, void* data) override;
 
@@ -77,8 +78,15 @@ public:
     virtual void SetIndexBuffer(void* indexBuffer) override;
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
+    virtual void DrawIndexedIndirect(void* buffer, size_t offset = 0, uint32_t drawCount = 1, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+    virtual void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) override;
+    virtual void DispatchIndirect(void* buffer, size_t offset = 0) override;
 
 private:
+    VkPipelineBindPoint GetPipelineBindPoint(VkPipeline pipeline);
+    void ComputeToGraphicsBarrier();
+
     void LoadPFN_XrFunctions(XrInstance m_xrInstance);
     std::vector<std::string> GetInstanceExtensionsForOpenXR(XrInstance m_xrInstance, XrSystemId systemId);
     std::vector<std::string> GetDeviceExtensionsForOpenXR(XrInstance m_xrInstance, XrSystemId systemId);
@@ -103,6 +111,18 @@ private:
     std::vector<const char*> activeInstanceExtensions{};
     std::vector<const char*> activeDeviceLayer{};
     std::vector<const char*> activeDeviceExtensions{};
+    CapabilitySet availableInstanceExtensions;
+    CapabilitySet availableDeviceExtensions;
+    CapabilitySet enabledInstanceExtensions;  // Owns the names in activeInstanceExtensions.
+    CapabilitySet enabledDeviceExtensions;    // Owns the names in activeDeviceExtensions.
+    bool multiDrawIndirectSupported = false;
+
+    // Timestamps written at the start and the end of each BeginRendering()/EndRendering() command buffer.
+    VkQueryPool timestampQueryPool{};
+    float timestampPeriod = 0.0f;
+    uint64_t timestampMask = 0;
+    bool timestampsWritten = false;
+    uint64_t lastRenderingGpuTime = 0;
 
     PFN_xrGetVulkanGraphicsRequirementsKHR xrGetVulkanGraphicsRequirementsKHR = nullptr;
     PFN_xrGetVulkanInstanceExtensionsKHR xrGetVulkanInstanceExtensionsKHR = nullptr;
@@ -123,6 +143,7 @@ private:
     std::unordered_map<VkImageView, ImageViewCreateInfo> imageViewResources;
 
     std::unordered_map<VkBuffer, std::pair<VkDeviceMemory, BufferCreateInfo>> bufferResources;
+    std::unordered_map<VkBuffer, void*> bufferMappedData;
 
     std::unordered_map<VkShaderModule, ShaderCreateInfo> shaderResources;
     std::unordered_map<VkPipeline, std::tuple<VkPipelineLayout, VkDescriptorSetLayout, VkRenderPass, PipelineCreateInfo>> pipelineResources;
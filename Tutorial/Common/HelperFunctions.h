@@ -9,11 +9,13 @@
 // C/C++ Headers
 #include <algorithm>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Debugbreak
@@ -25,7 +27,7 @@
 #endif
 
 // XR_DOCS_TAG_BEGIN_Helper_Functions1
-inline bool IsStringInVector(std::vector<const char *> list, const char *name) {
+inline bool IsStringInVector(const std::vector<const char *> &list, const char *name) {
     bool found = false;
     for (auto &item : list) {
         if (strcmp(name, item) == 0) {
@@ -36,6 +38,61 @@ inline bool IsStringInVector(std::vector<const char *> list, const char *name) {
     return found;
 }
 
+// A set of names, such as the extensions or API layers that a runtime or driver supports, or the ones that were enabled.
+// Fill it once from the enumerated properties; Has() then hashes the name instead of comparing it against every entry,
+// and does not allocate.
+class CapabilitySet {
+public:
+    CapabilitySet() = default;
+    CapabilitySet(const CapabilitySet &) = delete;
+    CapabilitySet &operator=(const CapabilitySet &) = delete;
+    CapabilitySet(CapabilitySet &&) = default;
+    CapabilitySet &operator=(CapabilitySet &&) = default;
+
+    // Returns the set's own copy of the name, which stays valid until Clear(), for use in create info structures.
+    const char *Add(const char *name) {
+        auto it = m_names.find(name);
+        if (it != m_names.end()) {
+            return *it;
+        }
+        m_storage.emplace_back(name);
+        return *m_names.insert(m_storage.back().c_str()).first;
+    }
+
+    bool Has(const char *name) const {
+        return m_names.find(name) != m_names.end();
+    }
+
+    size_t Size() const {
+        return m_names.size();
+    }
+
+    void Clear() {
+        m_names.clear();
+        m_storage.clear();
+    }
+
+private:
+    // FNV-1a.
+    struct NameHash {
+        size_t operator()(const char *name) const {
+            size_t hash = 2166136261u;
+            for (; *name != '\0'; name++) {
+                hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+            }
+            return hash;
+        }
+    };
+    struct NameEqual {
+        bool operator()(const char *a, const char *b) const {
+            return strcmp(a, b) == 0;
+        }
+    };
+
+    std::deque<std::string> m_storage;  // Element addresses are stable as names are added.
+    std::unordered_set<const char *, NameHash, NameEqual> m_names;
+};
+
 template <typename T>
 inline bool BitwiseCheck(const T &value, const T &checkValue) {
     return ((value & checkValue) == checkValue);
@@ -0,0 +1,449 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+#pragma once
+
+// Asynchronous logging behind XR_TUT_LOG() and friends, so that logging does not block the calling thread on I/O.
+//
+// A message is only captured on the calling thread: strings are copied and numbers and pointers are stored as they are
+// into a fixed-size record in that thread's own queue, with no locks or allocations. Formatting and writing happen on a
+// background thread, which merges the queues in the order the messages were logged. Other types are formatted when they
+// are logged, through their operator<<(); stream manipulators are not supported.
+//
+// Messages below the minimum severity are skipped before any of their arguments are evaluated. When a thread's queue
+// is full, its messages are dropped rather than blocking it; GetStats() reports the drops. Errors are the exception:
+// logging one blocks until it has been written, as the application may be about to stop, e.g. on a DEBUG_BREAK.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#endif
+
+enum class LogSeverity : uint8_t {
+    VERBOSE,
+    INFO,
+    WARN,
+    ERR,
+};
+
+class Logger {
+public:
+    struct Stats {
+        std::array<uint64_t, 4> writtenCounts = {};  // Indexed by LogSeverity.
+        uint64_t droppedCount = 0;                   // Messages dropped because their thread's queue was full.
+        uint64_t truncatedCount = 0;                 // Messages cut short because they did not fit in a record.
+        size_t maxQueueDepth = 0;                    // Most messages waiting in one thread's queue.
+    };
+
+    static constexpr size_t QueueCapacity = 256;  // Records per thread.
+
+    static Logger &Get() {
+        static Logger logger;
+        return logger;
+    }
+
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        m_flushThread.join();
+    }
+
+    static bool IsEnabled(LogSeverity severity) {
+        return severity >= Get().m_minimumSeverity.load(std::memory_order_relaxed);
+    }
+
+    void SetMinimumSeverity(LogSeverity severity) {
+        m_minimumSeverity = severity;
+    }
+
+    // Blocks until the messages logged by any thread before the call have been written.
+    void Flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const uint64_t request = ++m_flushRequest;
+        m_wake.notify_all();
+        m_flushed.wait(lock, [&] { return m_flushCompleted >= request || m_flushThreadExited; });
+    }
+
+    Stats GetStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats = m_stats;
+        for (const std::shared_ptr<ThreadQueue> &queue : m_queues) {
+            stats.droppedCount += queue->droppedCount;
+            stats.truncatedCount += queue->truncatedCount;
+            stats.maxQueueDepth = std::max(stats.maxQueueDepth, queue->maxDepth.load());
+        }
+        return stats;
+    }
+
+private:
+    friend class LogMessage;
+
+    enum class ArgumentType : uint8_t {
+        STRING,
+        INT,
+        UINT,
+        DOUBLE,
+        CHAR,
+        POINTER,
+    };
+
+    struct Record {
+        uint64_t sequence;
+        LogSeverity severity;
+        bool truncated;
+        bool committed;
+        uint16_t size;
+        char payload[500];  // ArgumentType tags, each followed by its value; strings have a uint16_t length first.
+    };
+
+    struct ThreadQueue {
+        std::array<Record, QueueCapacity> records;
+        std::atomic<size_t> head{0};  // Committed records; written by the logging thread.
+        std::atomic<size_t> tail{0};  // Written records; written by the flush thread.
+        size_t reserved = 0;          // Records handed out, including ones still being captured. Logging thread only.
+        std::atomic<uint64_t> droppedCount{0};
+        std::atomic<uint64_t> truncatedCount{0};
+        std::atomic<size_t> maxDepth{0};
+        std::atomic<bool> exited{false};
+    };
+
+    // Marks the thread's queue for removal once the thread has exited and its messages have been written.
+    struct ThreadQueueHandle {
+        std::shared_ptr<ThreadQueue> queue;
+        ~ThreadQueueHandle() {
+            if (queue) {
+                queue->exited = true;
+            }
+        }
+    };
+
+    Logger() {
+        m_flushThread = std::thread(&Logger::FlushThread, this);
+    }
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    ThreadQueue &GetThreadQueue() {
+        static thread_local ThreadQueueHandle handle;
+        if (!handle.queue) {
+            handle.queue = std::make_shared<ThreadQueue>();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queues.push_back(handle.queue);
+        }
+        return *handle.queue;
+    }
+
+    // Returns nullptr if the queue is full. A message logged while capturing another one, from one of its arguments,
+    // gets the next record; records are committed in order, so it waits for the outer one.
+    Record *BeginRecord(ThreadQueue &queue, LogSeverity severity) {
+        size_t depth = queue.reserved - queue.tail.load(std::memory_order_acquire);
+        if (depth >= QueueCapacity && severity == LogSeverity::ERR) {
+            Flush();
+            depth = queue.reserved - queue.tail.load(std::memory_order_acquire);
+        }
+        if (depth >= QueueCapacity) {
+            queue.droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (depth + 1 > queue.maxDepth.load(std::memory_order_relaxed)) {
+            queue.maxDepth.store(depth + 1, std::memory_order_relaxed);
+        }
+        Record &record = queue.records[queue.reserved++ % QueueCapacity];
+        record.sequence = m_nextSequence.fetch_add(1, std::memory_order_relaxed);
+        record.severity = severity;
+        record.truncated = false;
+        record.committed = false;
+        record.size = 0;
+        return &record;
+    }
+
+    void CommitRecord(ThreadQueue &queue, Record &record) {
+        if (record.truncated) {
+            queue.truncatedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        record.committed = true;
+        size_t head = queue.head.load(std::memory_order_relaxed);
+        while (head != queue.reserved && queue.records[head % QueueCapacity].committed) {
+            head++;
+        }
+        queue.head.store(head, std::memory_order_release);
+        // Wait for errors to be written, in case the application is about to stop. Otherwise the flush thread is only
+        // woken early when a queue is filling up.
+        if (record.severity == LogSeverity::ERR) {
+            Flush();
+        } else if (head - queue.tail.load(std::memory_order_relaxed) >= QueueCapacity / 2) {
+            m_wakeRequested = true;
+            m_wake.notify_one();
+        }
+    }
+
+    void FlushThread() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(20), [&] { return m_stop || m_wakeRequested || m_flushCompleted != m_flushRequest; });
+            m_wakeRequested = false;
+            const bool stop = m_stop;
+            const uint64_t flushRequest = m_flushRequest;
+            std::vector<std::shared_ptr<ThreadQueue>> queues = m_queues;
+            lock.unlock();
+
+            const std::array<uint64_t, 4> writtenCounts = WriteQueues(queues);
+
+            lock.lock();
+            for (size_t i = 0; i < writtenCounts.size(); i++) {
+                m_stats.writtenCounts[i] += writtenCounts[i];
+            }
+            for (auto it = m_queues.begin(); it != m_queues.end();) {
+                ThreadQueue &queue = **it;
+                if (queue.exited && queue.tail.load(std::memory_order_relaxed) == queue.head.load(std::memory_order_acquire)) {
+                    m_stats.droppedCount += queue.droppedCount;
+                    m_stats.truncatedCount += queue.truncatedCount;
+                    m_stats.maxQueueDepth = std::max(m_stats.maxQueueDepth, queue.maxDepth.load());
+                    it = m_queues.erase(it);
+                } else {
+                    it++;
+                }
+            }
+            m_flushCompleted = flushRequest;
+            if (stop) {
+                m_flushThreadExited = true;
+            }
+            m_flushed.notify_all();
+            if (stop) {
+                break;
+            }
+        }
+    }
+
+    std::array<uint64_t, 4> WriteQueues(const std::vector<std::shared_ptr<ThreadQueue>> &queues) {
+        std::array<uint64_t, 4> writtenCounts = {};
+        m_pendingRecords.clear();
+        std::vector<size_t> heads(queues.size());
+        for (size_t i = 0; i < queues.size(); i++) {
+            heads[i] = queues[i]->head.load(std::memory_order_acquire);
+            for (size_t index = queues[i]->tail.load(std::memory_order_relaxed); index != heads[i]; index++) {
+                m_pendingRecords.push_back(&queues[i]->records[index % QueueCapacity]);
+            }
+        }
+        std::sort(m_pendingRecords.begin(), m_pendingRecords.end(), [](const Record *a, const Record *b) { return a->sequence < b->sequence; });
+        for (const Record *record : m_pendingRecords) {
+            WriteRecord(*record);
+            writtenCounts[static_cast<size_t>(record->severity)]++;
+        }
+        if (!m_pendingRecords.empty()) {
+            std::cout.flush();
+            std::cerr.flush();
+        }
+        for (size_t i = 0; i < queues.size(); i++) {
+            queues[i]->tail.store(heads[i], std::memory_order_release);
+        }
+        return writtenCounts;
+    }
+
+    void WriteRecord(const Record &record) {
+        m_formatter.str(std::string());
+        m_formatter.clear();
+        for (size_t offset = 0; offset < record.size;) {
+            const ArgumentType type = static_cast<ArgumentType>(record.payload[offset++]);
+            switch (type) {
+            case ArgumentType::STRING: {
+                uint16_t length = 0;
+                memcpy(&length, record.payload + offset, sizeof(length));
+                offset += sizeof(length);
+                m_formatter.write(record.payload + offset, length);
+                offset += length;
+                break;
+            }
+            case ArgumentType::INT: {
+                int64_t value = 0;
+                memcpy(&value, record.payload + offset, sizeof(value));
+                offset += sizeof(value);
+                m_formatter << value;
+                break;
+            }
+            case ArgumentType::UINT: {
+                uint64_t value = 0;
+                memcpy(&value, record.payload + offset, sizeof(value));
+                offset += sizeof(value);
+                m_formatter << value;
+                break;
+            }
+            case ArgumentType::DOUBLE: {
+                double value = 0.0;
+                memcpy(&value, record.payload + offset, sizeof(value));
+                offset += sizeof(value);
+                m_formatter << value;
+                break;
+            }
+            case ArgumentType::CHAR: {
+                m_formatter << record.payload[offset++];
+                break;
+            }
+            case ArgumentType::POINTER: {
+                const void *value = nullptr;
+                memcpy(&value, record.payload + offset, sizeof(value));
+                offset += sizeof(value);
+                m_formatter << value;
+                break;
+            }
+            }
+        }
+        if (record.truncated) {
+            m_formatter << "...";
+        }
+        const std::string &line = m_formatter.str();
+#if defined(__ANDROID__)
+        static const android_LogPriority priorities[] = {ANDROID_LOG_VERBOSE, ANDROID_LOG_INFO, ANDROID_LOG_WARN, ANDROID_LOG_ERROR};
+        __android_log_write(priorities[static_cast<size_t>(record.severity)], "openxr_tutorial", line.c_str());
+#else
+        (record.severity >= LogSeverity::WARN ? std::cerr : std::cout) << line << "\n";
+#endif
+    }
+
+    std::mutex m_mutex;  // Guards m_queues, m_stats and the flush thread state; not taken while logging.
+    std::vector<std::shared_ptr<ThreadQueue>> m_queues;
+    std::atomic<uint64_t> m_nextSequence{0};
+    std::atomic<LogSeverity> m_minimumSeverity{LogSeverity::INFO};
+    Stats m_stats;  // Totals of the written messages, and of the queues that have been removed.
+
+    std::thread m_flushThread;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    std::atomic<bool> m_wakeRequested{false};
+    bool m_stop = false;
+    bool m_flushThreadExited = false;
+    uint64_t m_flushRequest = 0;
+    uint64_t m_flushCompleted = 0;
+
+    // Only used by the flush thread.
+    std::vector<const Record *> m_pendingRecords;
+    std::ostringstream m_formatter;
+};
+
+// Captures one message into the calling thread's queue, and commits it when destroyed.
+class LogMessage {
+public:
+    explicit LogMessage(LogSeverity severity)
+        : m_queue(Logger::Get().GetThreadQueue()), m_record(Logger::Get().BeginRecord(m_queue, severity)) {}
+    ~LogMessage() {
+        if (m_record) {
+            Logger::Get().CommitRecord(m_queue, *m_record);
+        }
+    }
+    LogMessage(const LogMessage &) = delete;
+    LogMessage &operator=(const LogMessage &) = delete;
+
+    template <typename T>
+    LogMessage &operator<<(const T &value) {
+        if (m_record) {
+            Append(value);
+        }
+        return *this;
+    }
+
+private:
+    void Append(const char *value) {
+        AppendString(value ? value : "(null)", value ? strlen(value) : 6);
+    }
+    void Append(const std::string &value) {
+        AppendString(value.data(), value.size());
+    }
+    void Append(char value) {
+        AppendValue(Logger::ArgumentType::CHAR, value);
+    }
+    void Append(bool value) {
+        AppendValue(Logger::ArgumentType::UINT, static_cast<uint64_t>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type Append(T value) {
+        AppendValue(Logger::ArgumentType::INT, static_cast<int64_t>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type Append(T value) {
+        AppendValue(Logger::ArgumentType::UINT, static_cast<uint64_t>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type Append(T value) {
+        Append(static_cast<typename std::underlying_type<T>::type>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type Append(T value) {
+        AppendValue(Logger::ArgumentType::DOUBLE, static_cast<double>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_pointer<T>::value && !std::is_same<typename std::remove_cv<typename std::remove_pointer<T>::type>::type, char>::value>::type Append(T value) {
+        AppendValue(Logger::ArgumentType::POINTER, static_cast<const void *>(value));
+    }
+    template <typename T>
+    typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_enum<T>::value && !std::is_pointer<T>::value>::type Append(const T &value) {
+        std::ostringstream stream;
+        stream << value;
+        Append(stream.str());
+    }
+
+    template <typename T>
+    void AppendValue(Logger::ArgumentType type, T value) {
+        if (m_record->truncated || m_record->size + 1 + sizeof(value) > sizeof(m_record->payload)) {
+            m_record->truncated = true;
+            return;
+        }
+        m_record->payload[m_record->size++] = static_cast<char>(type);
+        memcpy(m_record->payload + m_record->size, &value, sizeof(value));
+        m_record->size += static_cast<uint16_t>(sizeof(value));
+    }
+
+    void AppendString(const char *data, size_t length) {
+        const size_t header = 1 + sizeof(uint16_t);
+        if (m_record->truncated || m_record->size + header > sizeof(m_record->payload)) {
+            m_record->truncated = true;
+            return;
+        }
+        const size_t available = sizeof(m_record->payload) - m_record->size - header;
+        if (length > available) {
+            length = available;
+            m_record->truncated = true;
+        }
+        const uint16_t storedLength = static_cast<uint16_t>(length);
+        m_record->payload[m_record->size++] = static_cast<char>(Logger::ArgumentType::STRING);
+        memcpy(m_record->payload + m_record->size, &storedLength, sizeof(storedLength));
+        m_record->size += static_cast<uint16_t>(sizeof(storedLength));
+        memcpy(m_record->payload + m_record->size, data, length);
+        m_record->size += storedLength;
+    }
+
+    Logger::ThreadQueue &m_queue;
+    Logger::Record *m_record;
+};
+
+#define XR_TUT_LOG_WITH_SEVERITY(severity, ...)  \
+    do {                                         \
+        if (Logger::IsEnabled(severity)) {       \
+            LogMessage(severity) << __VA_ARGS__; \
+        }                                        \
+    } while (false)
+
+#define XR_TUT_LOG_VERBOSE(...) XR_TUT_LOG_WITH_SEVERITY(LogSeverity::VERBOSE, __VA_ARGS__)
+#define XR_TUT_LOG(...) XR_TUT_LOG_WITH_SEVERITY(LogSeverity::INFO, __VA_ARGS__)
+#define XR_TUT_LOG_WARNING(...) XR_TUT_LOG_WITH_SEVERITY(LogSeverity::WARN, __VA_ARGS__)
+#define XR_TUT_LOG_ERROR(...) XR_TUT_LOG_WITH_SEVERITY(LogSeverity::ERR, __VA_ARGS__)
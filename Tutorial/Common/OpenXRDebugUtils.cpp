@@ -6,77 +6,141 @@
 
 #include <OpenXRDebugUtils.h>
 
-// XR_DOCS_TAG_BEGIN_OpenXRMessageCallbackFunction
-XrBool32 OpenXRMessageCallbackFunction(XrDebugUtilsMessageSeverityFlagsEXT messageSeverity, XrDebugUtilsMessageTypeFlagsEXT messageType, const XrDebugUtilsMessengerCallbackDataEXT *pCallbackData, void *pUserData) {
-    // Lambda to covert an XrDebugUtilsMessageSeverityFlagsEXT to std::string. Bitwise check to concatenate multiple severities to the output string.
-    auto GetMessageSeverityString = [](XrDebugUtilsMessageSeverityFlagsEXT messageSeverity) -> std::string {
-        bool separator = false;
-
-        std::string msgFlags;
-        if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT)) {
-            msgFlags += "VERBOSE";
-            separator = true;
-        }
-        if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)) {
-            if (separator) {
-                msgFlags += ",";
-            }
-            msgFlags += "INFO";
-            separator = true;
-        }
-        if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)) {
-            if (separator) {
-                msgFlags += ",";
-            }
-            msgFlags += "WARN";
-            separator = true;
+bool DebugUtilsMessageDeduplicator::Check(const char *messageId, const char *functionName, const char *message, LogSeverity severity, uint64_t &suppressedCount) {
+    // 64-bit FNV-1a hash of the text, so that the key stays short and is built without allocating.
+    uint64_t messageHash = 14695981039346656037ull;
+    for (const char *c = message; *c != '\0'; c++) {
+        messageHash = (messageHash ^ static_cast<unsigned char>(*c)) * 1099511628211ull;
+    }
+    char key[256];
+    snprintf(key, sizeof(key), "%s|%s|%016llx", messageId, functionName, static_cast<unsigned long long>(messageHash));
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.receivedCount++;
+    suppressedCount = 0;
+    if (!m_keys.Has(key) && m_keys.Size() >= MaxMessages) {
+        // Too many distinct messages to track: log the new ones every time rather than grow without bound.
+        return true;
+    }
+    Entry &entry = m_entries[m_keys.Add(key)];
+    if (entry.label.empty()) {
+        entry.label = std::string(functionName) + ": msgNum: " + messageId + " - " + std::string(message).substr(0, MaxLabelMessageLength);
+        entry.lastLogged = now;
+        return true;
+    }
+    if (now - entry.lastLogged < m_summaryInterval) {
+        entry.severity = std::max(entry.severity, severity);
+        entry.suppressedCount++;
+        m_stats.suppressedCount++;
+        return false;
+    }
+    suppressedCount = entry.suppressedCount;
+    entry.suppressedCount = 0;
+    entry.severity = LogSeverity::VERBOSE;
+    entry.lastLogged = now;
+    return true;
+}
+
+void DebugUtilsMessageDeduplicator::LogSummary(Entry &entry) {
+    XR_TUT_LOG_WITH_SEVERITY(entry.severity, entry.label << " - repeated " << entry.suppressedCount << " more times since last logged");
+    entry.suppressedCount = 0;
+    entry.severity = LogSeverity::VERBOSE;
+}
+
+void DebugUtilsMessageDeduplicator::LogDueSummaries() {
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::pair<const char *const, Entry> &entry : m_entries) {
+        if (entry.second.suppressedCount > 0 && now - entry.second.lastLogged >= m_summaryInterval) {
+            LogSummary(entry.second);
+            entry.second.lastLogged = now;
         }
-        if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)) {
-            if (separator) {
-                msgFlags += ",";
-            }
-            msgFlags += "ERROR";
+    }
+}
+
+void DebugUtilsMessageDeduplicator::LogSummaries() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::pair<const char *const, Entry> &entry : m_entries) {
+        if (entry.second.suppressedCount > 0) {
+            LogSummary(entry.second);
         }
-        return msgFlags;
+    }
+    m_entries.clear();
+    m_keys.Clear();
+}
+
+DebugUtilsMessageDeduplicator::Stats DebugUtilsMessageDeduplicator::GetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+// XR_DOCS_TAG_BEGIN_OpenXRMessageCallbackFunction
+XrBool32 OpenXRMessageCallbackFunction(XrDebugUtilsMessageSeverityFlagsEXT messageSeverity, XrDebugUtilsMessageTypeFlagsEXT messageType, const XrDebugUtilsMessengerCallbackDataEXT *pCallbackData, void *pUserData) {
+    // Skip messages below the logger's minimum severity before doing any work on them.
+    LogSeverity logSeverity = LogSeverity::VERBOSE;
+    if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)) {
+        logSeverity = LogSeverity::ERR;
+    } else if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)) {
+        logSeverity = LogSeverity::WARN;
+    } else if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)) {
+        logSeverity = LogSeverity::INFO;
+    }
+    if (!Logger::IsEnabled(logSeverity)) {
+        return XrBool32();
+    }
+
+    // Collect message data.
+    const char *functionName = (pCallbackData->functionName) ? pCallbackData->functionName : "";
+    const char *messageId = (pCallbackData->messageId) ? pCallbackData->messageId : "";
+    const char *message = (pCallbackData->message) ? pCallbackData->message : "";
+
+    // Drop repeats of a message that was logged recently. The userData is the DebugUtilsMessageDeduplicator, if any.
+    uint64_t suppressedCount = 0;
+    DebugUtilsMessageDeduplicator *deduplicator = reinterpret_cast<DebugUtilsMessageDeduplicator *>(pUserData);
+    if (deduplicator && !deduplicator->Check(messageId, functionName, message, logSeverity, suppressedCount)) {
+        return XrBool32();
+    }
+
+    // Lambda to write the names of the set flags to a fixed-size char array, separated by commas, without allocating.
+    struct FlagName {
+        XrFlags64 flag;
+        const char *name;
     };
-    // Lambda to covert an XrDebugUtilsMessageTypeFlagsEXT to std::string. Bitwise check to concatenate multiple types to the output string.
-    auto GetMessageTypeString = [](XrDebugUtilsMessageTypeFlagsEXT messageType) -> std::string {
-        bool separator = false;
-
-        std::string msgFlags;
-        if (BitwiseCheck(messageType, XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT)) {
-            msgFlags += "GEN";
-            separator = true;
-        }
-        if (BitwiseCheck(messageType, XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT)) {
-            if (separator) {
-                msgFlags += ",";
-            }
-            msgFlags += "SPEC";
-            separator = true;
-        }
-        if (BitwiseCheck(messageType, XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)) {
-            if (separator) {
-                msgFlags += ",";
+    auto GetFlagNames = [](XrFlags64 flags, const FlagName *flagNames, size_t flagNameCount, char (&msgFlags)[32]) {
+        size_t length = 0;
+        msgFlags[0] = '\0';
+        for (size_t i = 0; i < flagNameCount; i++) {
+            if (BitwiseCheck(flags, flagNames[i].flag)) {
+                length += snprintf(msgFlags + length, sizeof(msgFlags) - length, length > 0 ? ",%s" : "%s", flagNames[i].name);
+                length = std::min(length, sizeof(msgFlags) - 1);
             }
-            msgFlags += "PERF";
         }
-        return msgFlags;
     };
+    static const FlagName severityNames[] = {
+        {XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT, "VERBOSE"},
+        {XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, "INFO"},
+        {XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "WARN"},
+        {XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "ERROR"},
+    };
+    static const FlagName typeNames[] = {
+        {XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT, "GEN"},
+        {XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT, "SPEC"},
+        {XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT, "PERF"},
+        {XR_DEBUG_UTILS_MESSAGE_TYPE_CONFORMANCE_BIT_EXT, "CONF"},
+    };
+    char messageSeverityStr[32];
+    char messageTypeStr[32];
+    GetFlagNames(messageSeverity, severityNames, sizeof(severityNames) / sizeof(severityNames[0]), messageSeverityStr);
+    GetFlagNames(messageType, typeNames, sizeof(typeNames) / sizeof(typeNames[0]), messageTypeStr);
 
-    // Collect message data.
-    std::string functionName = (pCallbackData->functionName) ? pCallbackData->functionName : "";
-    std::string messageSeverityStr = GetMessageSeverityString(messageSeverity);
-    std::string messageTypeStr = GetMessageTypeString(messageType);
-    std::string messageId = (pCallbackData->messageId) ? pCallbackData->messageId : "";
-    std::string message = (pCallbackData->message) ? pCallbackData->message : "";
-
-    // String stream final message.
-    std::stringstream errorMessage;
-    errorMessage << functionName << "(" << messageSeverityStr << " / " << messageTypeStr << "): msgNum: " << messageId << " - " << message;
-
-    // Log and debug break.
-    std::cerr << errorMessage.str() << std::endl;
+    // Log and debug break. The logger copies the strings, and formats and writes the message on its own thread.
+    if (suppressedCount > 0) {
+        XR_TUT_LOG_WITH_SEVERITY(logSeverity, functionName << "(" << messageSeverityStr << " / " << messageTypeStr << "): msgNum: " << messageId << " - " << message
+                                                           << " (repeated " << suppressedCount << " more times since last logged)");
+    } else {
+        XR_TUT_LOG_WITH_SEVERITY(logSeverity, functionName << "(" << messageSeverityStr << " / " << messageTypeStr << "): msgNum: " << messageId << " - " << message);
+    }
     if (BitwiseCheck(messageSeverity, XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)) {
         DEBUG_BREAK;
     }
@@ -85,14 +149,14 @@ XrBool32 OpenXRMessageCallbackFunction(XrDebugUtilsMessageSeverityFlagsEXT messa
 // XR_DOCS_TAG_END_OpenXRMessageCallbackFunction
 
 // XR_DOCS_TAG_BEGIN_Create_DestroyDebugMessenger
-XrDebugUtilsMessengerEXT CreateOpenXRDebugUtilsMessenger(XrInstance m_xrInstance) {
-    // Fill out a XrDebugUtilsMessengerCreateInfoEXT structure specifying all severities and types.
+XrDebugUtilsMessengerEXT CreateOpenXRDebugUtilsMessenger(XrInstance m_xrInstance, XrDebugUtilsMessageSeverityFlagsEXT messageSeverities, XrDebugUtilsMessageTypeFlagsEXT messageTypes, DebugUtilsMessageDeduplicator *deduplicator) {
+    // Fill out a XrDebugUtilsMessengerCreateInfoEXT structure specifying the severities and types to receive.
     // Set the userCallback to OpenXRMessageCallbackFunction().
     XrDebugUtilsMessengerCreateInfoEXT debugUtilsMessengerCI{XR_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT};
-    debugUtilsMessengerCI.messageSeverities = XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-    debugUtilsMessengerCI.messageTypes = XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_CONFORMANCE_BIT_EXT;
+    debugUtilsMessengerCI.messageSeverities = messageSeverities;
+    debugUtilsMessengerCI.messageTypes = messageTypes;
     debugUtilsMessengerCI.userCallback = (PFN_xrDebugUtilsMessengerCallbackEXT)OpenXRMessageCallbackFunction;
-    debugUtilsMessengerCI.userData = nullptr;
+    debugUtilsMessengerCI.userData = deduplicator;
 
     // Load xrCreateDebugUtilsMessengerEXT() function pointer as it is not default loaded by the OpenXR loader.
     XrDebugUtilsMessengerEXT debugUtilsMessenger{};
@@ -8,7 +8,64 @@
 #include <HelperFunctions.h>
 #include <OpenXRHelper.h>
 
+#include <Logger.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Keeps a runtime message raised every frame from flooding the log. Messages are keyed on their messageId, the
+// function that raised them and a hash of their text, as a messageId such as "OpenXR-Loader" can be shared by many
+// messages. The first of each is logged; repeats are counted, and logged with the count at most once per summary
+// interval, either when the message comes again or from LogDueSummaries() if it has stopped.
+class DebugUtilsMessageDeduplicator {
+public:
+    struct Stats {
+        uint64_t receivedCount = 0;
+        uint64_t suppressedCount = 0;
+    };
+
+    explicit DebugUtilsMessageDeduplicator(std::chrono::steady_clock::duration summaryInterval = std::chrono::seconds(5))
+        : m_summaryInterval(summaryInterval) {}
+
+    // Returns whether to log the message. If so, suppressedCount is set to the number of its repeats that were dropped
+    // since it was last logged.
+    bool Check(const char *messageId, const char *functionName, const char *message, LogSeverity severity, uint64_t &suppressedCount);
+
+    // Logs the repeats dropped for each message that was last logged more than a summary interval ago. Call it
+    // regularly, for example from the event loop, so that the count of a message that stopped repeating is reported.
+    void LogDueSummaries();
+
+    // Logs the repeats dropped since each message was last logged, and forgets the messages.
+    void LogSummaries();
+
+    Stats GetStats();
+
+private:
+    struct Entry {
+        std::chrono::steady_clock::time_point lastLogged;
+        uint64_t suppressedCount = 0;
+        LogSeverity severity = LogSeverity::VERBOSE;  // The most severe of the suppressed repeats.
+        std::string label;                            // Identifies the message in the summary.
+    };
+
+    static constexpr size_t MaxMessages = 1024;
+    static constexpr size_t MaxLabelMessageLength = 64;
+
+    void LogSummary(Entry &entry);
+
+    std::mutex m_mutex;  // The callback runs on whichever thread called into OpenXR.
+    std::chrono::steady_clock::duration m_summaryInterval;
+    CapabilitySet m_keys;  // Owns the keys; equal keys share one pointer, so the map can hash the pointers.
+    std::unordered_map<const char *, Entry> m_entries;
+    Stats m_stats;
+};
+
 XrBool32 OpenXRMessageCallbackFunction(XrDebugUtilsMessageSeverityFlagsEXT messageSeverity, XrDebugUtilsMessageTypeFlagsEXT messageType, const XrDebugUtilsMessengerCallbackDataEXT *pCallbackData, void *pUserData);
 
-XrDebugUtilsMessengerEXT CreateOpenXRDebugUtilsMessenger(XrInstance m_xrInstance);
+XrDebugUtilsMessengerEXT CreateOpenXRDebugUtilsMessenger(XrInstance m_xrInstance,
+                                                         XrDebugUtilsMessageSeverityFlagsEXT messageSeverities = XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT,
+                                                         XrDebugUtilsMessageTypeFlagsEXT messageTypes = XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_CONFORMANCE_BIT_EXT,
+                                                         DebugUtilsMessageDeduplicator *deduplicator = nullptr);
 void DestroyOpenXRDebugUtilsMessenger(XrInstance m_xrInstance, XrDebugUtilsMessengerEXT debugUtilsMessenger);
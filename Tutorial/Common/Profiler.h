@@ -0,0 +1,261 @@
+// Copyright 2023, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group
+
+#pragma once
+
+// CPU instrumentation that writes a Chrome trace event file, which can be opened in chrome://tracing or Perfetto.
+//
+//  XR_TUT_PROFILE_BEGIN_SESSION(path)  Starts recording, and writing the trace to path.
+//  XR_TUT_PROFILE_END_SESSION()        Stops recording and finishes the file.
+//  XR_TUT_PROFILE_SCOPE(name)          Records the time from here to the end of the enclosing scope. name must be a
+//                                      string literal, or another string that outlives the session, and must not need
+//                                      escaping in JSON.
+//  XR_TUT_PROFILE_FUNCTION()           XR_TUT_PROFILE_SCOPE() named after the enclosing function.
+//  XR_TUT_PROFILE_THREAD_NAME(name)    Names the calling thread's track. Same requirements as for the scope names.
+//
+// The macros expand to nothing unless XR_TUTORIAL_ENABLE_PROFILING is defined; see the CMake option of the same name.
+//
+// Each thread records into its own ring buffer, with no locks: only that thread writes to it and only the session's
+// flush thread reads from it. The flush thread writes the events out every 250 ms, so a session can run for any
+// length of time. Events are dropped, and counted, if a thread fills its buffer between two flushes.
+
+#if defined(XR_TUTORIAL_ENABLE_PROFILING)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Profiler {
+public:
+    static Profiler &Get() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    ~Profiler() {
+        EndSession();
+    }
+
+    void BeginSession(const char *path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_recording) {
+            return;
+        }
+        m_file.open(path, std::fstream::out | std::fstream::trunc);
+        if (!m_file.is_open()) {
+            std::cerr << "ERROR: Profiler: Failed to open " << path << std::endl;
+            return;
+        }
+        // The JSON Array Format. Its closing bracket is optional, so a trace cut short by a crash still loads.
+        m_file << "[";
+        m_firstEvent = true;
+        m_epoch = std::chrono::steady_clock::now();
+        // Discard anything left over from a previous session. Nothing else reads the buffers while no session runs.
+        for (const std::shared_ptr<ThreadBuffer> &buffer : m_buffers) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->droppedCount = 0;
+            buffer->nameWritten = false;
+        }
+        m_stopFlushThread = false;
+        m_recording = true;
+        m_flushThread = std::thread(&Profiler::FlushThread, this);
+    }
+
+    void EndSession() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_recording) {
+                return;
+            }
+            m_recording = false;
+            m_stopFlushThread = true;
+        }
+        m_flushSignal.notify_all();
+        m_flushThread.join();
+
+        // Threads recording their first event can still add buffers, so m_buffers is only read under the lock.
+        uint64_t droppedCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const std::shared_ptr<ThreadBuffer> &buffer : m_buffers) {
+                droppedCount += buffer->droppedCount;
+            }
+        }
+        if (droppedCount > 0) {
+            std::cerr << "WARNING: Profiler: " << droppedCount << " events were dropped, as thread buffers filled up between flushes." << std::endl;
+        }
+        m_file << "\n]\n";
+        m_file.close();
+    }
+
+    bool IsRecording() const {
+        return m_recording.load(std::memory_order_relaxed);
+    }
+
+    void SetThreadName(const char *name) {
+        GetThreadBuffer().name.store(name, std::memory_order_release);
+    }
+
+    void Record(const char *name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+        ThreadBuffer &buffer = GetThreadBuffer();
+        const size_t head = buffer.head.load(std::memory_order_relaxed);
+        if (head - buffer.tail.load(std::memory_order_acquire) >= ThreadBuffer::Capacity) {
+            buffer.droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[head % ThreadBuffer::Capacity] = {name, begin, end};
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+private:
+    struct Event {
+        const char *name;
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    struct ThreadBuffer {
+        static constexpr size_t Capacity = 8192;
+        std::array<Event, Capacity> events;
+        std::atomic<size_t> head{0};  // Written by the recording thread.
+        std::atomic<size_t> tail{0};  // Written by the flush thread.
+        std::atomic<uint64_t> droppedCount{0};
+        std::atomic<const char *> name{nullptr};
+        std::atomic<bool> exited{false};
+        uint32_t threadId = 0;
+        bool nameWritten = false;  // Only used by the flush thread.
+    };
+
+    // Marks the thread's buffer for removal once the thread has exited and its events have been written.
+    struct ThreadBufferHandle {
+        std::shared_ptr<ThreadBuffer> buffer;
+        ~ThreadBufferHandle() {
+            if (buffer) {
+                buffer->exited = true;
+            }
+        }
+    };
+
+    Profiler() = default;
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    ThreadBuffer &GetThreadBuffer() {
+        static thread_local ThreadBufferHandle handle;
+        if (!handle.buffer) {
+            handle.buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            handle.buffer->threadId = ++m_threadCount;
+            m_buffers.push_back(handle.buffer);
+        }
+        return *handle.buffer;
+    }
+
+    void FlushThread() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            const bool stop = m_flushSignal.wait_for(lock, std::chrono::milliseconds(250), [&] { return m_stopFlushThread; });
+            // Write outside the lock, so that threads recording their first event are not held up by file I/O.
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers = m_buffers;
+            lock.unlock();
+            for (const std::shared_ptr<ThreadBuffer> &buffer : buffers) {
+                FlushBuffer(*buffer);
+            }
+            m_file.flush();
+            lock.lock();
+            for (auto it = m_buffers.begin(); it != m_buffers.end();) {
+                ThreadBuffer &buffer = **it;
+                const bool drained = buffer.tail.load(std::memory_order_relaxed) == buffer.head.load(std::memory_order_acquire);
+                it = buffer.exited && drained ? m_buffers.erase(it) : it + 1;
+            }
+            if (stop) {
+                break;
+            }
+        }
+    }
+
+    void FlushBuffer(ThreadBuffer &buffer) {
+        const char *name = buffer.name.load(std::memory_order_acquire);
+        if (name && !buffer.nameWritten) {
+            BeginEvent();
+            m_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.threadId << ",\"args\":{\"name\":\"" << name << "\"}}";
+            buffer.nameWritten = true;
+        }
+        const size_t head = buffer.head.load(std::memory_order_acquire);
+        size_t tail = buffer.tail.load(std::memory_order_relaxed);
+        for (; tail != head; tail++) {
+            const Event &event = buffer.events[tail % ThreadBuffer::Capacity];
+            BeginEvent();
+            m_file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.threadId
+                   << ",\"ts\":" << std::chrono::duration<double, std::micro>(event.begin - m_epoch).count()
+                   << ",\"dur\":" << std::chrono::duration<double, std::micro>(event.end - event.begin).count() << "}";
+        }
+        buffer.tail.store(tail, std::memory_order_release);
+    }
+
+    void BeginEvent() {
+        m_file << (m_firstEvent ? "\n" : ",\n");
+        m_firstEvent = false;
+    }
+
+    std::mutex m_mutex;  // Guards m_buffers and the session state; not taken while recording events.
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+    uint32_t m_threadCount = 0;
+    std::atomic<bool> m_recording{false};
+    bool m_stopFlushThread = false;
+    std::condition_variable m_flushSignal;
+    std::thread m_flushThread;
+    std::ofstream m_file;
+    bool m_firstEvent = true;
+    std::chrono::steady_clock::time_point m_epoch;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char *name)
+        : m_name(Profiler::Get().IsRecording() ? name : nullptr) {
+        if (m_name) {
+            m_begin = std::chrono::steady_clock::now();
+        }
+    }
+    ~ProfileScope() {
+        if (m_name) {
+            Profiler::Get().Record(m_name, m_begin, std::chrono::steady_clock::now());
+        }
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *m_name;
+    std::chrono::steady_clock::time_point m_begin;
+};
+
+#define XR_TUT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define XR_TUT_PROFILE_CONCAT(a, b) XR_TUT_PROFILE_CONCAT_IMPL(a, b)
+#define XR_TUT_PROFILE_BEGIN_SESSION(path) Profiler::Get().BeginSession(path)
+#define XR_TUT_PROFILE_END_SESSION() Profiler::Get().EndSession()
+#define XR_TUT_PROFILE_SCOPE(name) ProfileScope XR_TUT_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define XR_TUT_PROFILE_FUNCTION() XR_TUT_PROFILE_SCOPE(__func__)
+#define XR_TUT_PROFILE_THREAD_NAME(name) Profiler::Get().SetThreadName(name)
+
+#else
+
+#define XR_TUT_PROFILE_BEGIN_SESSION(path) (void)0
+#define XR_TUT_PROFILE_END_SESSION() (void)0
+#define XR_TUT_PROFILE_SCOPE(name) (void)0
+#define XR_TUT_PROFILE_FUNCTION() (void)0
+#define XR_TUT_PROFILE_THREAD_NAME(name) (void)0
+
+#endif
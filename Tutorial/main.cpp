@@ -25,9 +25,461 @@
 // XR_DOCS_TAG_END_include_OpenXRDebugUtils
 
 #include <OpenXRHelper.h>
+#include <xr_linear_algebra.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 #define XR_DOCS_CHAPTER_VERSION XR_DOCS_CHAPTER_1_4
 
+// Bounded FIFO used to hand frames from one pipeline stage to the next. Push() blocks while the queue is full and Pop()
+// blocks while it is empty, so the stages advance in lock-step. Close() wakes all waiters; Pop() still drains any items
+// that were queued before the queue was closed.
+template <typename T, size_t Capacity>
+class LockStepQueue {
+public:
+    bool Push(const T &item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [&] { return m_count < Capacity || m_closed; });
+        if (m_closed) {
+            return false;
+        }
+        m_items[(m_head + m_count) % Capacity] = item;
+        m_count++;
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns false if the queue was closed and is empty.
+    bool Pop(T &item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [&] { return m_count > 0 || m_closed; });
+        return PopLocked(item);
+    }
+
+    // Returns false on timeout, or if the queue was closed and is empty.
+    bool Pop(T &item, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait_for(lock, timeout, [&] { return m_count > 0 || m_closed; });
+        return PopLocked(item);
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+    void Reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_head = 0;
+        m_count = 0;
+        m_closed = false;
+    }
+
+private:
+    bool PopLocked(T &item) {
+        if (m_count == 0) {
+            return false;
+        }
+        item = m_items[m_head];
+        m_head = (m_head + 1) % Capacity;
+        m_count--;
+        m_notFull.notify_one();
+        return true;
+    }
+
+    T m_items[Capacity] = {};
+    size_t m_head = 0;
+    size_t m_count = 0;
+    bool m_closed = false;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+
+// Fixed-capacity ring buffer for one producer thread and one consumer thread. Push() and Pop() never block, lock or
+// allocate; Push() fails when the queue is full. Reset() must only be called while neither thread is using the queue.
+template <typename T, size_t Capacity>
+class SPSCQueue {
+public:
+    bool Push(const T &item) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        m_items[tail % Capacity] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T &item) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_tail.load(std::memory_order_acquire) == head) {
+            return false;
+        }
+        item = m_items[head % Capacity];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void Reset() {
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    T m_items[Capacity] = {};
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+};
+
+// Chooses the fraction of the recommended view size to render each frame, from the GPU time of recent frames and the
+// runtime's performance notifications. Scale changes only the imageRect that is rendered and submitted; the swapchains
+// are allocated once, at Policy::maxScale, so that the resolution can change every frame without recreating them.
+class DynamicResolutionController {
+public:
+    struct Policy {
+        float minScale = 0.6f;             // Bounds of the scale, relative to recommendedImageRectWidth/Height.
+        float maxScale = 1.2f;
+        float targetUtilization = 0.8f;    // Fraction of the display period the GPU should be busy, after a decrease.
+        float decreaseUtilization = 0.9f;  // Above this, the scale drops at once to reach targetUtilization.
+        float increaseUtilization = 0.7f;  // Below this for increaseDelayFrames frames, the scale grows by increaseStep.
+        uint32_t increaseDelayFrames = 45;
+        float increaseStep = 0.05f;
+        float overloadStep = 0.1f;         // Drop on a missed frame, or when the runtime reports the GPU is struggling.
+        uint32_t settleFrames = 3;         // Frames ignored after a change, as their GPU times still measure the old scale.
+        float smoothing = 0.2f;            // Weight of the latest frame in the averaged utilization.
+    };
+    struct Stats {
+        uint64_t frameCount = 0;
+        uint64_t increaseCount = 0;
+        uint64_t decreaseCount = 0;
+        uint64_t overloadCount = 0;
+        double totalScale = 0.0;
+        float minScale = 1.0f;
+        float maxScale = 1.0f;
+    };
+
+    void SetPolicy(const Policy &policy) {
+        m_policy = policy;
+        m_scale = std::min(std::max(m_scale, m_policy.minScale), m_policy.maxScale);
+    }
+    const Policy &GetPolicy() const { return m_policy; }
+    const Stats &GetStats() const { return m_stats; }
+    float GetScale() const { return m_scale; }
+
+    // While throttled, the scale does not grow. Becoming throttled also drops it by overloadStep on the next Update().
+    void SetThrottled(bool throttled) {
+        m_overloaded |= throttled && !m_throttled;
+        m_throttled = throttled;
+    }
+
+    // frameTime is the GPU time of the latest measured frame; 0 if unknown. displayPeriod is the runtime's frame period.
+    float Update(XrDuration frameTime, XrDuration displayPeriod, bool missedFrame) {
+        float scale = m_scale;
+        if (missedFrame || m_overloaded) {
+            scale -= m_policy.overloadStep;
+            m_stats.overloadCount++;
+        } else if (m_settleFrames > 0) {
+            m_settleFrames--;
+        } else if (frameTime > 0 && displayPeriod > 0) {
+            const float utilization = static_cast<float>(frameTime) / static_cast<float>(displayPeriod);
+            m_utilization = m_utilization > 0.0f ? m_utilization + m_policy.smoothing * (utilization - m_utilization) : utilization;
+            if (m_utilization > m_policy.decreaseUtilization) {
+                // GPU time is roughly proportional to the pixel count, so to the square of the scale.
+                scale *= std::sqrt(m_policy.targetUtilization / m_utilization);
+            } else if (m_utilization < m_policy.increaseUtilization && !m_throttled) {
+                if (++m_increaseFrames >= m_policy.increaseDelayFrames) {
+                    scale += m_policy.increaseStep;
+                    m_increaseFrames = 0;
+                }
+            } else {
+                m_increaseFrames = 0;
+            }
+        }
+        m_overloaded = false;
+        scale = std::min(std::max(scale, m_policy.minScale), m_policy.maxScale);
+
+        if (scale != m_scale) {
+            (scale < m_scale ? m_stats.decreaseCount : m_stats.increaseCount)++;
+            m_utilization *= (scale * scale) / (m_scale * m_scale);
+            m_increaseFrames = 0;
+            m_settleFrames = m_policy.settleFrames;
+            m_scale = scale;
+        }
+        m_stats.minScale = m_stats.frameCount ? std::min(m_stats.minScale, m_scale) : m_scale;
+        m_stats.maxScale = m_stats.frameCount ? std::max(m_stats.maxScale, m_scale) : m_scale;
+        m_stats.totalScale += m_scale;
+        m_stats.frameCount++;
+        return m_scale;
+    }
+
+private:
+    Policy m_policy;
+    Stats m_stats;
+    float m_scale = 1.0f;
+    float m_utilization = 0.0f;
+    uint32_t m_increaseFrames = 0;
+    uint32_t m_settleFrames = 0;
+    bool m_throttled = false;
+    bool m_overloaded = false;
+};
+
+// Timing of one frame through the pipeline. Each stage fills in its own phases in the FramePacket; durations are in
+// nanoseconds.
+struct FrameTimingRecord {
+    enum class MissedFrameCause : uint8_t {
+        NONE,
+        GPU,         // The GPU time of a frame in flight exceeded the display period.
+        RENDERING,   // The CPU recording and submission of one did.
+        SIMULATION,  // The simulation of one did.
+        RUNTIME,     // No phase of the frames in flight was over budget on its own.
+    };
+    enum class LateLatch : uint8_t {
+        NONE,     // Not rendered, or late latching is off.
+        LATCHED,  // The views were located again before the submission; see OpenXRTutorial::LateLatchViews().
+        FAILED,   // Locating them again failed, so the predicted views were kept.
+    };
+
+    uint64_t frameIndex = 0;
+    XrTime predictedDisplayTime = 0;
+    XrDuration predictedDisplayPeriod = 0;
+    bool shouldRender = false;
+    MissedFrameCause missedFrameCause = MissedFrameCause::NONE;
+
+    std::chrono::steady_clock::time_point waitFrameStart = {};
+    std::chrono::steady_clock::time_point simulationStart = {};
+    std::chrono::steady_clock::time_point recordStart = {};
+    std::chrono::steady_clock::time_point submitStart = {};
+    XrDuration waitFrameTime = 0;   // Blocked in xrWaitFrame().
+    XrDuration simulationTime = 0;  // Simulation events and UpdateSimulation().
+    XrDuration recordTime = 0;      // RenderLayer(), including the swapchain image waits.
+    XrDuration submitTime = 0;      // xrEndFrame().
+    // GPU time read back while this frame was recorded. GPU timestamps are read one submission late, so this is mostly
+    // the previous frame's GPU time. 0 if the GraphicsAPI has no GPU timing.
+    XrDuration gpuTime = 0;
+    LateLatch lateLatch = LateLatch::NONE;
+    XrDuration latchDelay = 0;       // Time from the first xrLocateViews() call to the late-latched one.
+    float latchPositionDelta = 0.0f;  // Largest distance of a latched view from its predicted pose, in meters.
+    float latchAngleDelta = 0.0f;     // Largest rotation of a latched view from its predicted pose, in radians.
+
+    static const char *GetMissedFrameCauseName(MissedFrameCause cause) {
+        switch (cause) {
+        case MissedFrameCause::NONE:
+            return "none";
+        case MissedFrameCause::GPU:
+            return "gpu";
+        case MissedFrameCause::RENDERING:
+            return "rendering";
+        case MissedFrameCause::SIMULATION:
+            return "simulation";
+        case MissedFrameCause::RUNTIME:
+            return "runtime";
+        }
+        return "unknown";
+    }
+    static const char *GetLateLatchName(LateLatch lateLatch) {
+        switch (lateLatch) {
+        case LateLatch::NONE:
+            return "none";
+        case LateLatch::LATCHED:
+            return "latched";
+        case LateLatch::FAILED:
+            return "failed";
+        }
+        return "unknown";
+    }
+};
+
+// Keeps the timing of the most recent frames in a ring buffer, overwriting the oldest, and exports them as CSV, JSON or
+// the Chrome trace event format (chrome://tracing, Perfetto). Only the render stage adds records, and exports happen on
+// the same thread, so the frame path takes no locks: the other stages pass their timings along in the FramePacket.
+class FrameTimingRecorder {
+public:
+    struct Stats {
+        uint64_t frameCount = 0;
+        uint64_t missedFrameCount = 0;
+        std::array<uint64_t, 5> missedFrameCauseCounts = {};
+        XrDuration totalWaitFrameTime = 0;
+        XrDuration totalSimulationTime = 0;
+        XrDuration totalRecordTime = 0;
+        XrDuration totalSubmitTime = 0;
+        XrDuration totalGpuTime = 0;
+        uint64_t latchCount = 0;
+        uint64_t failedLatchCount = 0;
+        XrDuration totalLatchDelay = 0;
+        double totalLatchPositionDelta = 0.0;
+        double maxLatchPositionDelta = 0.0;
+        double totalLatchAngleDelta = 0.0;
+        double maxLatchAngleDelta = 0.0;
+    };
+
+    explicit FrameTimingRecorder(size_t capacity)
+        : m_records(capacity), m_epoch(std::chrono::steady_clock::now()) {}
+
+    const Stats &GetStats() const { return m_stats; }
+    size_t Size() const { return m_count; }
+
+    // Call when frames restart after a gap, such as a new session, so that the gap is not counted as missed frames.
+    void Restart() {
+        m_lastPredictedDisplayTime = 0;
+        m_countSinceRestart = 0;
+    }
+
+    void Add(FrameTimingRecord record) {
+        // A missed frame shows up as a predictedDisplayTime more than a display period after the previous one. The
+        // pipeline waits on this frame while it simulates the previous frame and renders the one before, so an overrun
+        // in either of those frames in flight makes this one late, and their phases are checked against the period.
+        // GPU timestamps are read one submission late, so each record holds the GPU time of the frame before it. As
+        // BeginRendering() waits for the previous submission, a GPU overrun of the frame before the frames in flight
+        // delays them as well; the GPU times of all of these are in the records from the first frame in flight up to
+        // this one.
+        if (m_lastPredictedDisplayTime != 0 && record.predictedDisplayTime - m_lastPredictedDisplayTime > record.predictedDisplayPeriod * 3 / 2) {
+            const size_t inFlightCount = std::min<size_t>({FramesInFlight, m_countSinceRestart, m_records.size()});
+            XrDuration gpuTime = record.gpuTime;
+            XrDuration renderingTime = 0;
+            XrDuration simulationTime = 0;
+            for (size_t i = 1; i <= inFlightCount; i++) {
+                const FrameTimingRecord &inFlight = m_records[(m_next + m_records.size() - i) % m_records.size()];
+                gpuTime = std::max(gpuTime, inFlight.gpuTime);
+                renderingTime = std::max(renderingTime, inFlight.recordTime + inFlight.submitTime);
+                simulationTime = std::max(simulationTime, inFlight.simulationTime);
+            }
+            if (gpuTime > record.predictedDisplayPeriod) {
+                record.missedFrameCause = FrameTimingRecord::MissedFrameCause::GPU;
+            } else if (renderingTime > record.predictedDisplayPeriod) {
+                record.missedFrameCause = FrameTimingRecord::MissedFrameCause::RENDERING;
+            } else if (simulationTime > record.predictedDisplayPeriod) {
+                record.missedFrameCause = FrameTimingRecord::MissedFrameCause::SIMULATION;
+            } else {
+                record.missedFrameCause = FrameTimingRecord::MissedFrameCause::RUNTIME;
+            }
+            m_stats.missedFrameCount++;
+            m_stats.missedFrameCauseCounts[static_cast<size_t>(record.missedFrameCause)]++;
+        }
+        m_lastPredictedDisplayTime = record.predictedDisplayTime;
+
+        m_stats.frameCount++;
+        m_stats.totalWaitFrameTime += record.waitFrameTime;
+        m_stats.totalSimulationTime += record.simulationTime;
+        m_stats.totalRecordTime += record.recordTime;
+        m_stats.totalSubmitTime += record.submitTime;
+        m_stats.totalGpuTime += record.gpuTime;
+        if (record.lateLatch == FrameTimingRecord::LateLatch::LATCHED) {
+            m_stats.latchCount++;
+            m_stats.totalLatchDelay += record.latchDelay;
+            m_stats.totalLatchPositionDelta += record.latchPositionDelta;
+            m_stats.maxLatchPositionDelta = std::max(m_stats.maxLatchPositionDelta, static_cast<double>(record.latchPositionDelta));
+            m_stats.totalLatchAngleDelta += record.latchAngleDelta;
+            m_stats.maxLatchAngleDelta = std::max(m_stats.maxLatchAngleDelta, static_cast<double>(record.latchAngleDelta));
+        } else if (record.lateLatch == FrameTimingRecord::LateLatch::FAILED) {
+            m_stats.failedLatchCount++;
+        }
+
+        m_records[m_next] = record;
+        m_next = (m_next + 1) % m_records.size();
+        m_count = std::min(m_count + 1, m_records.size());
+        m_countSinceRestart++;
+    }
+
+    void WriteCSV(std::ostream &stream) const {
+        stream << "frame,predictedDisplayTime,predictedDisplayPeriod,shouldRender,missedFrameCause,"
+                  "waitFrameStartUs,waitFrameNs,simulationStartUs,simulationNs,recordStartUs,recordNs,submitStartUs,submitNs,gpuNs,"
+                  "lateLatch,latchDelayNs,latchPositionDeltaM,latchAngleDeltaRad\n";
+        ForEachRecord([&](const FrameTimingRecord &record) {
+            stream << record.frameIndex << ',' << record.predictedDisplayTime << ',' << record.predictedDisplayPeriod << ','
+                   << record.shouldRender << ',' << FrameTimingRecord::GetMissedFrameCauseName(record.missedFrameCause) << ','
+                   << ToMicroseconds(record.waitFrameStart) << ',' << record.waitFrameTime << ','
+                   << ToMicroseconds(record.simulationStart) << ',' << record.simulationTime << ','
+                   << ToMicroseconds(record.recordStart) << ',' << record.recordTime << ','
+                   << ToMicroseconds(record.submitStart) << ',' << record.submitTime << ',' << record.gpuTime << ','
+                   << FrameTimingRecord::GetLateLatchName(record.lateLatch) << ',' << record.latchDelay << ','
+                   << record.latchPositionDelta << ',' << record.latchAngleDelta << '\n';
+        });
+    }
+
+    void WriteJSON(std::ostream &stream) const {
+        stream << "{\"frames\":[";
+        const char *separator = "\n";
+        ForEachRecord([&](const FrameTimingRecord &record) {
+            stream << separator << "{\"frame\":" << record.frameIndex << ",\"predictedDisplayTime\":" << record.predictedDisplayTime
+                   << ",\"predictedDisplayPeriod\":" << record.predictedDisplayPeriod << ",\"shouldRender\":" << (record.shouldRender ? "true" : "false")
+                   << ",\"missedFrameCause\":\"" << FrameTimingRecord::GetMissedFrameCauseName(record.missedFrameCause) << '"'
+                   << ",\"waitFrameStartUs\":" << ToMicroseconds(record.waitFrameStart) << ",\"waitFrameNs\":" << record.waitFrameTime
+                   << ",\"simulationStartUs\":" << ToMicroseconds(record.simulationStart) << ",\"simulationNs\":" << record.simulationTime
+                   << ",\"recordStartUs\":" << ToMicroseconds(record.recordStart) << ",\"recordNs\":" << record.recordTime
+                   << ",\"submitStartUs\":" << ToMicroseconds(record.submitStart) << ",\"submitNs\":" << record.submitTime
+                   << ",\"gpuNs\":" << record.gpuTime << ",\"lateLatch\":\"" << FrameTimingRecord::GetLateLatchName(record.lateLatch) << '"'
+                   << ",\"latchDelayNs\":" << record.latchDelay << ",\"latchPositionDeltaM\":" << record.latchPositionDelta
+                   << ",\"latchAngleDeltaRad\":" << record.latchAngleDelta << '}';
+            separator = ",\n";
+        });
+        stream << "\n]}\n";
+    }
+
+    // One track per pipeline stage, counters for the GPU time and the late-latched pose delta and an instant event per
+    // missed frame.
+    void WriteChromeTrace(std::ostream &stream) const {
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Frame pacing\"}},\n";
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Simulation\"}},\n";
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"Render\"}}";
+        auto WriteSlice = [&](const char *name, int tid, uint64_t frameIndex, std::chrono::steady_clock::time_point start, XrDuration duration) {
+            stream << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << ToMicroseconds(start)
+                   << ",\"dur\":" << static_cast<double>(duration) / 1000.0 << ",\"args\":{\"frame\":" << frameIndex << "}}";
+        };
+        ForEachRecord([&](const FrameTimingRecord &record) {
+            WriteSlice("xrWaitFrame", 1, record.frameIndex, record.waitFrameStart, record.waitFrameTime);
+            WriteSlice("Simulation", 2, record.frameIndex, record.simulationStart, record.simulationTime);
+            if (record.shouldRender) {
+                WriteSlice("RenderLayer", 3, record.frameIndex, record.recordStart, record.recordTime);
+            }
+            WriteSlice("xrEndFrame", 3, record.frameIndex, record.submitStart, record.submitTime);
+            stream << ",\n{\"name\":\"GPU time (ms)\",\"ph\":\"C\",\"pid\":1,\"ts\":" << ToMicroseconds(record.recordStart)
+                   << ",\"args\":{\"gpu\":" << static_cast<double>(record.gpuTime) / 1000000.0 << "}}";
+            if (record.lateLatch == FrameTimingRecord::LateLatch::LATCHED) {
+                stream << ",\n{\"name\":\"Late latch delta (mm)\",\"ph\":\"C\",\"pid\":1,\"ts\":" << ToMicroseconds(record.recordStart)
+                       << ",\"args\":{\"position\":" << record.latchPositionDelta * 1000.0f << "}}";
+            }
+            if (record.missedFrameCause != FrameTimingRecord::MissedFrameCause::NONE) {
+                stream << ",\n{\"name\":\"Missed frame\",\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":3,\"ts\":" << ToMicroseconds(record.recordStart)
+                       << ",\"args\":{\"frame\":" << record.frameIndex << ",\"cause\":\"" << FrameTimingRecord::GetMissedFrameCauseName(record.missedFrameCause) << "\"}}";
+            }
+        });
+        stream << "\n]}\n";
+    }
+
+private:
+    template <typename Function>
+    void ForEachRecord(Function function) const {
+        const size_t first = m_count < m_records.size() ? 0 : m_next;
+        for (size_t i = 0; i < m_count; i++) {
+            function(m_records[(first + i) % m_records.size()]);
+        }
+    }
+
+    double ToMicroseconds(std::chrono::steady_clock::time_point time) const {
+        return std::chrono::duration<double, std::micro>(time - m_epoch).count();
+    }
+
+    std::vector<FrameTimingRecord> m_records;
+    size_t m_next = 0;
+    size_t m_count = 0;
+    size_t m_countSinceRestart = 0;
+    static const size_t FramesInFlight = 2;  // Simulated and rendered while the pacing thread waits on the next frame.
+    std::chrono::steady_clock::time_point m_epoch;
+    XrTime m_lastPredictedDisplayTime = 0;
+    Stats m_stats;
+};
+
 class OpenXRTutorial {
 public:
     OpenXRTutorial(GraphicsAPI_Type apiType) : m_apiType(apiType) {
@@ -35,44 +487,132 @@ public:
             std::cout << "ERROR: The provided Graphics API is not valid for this platform." << std::endl;
             DEBUG_BREAK;
         }
+        RegisterEventHandlers();
+        // Set to a file path to export the frame timing at exit: .csv for CSV, .trace.json for the Chrome trace event
+        // format, or any other name for JSON.
+        m_frameTimingExportPath = GetEnv("XR_TUTORIAL_FRAME_TIMING");
+        // Set to VERBOSE, INFO, WARN or ERROR to choose the least severe messages that are logged. The default is INFO.
+        const std::string logSeverity = GetEnv("XR_TUTORIAL_LOG_SEVERITY");
+        if (logSeverity == "VERBOSE") {
+            Logger::Get().SetMinimumSeverity(LogSeverity::VERBOSE);
+            m_debugUtilsMessageSeverities |= XR_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+        } else if (logSeverity == "WARN") {
+            Logger::Get().SetMinimumSeverity(LogSeverity::WARN);
+            m_debugUtilsMessageSeverities &= ~XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+        } else if (logSeverity == "ERROR") {
+            Logger::Get().SetMinimumSeverity(LogSeverity::ERR);
+            m_debugUtilsMessageSeverities = XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        }
     }
     ~OpenXRTutorial() = default;
 
     void Run() {
-        CreateInstance();
-        CreateDebugMessenger();
-
-        GetInstanceProperties();
-        GetSystemID();
-
-        CreateSession();
+        m_startupTime = std::chrono::steady_clock::now();
+        XR_TUT_PROFILE_BEGIN_SESSION("openxr_tutorial_trace.json");
+        XR_TUT_PROFILE_THREAD_NAME("Main");
+        if (!Startup()) {
+            DestroyDebugMessenger();
+            if (m_xrInstance != XR_NULL_HANDLE) {
+                DestroyInstance();
+            }
+            if (!m_systemUnavailable) {
+                XR_TUT_LOG_ERROR("Failed to start: the OpenXR runtime is unavailable.");
+                XR_TUT_PROFILE_END_SESSION();
+                Logger::Get().Flush();
+                return;
+            }
+            // The headset may only be disconnected or asleep, so keep retrying, as after an instance loss.
+            XR_TUT_LOG("Startup: the XrFormFactor is unavailable; retrying until it is available.");
+            m_lossRecovery = LossRecovery::INSTANCE;
+        }
 
         while (m_applicationRunning) {
             PollSystemEvents();
             PollEvents();
             if (m_sessionRunning) {
-                // Draw Frame
+                RenderFrame();
+            }
+            TakeFramePipelineLoss();
+            if (m_lossRecovery != LossRecovery::NONE) {
+                RecoverFromLoss();
             }
         }
 
-        DestroySession();
+        StopFramePipeline();
+        LogEventCounts();
+        LogFrameTiming();
+        if (m_xrInstance != XR_NULL_HANDLE) {
+            DestroyViewConstantsBuffer();
+            DestroySessionObjects();
+            DestroyActionSet();
 
-        DestroyDebugMessenger();
-        DestroyInstance();
+            DestroyDebugMessenger();
+            DestroyInstance();
+        }
+        XR_TUT_PROFILE_END_SESSION();
+        LogLoggerStats();
+        Logger::Get().Flush();
     }
 
 private:
-    void CreateInstance() {
+    // Returns false if the runtime or the system is unavailable; m_systemUnavailable tells which. The steps run in
+    // sequence on the main thread: the runtime calls that could overlap take well under a millisecond each, less than
+    // starting a thread for them, and the graphics work must stay on the thread that owns the OpenGL context.
+    bool Startup() {
+        XR_TUT_PROFILE_FUNCTION();
+        if (!CreateInstance()) {
+            return false;
+        }
+        CreateDebugMessenger();
+
+        GetInstanceProperties();
+        if (!GetSystemID()) {
+            return false;
+        }
+
+        GetViewConfigurationViews();
+
+        CreateActionSet();
+        CreateSessionObjects();
+        CreateViewConstantsBuffer();
+        XR_TUT_LOG("Startup: took " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_startupTime).count() << " ms.");
+        return true;
+    }
+
+    // Returns false if the runtime is unavailable, which can be temporary, for example while it restarts after an
+    // instance loss.
+    bool CreateInstance() {
         XrApplicationInfo AI;
         strncpy(AI.applicationName, "OpenXR Tutorial", XR_MAX_APPLICATION_NAME_SIZE);
         AI.applicationVersion = 1;
         strncpy(AI.engineName, "OpenXR Engine", XR_MAX_ENGINE_NAME_SIZE);
         AI.engineVersion = 1;
         AI.apiVersion = XR_CURRENT_API_VERSION;
+        m_xrApiVersion = AI.apiVersion;
+
+        // This can be called again after an instance loss, so start from empty lists.
+        m_instanceExtensions.clear();
+        m_optionalInstanceExtensions.clear();
+        m_activeAPILayers.clear();
+        m_activeInstanceExtensions.clear();
+        m_availableAPILayers.Clear();
+        m_availableInstanceExtensions.Clear();
+        m_enabledInstanceExtensions.Clear();
 
         m_instanceExtensions.push_back(XR_EXT_DEBUG_UTILS_EXTENSION_NAME);
         // Ensure m_apiType is already defined when we call this line.
         m_instanceExtensions.push_back(GetGraphicsAPIInstanceExtensionString(m_apiType));
+        // Optional extensions are enabled if the runtime supports them; the features that use them are skipped otherwise.
+        m_optionalInstanceExtensions.push_back(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME);
+        m_optionalInstanceExtensions.push_back(XR_EXT_PERFORMANCE_SETTINGS_EXTENSION_NAME);
+        m_optionalInstanceExtensions.push_back(XR_KHR_LOCATE_SPACES_EXTENSION_NAME);
+        if (m_apiType == OPENGL_ES) {
+            // Foveation, see SelectFoveationMode().
+            m_optionalInstanceExtensions.push_back(XR_FB_SWAPCHAIN_UPDATE_STATE_EXTENSION_NAME);
+            m_optionalInstanceExtensions.push_back(XR_FB_FOVEATION_EXTENSION_NAME);
+            m_optionalInstanceExtensions.push_back(XR_FB_FOVEATION_CONFIGURATION_EXTENSION_NAME);
+            m_optionalInstanceExtensions.push_back(XR_META_FOVEATION_EYE_TRACKED_EXTENSION_NAME);
+        }
 
         // Get all the API Layers from the OpenXR runtime.
         uint32_t apiLayerCount = 0;
@@ -80,17 +620,14 @@ private:
         OPENXR_CHECK(xrEnumerateApiLayerProperties(0, &apiLayerCount, nullptr), "Failed to enumerate ApiLayerProperties.");
         apiLayerProperties.resize(apiLayerCount, {XR_TYPE_API_LAYER_PROPERTIES});  // two-call idiom
         OPENXR_CHECK(xrEnumerateApiLayerProperties(apiLayerCount, &apiLayerCount, apiLayerProperties.data()), "Failed to enumerate ApiLayerProperties.");
+        for (auto &layerProperty : apiLayerProperties) {
+            m_availableAPILayers.Add(layerProperty.layerName);
+        }
 
         // Check the requested API layers against the ones from the OpenXR. If found add it to the Active API Layers.
         for (auto &requestLayer : m_apiLayers) {
-            for (auto &layerProperty : apiLayerProperties) {
-                // strcmp returns 0 if the strings match.
-                if (strcmp(requestLayer.c_str(), layerProperty.layerName) != 0) {
-                    continue;
-                } else {
-                    m_activeAPILayers.push_back(requestLayer.c_str());
-                    break;
-                }
+            if (m_availableAPILayers.Has(requestLayer.c_str())) {
+                m_activeAPILayers.push_back(requestLayer.c_str());
             }
         }
 
@@ -100,26 +637,29 @@ private:
         OPENXR_CHECK(xrEnumerateInstanceExtensionProperties(nullptr, 0, &extensionCount, nullptr), "Failed to enumerate InstanceExtensionProperties.");
         extensionProperties.resize(extensionCount, {XR_TYPE_EXTENSION_PROPERTIES}); // two-call idiom
         OPENXR_CHECK(xrEnumerateInstanceExtensionProperties(nullptr, extensionCount, &extensionCount, extensionProperties.data()), "Failed to enumerate InstanceExtensionProperties.");
+        for (auto &extensionProperty : extensionProperties) {
+            m_availableInstanceExtensions.Add(extensionProperty.extensionName);
+        }
 
         // Check the requested Instance Extensions against the ones from the OpenXR runtime.
         // If an extension is found add it to Active Instance Extensions.
         // Log error if the Instance Extension is not found.
         for (auto &requestedInstanceExtension : m_instanceExtensions) {
-            bool found = false;
-            for (auto &extensionProperty : extensionProperties) {
-                // strcmp returns 0 if the strings match.
-                if (strcmp(requestedInstanceExtension.c_str(), extensionProperty.extensionName) != 0) {
-                    continue;
-                } else {
-                    m_activeInstanceExtensions.push_back(requestedInstanceExtension.c_str());
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            if (m_availableInstanceExtensions.Has(requestedInstanceExtension.c_str())) {
+                m_activeInstanceExtensions.push_back(requestedInstanceExtension.c_str());
+            } else {
                 XR_TUT_LOG_ERROR("Failed to find OpenXR instance extension: " << requestedInstanceExtension);
             }
         }
+        for (auto &optionalInstanceExtension : m_optionalInstanceExtensions) {
+            if (m_availableInstanceExtensions.Has(optionalInstanceExtension.c_str())) {
+                m_activeInstanceExtensions.push_back(optionalInstanceExtension.c_str());
+            }
+        }
+        // Features check the enabled extensions with m_enabledInstanceExtensions.Has(), including from the frame loop.
+        for (const char *activeInstanceExtension : m_activeInstanceExtensions) {
+            m_enabledInstanceExtensions.Add(activeInstanceExtension);
+        }
 
         XrInstanceCreateInfo instanceCI{XR_TYPE_INSTANCE_CREATE_INFO};
         instanceCI.createFlags = 0;
@@ -128,17 +668,23 @@ private:
         instanceCI.enabledApiLayerNames = m_activeAPILayers.data();
         instanceCI.enabledExtensionCount = static_cast<uint32_t>(m_activeInstanceExtensions.size());
         instanceCI.enabledExtensionNames = m_activeInstanceExtensions.data();
-        OPENXR_CHECK(xrCreateInstance(&instanceCI, &m_xrInstance), "Failed to create Instance.");
+        const XrResult instanceResult = xrCreateInstance(&instanceCI, &m_xrInstance);
+        if (instanceResult == XR_ERROR_RUNTIME_UNAVAILABLE) {
+            return false;
+        }
+        OPENXR_CHECK(instanceResult, "Failed to create Instance.");
+        return true;
     }
 
     void DestroyInstance() {
         OPENXR_CHECK(xrDestroyInstance(m_xrInstance), "Failed to destroy Instance.");
+        m_xrInstance = XR_NULL_HANDLE;
     }
 
     void CreateDebugMessenger() {
         // Check that "XR_EXT_debug_utils" is in the active Instance Extensions before creating an XrDebugUtilsMessengerEXT.
-        if (IsStringInVector(m_activeInstanceExtensions, XR_EXT_DEBUG_UTILS_EXTENSION_NAME)) {
-            m_debugUtilsMessenger = CreateOpenXRDebugUtilsMessenger(m_xrInstance);  // From OpenXRDebugUtils.h.
+        if (m_enabledInstanceExtensions.Has(XR_EXT_DEBUG_UTILS_EXTENSION_NAME)) {
+            m_debugUtilsMessenger = CreateOpenXRDebugUtilsMessenger(m_xrInstance, m_debugUtilsMessageSeverities, m_debugUtilsMessageTypes, &m_debugUtilsMessageDeduplicator);  // From OpenXRDebugUtils.h.
         }
     }
 
@@ -146,6 +692,8 @@ private:
         // Check that "XR_EXT_debug_utils" is in the active Instance Extensions before destroying the XrDebugUtilsMessengerEXT.
         if (m_debugUtilsMessenger != XR_NULL_HANDLE) {
             DestroyOpenXRDebugUtilsMessenger(m_xrInstance, m_debugUtilsMessenger);  // From OpenXRDebugUtils.h.
+            m_debugUtilsMessenger = XR_NULL_HANDLE;
+            m_debugUtilsMessageDeduplicator.LogSummaries();
         }
     }
 
@@ -159,20 +707,48 @@ private:
                                       << XR_VERSION_PATCH(instanceProperties.runtimeVersion));
     }
 
-    void GetSystemID() {
+    // Returns false if the form factor is unavailable, for example because the headset is disconnected.
+    bool GetSystemID() {
         // Get the XrSystemId from the instance and the supplied XrFormFactor.
         XrSystemGetInfo systemGI{XR_TYPE_SYSTEM_GET_INFO};
         systemGI.formFactor = m_formFactor;
-        OPENXR_CHECK(xrGetSystem(m_xrInstance, &systemGI, &m_systemID), "Failed to get SystemID.");
+        const XrResult systemResult = xrGetSystem(m_xrInstance, &systemGI, &m_systemID);
+        m_systemUnavailable = systemResult == XR_ERROR_FORM_FACTOR_UNAVAILABLE;
+        if (m_systemUnavailable) {
+            return false;
+        }
+        OPENXR_CHECK(systemResult, "Failed to get SystemID.");
 
         // Get the System's properties for some general information about the hardware and the vendor.
+        XrSystemFoveationEyeTrackedPropertiesMETA foveationEyeTrackedProperties{XR_TYPE_SYSTEM_FOVEATION_EYE_TRACKED_PROPERTIES_META};
+        if (m_enabledInstanceExtensions.Has(XR_META_FOVEATION_EYE_TRACKED_EXTENSION_NAME)) {
+            m_systemProperties.next = &foveationEyeTrackedProperties;
+        }
         OPENXR_CHECK(xrGetSystemProperties(m_xrInstance, m_systemID, &m_systemProperties), "Failed to get SystemProperties.");
+        m_systemProperties.next = nullptr;
+        m_foveationEyeTrackedSupported = foveationEyeTrackedProperties.supportsFoveationEyeTracked == XR_TRUE;
+        return true;
+    }
+
+    void GetViewConfigurationViews() {
+        // Gets the View Configuration Views. The first call gets the count of the views, the second fills in the properties of each view.
+        uint32_t viewConfigurationViewCount = 0;
+        OPENXR_CHECK(xrEnumerateViewConfigurationViews(m_xrInstance, m_systemID, m_viewConfiguration, 0, &viewConfigurationViewCount, nullptr), "Failed to enumerate View Configuration Views.");
+        m_viewConfigurationViews.resize(viewConfigurationViewCount, {XR_TYPE_VIEW_CONFIGURATION_VIEW});
+        OPENXR_CHECK(xrEnumerateViewConfigurationViews(m_xrInstance, m_systemID, m_viewConfiguration, viewConfigurationViewCount, &viewConfigurationViewCount, m_viewConfigurationViews.data()), "Failed to enumerate View Configuration Views.");
+    }
+
+    void CreateGraphicsAPI() {
+        m_graphicsAPI = std::make_unique<GraphicsAPI_Vulkan>(m_xrInstance, m_systemID);
     }
 
     void CreateSession() {
         XrSessionCreateInfo sessionCI{XR_TYPE_SESSION_CREATE_INFO};
 
-        m_graphicsAPI = std::make_unique<GraphicsAPI_Vulkan>(m_xrInstance, m_systemID);
+        // The GraphicsAPI outlives a lost XrSession, and an XrInstance if RebindToInstance() allows it.
+        if (!m_graphicsAPI) {
+            CreateGraphicsAPI();
+        }
         sessionCI.next = m_graphicsAPI->GetGraphicsBinding();
         sessionCI.createFlags = 0;
         sessionCI.systemId = m_systemID;
@@ -182,96 +758,1394 @@ private:
 
     void DestroySession() {
         OPENXR_CHECK(xrDestroySession(m_session), "Failed to destroy Session.");
+        m_session = XR_NULL_HANDLE;
+        m_sessionState = XR_SESSION_STATE_UNKNOWN;
     }
 
-    void PollEvents() {
-        // Poll OpenXR for a new event.
-        XrEventDataBuffer eventData{XR_TYPE_EVENT_DATA_BUFFER};
-        auto XrPollEvents = [&]() -> bool {
-            eventData = {XR_TYPE_EVENT_DATA_BUFFER};
-            return xrPollEvent(m_xrInstance, &eventData) == XR_SUCCESS;
-        };
+    // Everything that belongs to the XrSession. Created at startup and again after a loss.
+    void CreateSessionObjects() {
+        CreateSession();
+        CreateReferenceSpace();
+        CreateActionSpaces();
+        CreateSwapchains();
+    }
 
-        while (XrPollEvents()) {
-            switch (eventData.type) {
-                // Log the number of lost events from the runtime.
-                case XR_TYPE_EVENT_DATA_EVENTS_LOST: {
-                    XrEventDataEventsLost *eventsLost = reinterpret_cast<XrEventDataEventsLost *>(&eventData);
-                    XR_TUT_LOG("OPENXR: Events Lost: " << eventsLost->lostEventCount);
-                    break;
+    void DestroySessionObjects() {
+        DestroySwapchains();
+        DestroyActionSpaces();
+        DestroyReferenceSpace();
+        DestroySession();
+    }
+
+    // Recovery from XR_SESSION_STATE_LOSS_PENDING and XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING, run from Run() rather than
+    // from the event handlers, so that no handler is left running on a destroyed handle. A session loss only recreates
+    // the session objects. An instance loss also recreates the XrInstance, retrying with an interval that doubles from
+    // m_minInstanceRetryInterval up to m_maxInstanceRetryInterval while the runtime or the system is unavailable. This
+    // also finishes a startup that found the system unavailable. In both cases, the GraphicsAPI device and everything
+    // created with it, such as pipelines and uploaded buffers, are kept, unless the new instance requires a different
+    // device or different Vulkan extensions.
+    enum class LossRecovery : uint8_t {
+        NONE,
+        SESSION,
+        INSTANCE
+    };
+
+    void RecoverFromLoss() {
+        XR_TUT_PROFILE_FUNCTION();
+        StopFramePipeline();
+        m_sessionRunning = false;
+
+        if (m_lossRecovery == LossRecovery::SESSION) {
+            DestroySessionObjects();
+            CreateSessionObjects();
+            m_lossRecovery = LossRecovery::NONE;
+            m_sessionRecoveryCount++;
+            XR_TUT_LOG("Recovered from Session loss (" << m_sessionRecoveryCount << " so far).");
+            return;
+        }
+
+        if (m_xrInstance != XR_NULL_HANDLE) {
+            DestroySessionObjects();
+            DestroyActionSet();
+            DestroyDebugMessenger();
+            DestroyInstance();
+        }
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now < m_nextInstanceAttempt) {
+            return;
+        }
+        m_nextInstanceAttempt = now + m_instanceRetryInterval;
+        m_instanceRetryInterval = std::min(m_instanceRetryInterval * 2, m_maxInstanceRetryInterval);
+        if (!CreateInstance()) {
+            return;
+        }
+        CreateDebugMessenger();
+        GetInstanceProperties();
+        if (!GetSystemID()) {
+            DestroyDebugMessenger();
+            DestroyInstance();
+            return;
+        }
+        GetViewConfigurationViews();
+
+        // The view constants depend on the view configuration, which the new system may change. Neither they nor the
+        // GraphicsAPI exist yet if startup found the system unavailable.
+        const bool starting = !m_graphicsAPI;
+        if (m_viewConstantsBuffer) {
+            DestroyViewConstantsBuffer();
+        }
+        if (m_graphicsAPI && !m_graphicsAPI->RebindToInstance(m_xrInstance, m_systemID)) {
+            XR_TUT_LOG("The new Instance requires a different graphics device or extensions; recreating the GraphicsAPI.");
+            m_graphicsAPI.reset();
+        }
+        CreateActionSet();
+        CreateSessionObjects();
+        CreateViewConstantsBuffer();
+        m_lossRecovery = LossRecovery::NONE;
+        m_instanceRetryInterval = m_minInstanceRetryInterval;
+        if (starting) {
+            XR_TUT_LOG("Startup: the XrFormFactor is available.");
+            return;
+        }
+        m_instanceRecoveryCount++;
+        XR_TUT_LOG("Recovered from Instance loss (" << m_instanceRecoveryCount << " so far).");
+    }
+
+    void CreateReferenceSpace() {
+        // Fill out an XrReferenceSpaceCreateInfo structure and create a reference XrSpace, specifying a Local space with an identity pose as the origin.
+        XrReferenceSpaceCreateInfo referenceSpaceCI{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+        referenceSpaceCI.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+        referenceSpaceCI.poseInReferenceSpace = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+        OPENXR_CHECK(xrCreateReferenceSpace(m_session, &referenceSpaceCI, &m_localSpace), "Failed to create ReferenceSpace.");
+    }
+
+    void DestroyReferenceSpace() {
+        OPENXR_CHECK(xrDestroySpace(m_localSpace), "Failed to destroy Space.");
+    }
+
+    // Input: one action set, with select and grab actions and grip and aim poses for each hand. Each frame, the simulation
+    // thread syncs all actions with a single xrSyncActions() call and locates every action space with a single
+    // xrLocateSpaces() call, from OpenXR 1.1 or XR_KHR_locate_spaces, rather than an xrLocateSpace() call per space.
+    // The results are stored as structure-of-arrays in the frame's InputState.
+    enum Hand : uint32_t {
+        HAND_LEFT,
+        HAND_RIGHT,
+        HAND_COUNT
+    };
+    enum InputSpace : uint32_t {
+        INPUT_SPACE_GRIP_LEFT,
+        INPUT_SPACE_GRIP_RIGHT,
+        INPUT_SPACE_AIM_LEFT,
+        INPUT_SPACE_AIM_RIGHT,
+        INPUT_SPACE_COUNT
+    };
+    struct InputState {
+        XrTime time = 0;
+        bool synced = false;  // False if the session is not focused; the action states are then inactive.
+        // Indexed by Hand.
+        std::array<XrPath, HAND_COUNT> interactionProfiles = {};  // XR_NULL_PATH if the hand has no interaction profile.
+        std::array<XrBool32, HAND_COUNT> selectActive = {};
+        std::array<XrBool32, HAND_COUNT> select = {};
+        std::array<XrBool32, HAND_COUNT> selectChanged = {};
+        std::array<XrBool32, HAND_COUNT> grabActive = {};
+        std::array<float, HAND_COUNT> grab = {};
+        // Indexed by InputSpace, in m_localSpace.
+        std::array<XrSpaceLocationFlags, INPUT_SPACE_COUNT> locationFlags = {};
+        std::array<XrPosef, INPUT_SPACE_COUNT> poses = {};
+    };
+    struct InputStats {
+        uint64_t syncCount = 0;
+        uint64_t notFocusedCount = 0;
+        uint64_t locateCallCount = 0;
+        uint64_t interactionProfileChangeCount = 0;
+    };
+
+    XrPath CreateXrPath(const char *pathString) {
+        XrPath xrPath = XR_NULL_PATH;
+        OPENXR_CHECK(xrStringToPath(m_xrInstance, pathString, &xrPath), "Failed to create XrPath from string.");
+        return xrPath;
+    }
+
+    void CreateAction(XrAction &action, const char *name, const char *localizedName, XrActionType type) {
+        XrActionCreateInfo actionCI{XR_TYPE_ACTION_CREATE_INFO};
+        actionCI.actionType = type;
+        strncpy(actionCI.actionName, name, XR_MAX_ACTION_NAME_SIZE);
+        strncpy(actionCI.localizedActionName, localizedName, XR_MAX_LOCALIZED_ACTION_NAME_SIZE);
+        actionCI.countSubactionPaths = HAND_COUNT;
+        actionCI.subactionPaths = m_handPaths.data();
+        OPENXR_CHECK(xrCreateAction(m_actionSet, &actionCI, &action), "Failed to create Action.");
+    }
+
+    // Suggests bindings for both hands: each binding is given as the path below /user/hand/left and /user/hand/right.
+    // Returns false if the runtime does not know the interaction profile.
+    bool SuggestBindings(const char *interactionProfile, const std::vector<std::pair<XrAction, const char *>> &bindings) {
+        std::vector<XrActionSuggestedBinding> suggestedBindings;
+        for (const std::pair<XrAction, const char *> &binding : bindings) {
+            for (const char *hand : {"/user/hand/left", "/user/hand/right"}) {
+                suggestedBindings.push_back({binding.first, CreateXrPath((std::string(hand) + binding.second).c_str())});
+            }
+        }
+        XrInteractionProfileSuggestedBinding interactionProfileSuggestedBinding{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+        interactionProfileSuggestedBinding.interactionProfile = CreateXrPath(interactionProfile);
+        interactionProfileSuggestedBinding.suggestedBindings = suggestedBindings.data();
+        interactionProfileSuggestedBinding.countSuggestedBindings = static_cast<uint32_t>(suggestedBindings.size());
+        const XrResult result = xrSuggestInteractionProfileBindings(m_xrInstance, &interactionProfileSuggestedBinding);
+        if (XR_FAILED(result)) {
+            XR_TUT_LOG("Failed to suggest bindings for " << interactionProfile << ": " << GetXRErrorString(m_xrInstance, result));
+            return false;
+        }
+        return true;
+    }
+
+    // The action set and its actions belong to the XrInstance; the attachment and the action spaces to the XrSession.
+    void CreateActionSet() {
+        XrActionSetCreateInfo actionSetCI{XR_TYPE_ACTION_SET_CREATE_INFO};
+        strncpy(actionSetCI.actionSetName, "openxr-tutorial-actionset", XR_MAX_ACTION_SET_NAME_SIZE);
+        strncpy(actionSetCI.localizedActionSetName, "OpenXR Tutorial ActionSet", XR_MAX_LOCALIZED_ACTION_SET_NAME_SIZE);
+        actionSetCI.priority = 0;
+        OPENXR_CHECK(xrCreateActionSet(m_xrInstance, &actionSetCI, &m_actionSet), "Failed to create ActionSet.");
+
+        m_handPaths[HAND_LEFT] = CreateXrPath("/user/hand/left");
+        m_handPaths[HAND_RIGHT] = CreateXrPath("/user/hand/right");
+        CreateAction(m_selectAction, "select", "Select", XR_ACTION_TYPE_BOOLEAN_INPUT);
+        CreateAction(m_grabAction, "grab", "Grab", XR_ACTION_TYPE_FLOAT_INPUT);
+        CreateAction(m_gripPoseAction, "grip-pose", "Grip Pose", XR_ACTION_TYPE_POSE_INPUT);
+        CreateAction(m_aimPoseAction, "aim-pose", "Aim Pose", XR_ACTION_TYPE_POSE_INPUT);
+
+        bool anyBindings = false;
+        anyBindings |= SuggestBindings("/interaction_profiles/khr/simple_controller", {{m_selectAction, "/input/select/click"},
+                                                                                       {m_grabAction, "/input/select/click"},
+                                                                                       {m_gripPoseAction, "/input/grip/pose"},
+                                                                                       {m_aimPoseAction, "/input/aim/pose"}});
+        anyBindings |= SuggestBindings("/interaction_profiles/oculus/touch_controller", {{m_selectAction, "/input/trigger/value"},
+                                                                                         {m_grabAction, "/input/squeeze/value"},
+                                                                                         {m_gripPoseAction, "/input/grip/pose"},
+                                                                                         {m_aimPoseAction, "/input/aim/pose"}});
+        if (!anyBindings) {
+            XR_TUT_LOG_ERROR("Failed to suggest bindings for any interaction profile.");
+            DEBUG_BREAK;
+        }
+    }
+
+    void DestroyActionSet() {
+        // Destroying the action set also destroys its actions.
+        OPENXR_CHECK(xrDestroyActionSet(m_actionSet), "Failed to destroy ActionSet.");
+        m_actionSet = XR_NULL_HANDLE;
+    }
+
+    void CreateActionSpaces() {
+        XrSessionActionSetsAttachInfo actionSetAttachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+        actionSetAttachInfo.countActionSets = 1;
+        actionSetAttachInfo.actionSets = &m_actionSet;
+        OPENXR_CHECK(xrAttachSessionActionSets(m_session, &actionSetAttachInfo), "Failed to attach ActionSet to Session.");
+        // The runtime sends XrEventDataInteractionProfileChanged once it has chosen the interaction profiles.
+        m_interactionProfiles = {};
+
+        // One action space per pose action and hand, in InputSpace order.
+        for (XrAction poseAction : {m_gripPoseAction, m_aimPoseAction}) {
+            for (uint32_t hand = 0; hand < HAND_COUNT; hand++) {
+                XrActionSpaceCreateInfo actionSpaceCI{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+                actionSpaceCI.action = poseAction;
+                actionSpaceCI.subactionPath = m_handPaths[hand];
+                actionSpaceCI.poseInActionSpace = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+                XrSpace space = XR_NULL_HANDLE;
+                OPENXR_CHECK(xrCreateActionSpace(m_session, &actionSpaceCI, &space), "Failed to create ActionSpace.");
+                m_inputSpaces.push_back(space);
+            }
+        }
+        m_inputSpaceLocations.resize(m_inputSpaces.size());
+
+        // Prefer the core function, then the extension; both have the same signature.
+        const char *locateSpacesName = nullptr;
+        m_xrLocateSpaces = nullptr;
+        if (XR_VERSION_MAJOR(m_xrApiVersion) > 1 || XR_VERSION_MINOR(m_xrApiVersion) >= 1) {
+            locateSpacesName = "xrLocateSpaces";
+        } else if (m_enabledInstanceExtensions.Has(XR_KHR_LOCATE_SPACES_EXTENSION_NAME)) {
+            locateSpacesName = "xrLocateSpacesKHR";
+        }
+        if (locateSpacesName) {
+            OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, locateSpacesName, (PFN_xrVoidFunction *)&m_xrLocateSpaces), "Failed to get xrLocateSpaces.");
+        }
+        XR_TUT_LOG("Input: " << m_inputSpaces.size() << " action spaces, located with " << (m_xrLocateSpaces ? locateSpacesName : "xrLocateSpace") << ".");
+    }
+
+    void DestroyActionSpaces() {
+        XR_TUT_LOG("Input: " << m_inputStats.syncCount << " syncs (" << m_inputStats.notFocusedCount << " while not focused), "
+                             << m_inputStats.locateCallCount << " locate calls, " << m_inputStats.interactionProfileChangeCount << " interaction profile changes");
+        for (uint32_t hand = 0; hand < HAND_COUNT; hand++) {
+            // This is also called while recovering from an instance loss, so a failure is not an error.
+            char interactionProfile[XR_MAX_PATH_LENGTH] = "none";
+            uint32_t length = 0;
+            if (m_interactionProfiles[hand] != XR_NULL_PATH && XR_FAILED(xrPathToString(m_xrInstance, m_interactionProfiles[hand], XR_MAX_PATH_LENGTH, &length, interactionProfile))) {
+                snprintf(interactionProfile, sizeof(interactionProfile), "XrPath %llu", static_cast<unsigned long long>(m_interactionProfiles[hand]));
+            }
+            XR_TUT_LOG("Input: " << (hand == HAND_LEFT ? "left" : "right") << " hand interaction profile: " << interactionProfile);
+        }
+        for (XrSpace &space : m_inputSpaces) {
+            OPENXR_CHECK(xrDestroySpace(space), "Failed to destroy Space.");
+        }
+        m_inputSpaces.clear();
+        m_inputSpaceLocations.clear();
+    }
+
+    // Called on the simulation thread, once per frame.
+    void PollActions(XrTime time, InputState &input) {
+        XR_TUT_PROFILE_FUNCTION();
+        input.time = time;
+
+        XrActiveActionSet activeActionSet{m_actionSet, XR_NULL_PATH};
+        XrActionsSyncInfo actionsSyncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+        actionsSyncInfo.countActiveActionSets = 1;
+        actionsSyncInfo.activeActionSets = &activeActionSet;
+        const XrResult syncResult = xrSyncActions(m_session, &actionsSyncInfo);
+        if (HandleFramePipelineLoss(syncResult)) {
+            input.synced = false;
+            return;
+        }
+        OPENXR_CHECK(syncResult, "Failed to sync Actions.");
+        m_inputStats.syncCount++;
+        input.synced = syncResult == XR_SUCCESS;
+        if (syncResult == XR_SESSION_NOT_FOCUSED) {
+            m_inputStats.notFocusedCount++;
+        }
+
+        for (uint32_t hand = 0; hand < HAND_COUNT; hand++) {
+            XrActionStateGetInfo actionStateGetInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            actionStateGetInfo.subactionPath = m_handPaths[hand];
+
+            actionStateGetInfo.action = m_selectAction;
+            XrActionStateBoolean selectState{XR_TYPE_ACTION_STATE_BOOLEAN};
+            OPENXR_CHECK(xrGetActionStateBoolean(m_session, &actionStateGetInfo, &selectState), "Failed to get Boolean State of Select action.");
+            input.selectActive[hand] = selectState.isActive;
+            input.select[hand] = selectState.currentState;
+            input.selectChanged[hand] = selectState.changedSinceLastSync;
+
+            actionStateGetInfo.action = m_grabAction;
+            XrActionStateFloat grabState{XR_TYPE_ACTION_STATE_FLOAT};
+            OPENXR_CHECK(xrGetActionStateFloat(m_session, &actionStateGetInfo, &grabState), "Failed to get Float State of Grab action.");
+            input.grabActive[hand] = grabState.isActive;
+            input.grab[hand] = grabState.currentState;
+        }
+
+        // Inactive pose actions locate with no valid flags, so their action state does not need to be queried.
+        if (m_xrLocateSpaces) {
+            XrSpacesLocateInfoKHR spacesLocateInfo{XR_TYPE_SPACES_LOCATE_INFO_KHR};
+            spacesLocateInfo.baseSpace = m_localSpace;
+            spacesLocateInfo.time = time;
+            spacesLocateInfo.spaceCount = static_cast<uint32_t>(m_inputSpaces.size());
+            spacesLocateInfo.spaces = m_inputSpaces.data();
+            XrSpaceLocationsKHR spaceLocations{XR_TYPE_SPACE_LOCATIONS_KHR};
+            spaceLocations.locationCount = static_cast<uint32_t>(m_inputSpaceLocations.size());
+            spaceLocations.locations = m_inputSpaceLocations.data();
+            const XrResult locateResult = m_xrLocateSpaces(m_session, &spacesLocateInfo, &spaceLocations);
+            if (HandleFramePipelineLoss(locateResult)) {
+                input.synced = false;
+                return;
+            }
+            OPENXR_CHECK(locateResult, "Failed to locate Spaces.");
+            m_inputStats.locateCallCount++;
+        } else {
+            for (size_t i = 0; i < m_inputSpaces.size(); i++) {
+                XrSpaceLocation spaceLocation{XR_TYPE_SPACE_LOCATION};
+                OPENXR_CHECK(xrLocateSpace(m_inputSpaces[i], m_localSpace, time, &spaceLocation), "Failed to locate Space.");
+                m_inputSpaceLocations[i] = {spaceLocation.locationFlags, spaceLocation.pose};
+                m_inputStats.locateCallCount++;
+            }
+        }
+        input.interactionProfiles = m_interactionProfiles;
+        for (uint32_t i = 0; i < INPUT_SPACE_COUNT; i++) {
+            input.locationFlags[i] = m_inputSpaceLocations[i].locationFlags;
+            input.poses[i] = m_inputSpaceLocations[i].pose;
+        }
+    }
+
+    // Swapchain management: all XrSwapchains and their image views are created up front by CreateSwapchains(), so the frame
+    // loop only acquires, waits on and releases images. Each SwapchainInfo keeps statistics on how long the render stage
+    // blocked in xrWaitSwapchainImage(), which are logged when the swapchains are destroyed. A wait that keeps timing out
+    // is given up after m_maxSwapchainWaitTimeouts, and the frame is submitted without the projection layer.
+    // If the graphics backend attaches array images for multiview, as OpenGL does with GL_OVR_multiview2, a single color
+    // and depth swapchain with one array layer per view is used and all views are cleared in one pass. Otherwise, including
+    // on Vulkan, there is a color and depth swapchain per view.
+    struct SwapchainStats {
+        uint64_t acquireCount = 0;
+        uint64_t waitTimeoutCount = 0;
+        uint64_t skippedFrameCount = 0;
+        XrDuration totalWaitTime = 0;
+        XrDuration maxWaitTime = 0;
+    };
+    struct SwapchainInfo {
+        XrSwapchain swapchain = XR_NULL_HANDLE;
+        GraphicsAPI::SwapchainType type = GraphicsAPI::SwapchainType::COLOR;
+        int64_t swapchainFormat = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t arraySize = 1;
+        std::vector<void *> imageViews;
+        uint32_t imageIndex = 0;
+        bool imageAcquired = false;  // Still acquired from a frame in which the wait was given up.
+        bool imageWaited = false;
+        SwapchainStats stats;
+    };
+
+    void CreateSwapchains() {
+        // Get the supported swapchain formats as an array of int64_t and ordered by runtime preference.
+        uint32_t formatCount = 0;
+        OPENXR_CHECK(xrEnumerateSwapchainFormats(m_session, 0, &formatCount, nullptr), "Failed to enumerate Swapchain Formats");
+        std::vector<int64_t> formats(formatCount);
+        OPENXR_CHECK(xrEnumerateSwapchainFormats(m_session, formatCount, &formatCount, formats.data()), "Failed to enumerate Swapchain Formats");
+        const int64_t colorFormat = m_graphicsAPI->SelectColorSwapchainFormat(formats);
+        const int64_t depthFormat = m_graphicsAPI->SelectDepthSwapchainFormat(formats);
+        if (depthFormat == 0) {
+            XR_TUT_LOG_ERROR("Failed to find depth format for Swapchain.");
+            DEBUG_BREAK;
+        }
+
+        SelectFoveationMode();
+
+        // An array swapchain needs every view to have the same recommended size.
+        const uint32_t viewCount = static_cast<uint32_t>(m_viewConfigurationViews.size());
+        m_useArraySwapchain = viewCount > 1 && m_graphicsAPI->IsMultiviewSupported();
+        for (const XrViewConfigurationView &viewConfigurationView : m_viewConfigurationViews) {
+            m_useArraySwapchain &= viewConfigurationView.recommendedImageRectWidth == m_viewConfigurationViews[0].recommendedImageRectWidth &&
+                                   viewConfigurationView.recommendedImageRectHeight == m_viewConfigurationViews[0].recommendedImageRectHeight;
+        }
+
+        if (m_useArraySwapchain) {
+            // One color and depth swapchain, with an array layer per view.
+            m_colorSwapchainInfos.resize(1);
+            m_depthSwapchainInfos.resize(1);
+            CreateSwapchain(m_colorSwapchainInfos[0], GraphicsAPI::SwapchainType::COLOR, colorFormat, m_viewConfigurationViews[0], viewCount);
+            CreateSwapchain(m_depthSwapchainInfos[0], GraphicsAPI::SwapchainType::DEPTH, depthFormat, m_viewConfigurationViews[0], viewCount);
+        } else {
+            // Per view, create a color and depth swapchain, and their associated image views.
+            m_colorSwapchainInfos.resize(viewCount);
+            m_depthSwapchainInfos.resize(viewCount);
+            for (uint32_t i = 0; i < viewCount; i++) {
+                CreateSwapchain(m_colorSwapchainInfos[i], GraphicsAPI::SwapchainType::COLOR, colorFormat, m_viewConfigurationViews[i], 1);
+                CreateSwapchain(m_depthSwapchainInfos[i], GraphicsAPI::SwapchainType::DEPTH, depthFormat, m_viewConfigurationViews[i], 1);
+            }
+        }
+        XR_TUT_LOG("Swapchains: " << (m_useArraySwapchain ? "one array swapchain with multiview" : "one swapchain per view") << " for " << viewCount << " views.");
+        ApplyFoveation();
+        CreateFloorPipeline(colorFormat, depthFormat);
+
+        m_views.resize(m_viewConfigurationViews.size(), {XR_TYPE_VIEW});
+        m_layerProjectionViews.resize(m_viewConfigurationViews.size(), {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW});
+
+        // Depth is submitted with the projection views if the runtime supports XR_KHR_composition_layer_depth, which
+        // lets it reproject positionally when a frame is late.
+        m_submitDepth &= m_enabledInstanceExtensions.Has(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME);
+        m_layerDepthInfos.resize(m_submitDepth ? m_viewConfigurationViews.size() : 0, {XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR});
+        XR_TUT_LOG("Depth submission: " << (m_submitDepth ? "enabled" : "disabled"));
+    }
+
+    void CreateSwapchain(SwapchainInfo &swapchainInfo, GraphicsAPI::SwapchainType type, int64_t format, const XrViewConfigurationView &viewConfigurationView, uint32_t arraySize) {
+        const bool color = type == GraphicsAPI::SwapchainType::COLOR;
+
+        XrSwapchainCreateInfo swapchainCI{XR_TYPE_SWAPCHAIN_CREATE_INFO};
+        swapchainCI.createFlags = 0;
+        swapchainCI.usageFlags = XR_SWAPCHAIN_USAGE_SAMPLED_BIT | (color ? XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT : XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+        swapchainCI.format = format;
+        swapchainCI.sampleCount = viewConfigurationView.recommendedSwapchainSampleCount;  // Use the recommended values from the XrViewConfigurationView.
+        // Allocate for the largest dynamic resolution scale; each frame renders to, and submits, a sub-rectangle.
+        const float maxScale = m_useDynamicResolution ? m_dynamicResolution.GetPolicy().maxScale : 1.0f;
+        swapchainCI.width = std::min(static_cast<uint32_t>(viewConfigurationView.recommendedImageRectWidth * maxScale), viewConfigurationView.maxImageRectWidth);
+        swapchainCI.height = std::min(static_cast<uint32_t>(viewConfigurationView.recommendedImageRectHeight * maxScale), viewConfigurationView.maxImageRectHeight);
+        swapchainCI.faceCount = 1;
+        swapchainCI.arraySize = arraySize;
+        swapchainCI.mipCount = 1;
+
+        // XR_FB_foveation: the runtime creates the color images so that a foveation profile can be applied to them.
+        XrSwapchainCreateInfoFoveationFB swapchainFoveationCI{XR_TYPE_SWAPCHAIN_CREATE_INFO_FOVEATION_FB};
+        const bool foveated = color && (m_foveationMode == FoveationMode::FB_FIXED || m_foveationMode == FoveationMode::FB_EYE_TRACKED);
+        if (foveated) {
+            swapchainFoveationCI.flags = XR_SWAPCHAIN_CREATE_FOVEATION_SCALED_BIN_BIT_FB;
+            swapchainCI.next = &swapchainFoveationCI;
+        }
+        OPENXR_CHECK(xrCreateSwapchain(m_session, &swapchainCI, &swapchainInfo.swapchain), "Failed to create Swapchain");
+        swapchainInfo.type = type;
+        swapchainInfo.swapchainFormat = format;
+        swapchainInfo.width = swapchainCI.width;
+        swapchainInfo.height = swapchainCI.height;
+        swapchainInfo.arraySize = arraySize;
+
+        // Get the number of images in the swapchain and allocate the Graphics API specific image data for them.
+        uint32_t swapchainImageCount = 0;
+        OPENXR_CHECK(xrEnumerateSwapchainImages(swapchainInfo.swapchain, 0, &swapchainImageCount, nullptr), "Failed to enumerate Swapchain Images.");
+        XrSwapchainImageBaseHeader *swapchainImages = m_graphicsAPI->AllocateSwapchainImageData(swapchainInfo.swapchain, type, swapchainImageCount);
+        OPENXR_CHECK(xrEnumerateSwapchainImages(swapchainInfo.swapchain, swapchainImageCount, &swapchainImageCount, swapchainImages), "Failed to enumerate Swapchain Images.");
+
+        // Create an image view for each image, so that none are created in the frame loop. Array images get a single view
+        // covering all layers, which the backend attaches for multiview rendering.
+        for (uint32_t j = 0; j < swapchainImageCount; j++) {
+            GraphicsAPI::ImageViewCreateInfo imageViewCI;
+            imageViewCI.image = m_graphicsAPI->GetSwapchainImage(swapchainInfo.swapchain, j);
+            imageViewCI.type = color ? GraphicsAPI::ImageViewCreateInfo::Type::RTV : GraphicsAPI::ImageViewCreateInfo::Type::DSV;
+            imageViewCI.view = arraySize > 1 ? GraphicsAPI::ImageViewCreateInfo::View::TYPE_2D_ARRAY : GraphicsAPI::ImageViewCreateInfo::View::TYPE_2D;
+            imageViewCI.format = format;
+            imageViewCI.aspect = color ? GraphicsAPI::ImageViewCreateInfo::Aspect::COLOR_BIT : GraphicsAPI::ImageViewCreateInfo::Aspect::DEPTH_BIT;
+            imageViewCI.baseMipLevel = 0;
+            imageViewCI.levelCount = 1;
+            imageViewCI.baseArrayLayer = 0;
+            imageViewCI.layerCount = arraySize;
+            swapchainInfo.imageViews.push_back(m_graphicsAPI->CreateImageView(imageViewCI));
+        }
+    }
+
+    void DestroySwapchains() {
+        DestroyFloorPipeline();
+        if (m_useDynamicResolution) {
+            const DynamicResolutionController::Stats &stats = m_dynamicResolution.GetStats();
+            XR_TUT_LOG("Dynamic resolution: " << stats.frameCount << " frames, average scale " << (stats.frameCount ? stats.totalScale / stats.frameCount : 1.0)
+                                               << ", min " << stats.minScale << ", max " << stats.maxScale << ", " << stats.decreaseCount << " decreases, "
+                                               << stats.increaseCount << " increases, " << stats.overloadCount << " overloads");
+        }
+        for (std::vector<SwapchainInfo> *swapchainInfos : {&m_colorSwapchainInfos, &m_depthSwapchainInfos}) {
+            for (SwapchainInfo &swapchainInfo : *swapchainInfos) {
+                const SwapchainStats &stats = swapchainInfo.stats;
+                XR_TUT_LOG("Swapchain " << swapchainInfo.swapchain << ": " << stats.acquireCount << " images, "
+                                        << stats.waitTimeoutCount << " wait timeouts, " << stats.skippedFrameCount << " skipped frames, average wait "
+                                        << (stats.acquireCount ? stats.totalWaitTime / stats.acquireCount : 0) << " ns, max wait " << stats.maxWaitTime << " ns");
+
+                for (void *&imageView : swapchainInfo.imageViews) {
+                    m_graphicsAPI->DestroyImageView(imageView);
                 }
+                swapchainInfo.imageViews.clear();
+                m_graphicsAPI->FreeSwapchainImageData(swapchainInfo.swapchain);
+                OPENXR_CHECK(xrDestroySwapchain(swapchainInfo.swapchain), "Failed to destroy Swapchain");
+            }
+            swapchainInfos->clear();
+        }
+    }
 
-                // Log that an instance loss is pending and shutdown the application.
-                case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING: {
-                    XrEventDataInstanceLossPending *instanceLossPending = reinterpret_cast<XrEventDataInstanceLossPending *>(&eventData);
-                    XR_TUT_LOG("OPENXR: Instance Loss Pending at: " << instanceLossPending->lossTime);
-                    m_sessionRunning = false;
-                    m_applicationRunning = false;
-                    break;
+    // Acquires the next image; the index is stored in swapchainInfo.imageIndex. Acquiring does not block, so the render
+    // stage acquires all images for a frame up front and only waits on each one right before it first renders to it.
+    // An image whose wait was given up is kept instead, as only a waited image can be released.
+    void AcquireSwapchainImage(SwapchainInfo &swapchainInfo) {
+        if (swapchainInfo.imageAcquired) {
+            return;
+        }
+        XrSwapchainImageAcquireInfo acquireInfo{XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO};
+        OPENXR_CHECK(xrAcquireSwapchainImage(swapchainInfo.swapchain, &acquireInfo, &swapchainInfo.imageIndex), "Failed to acquire Image from the Swapchain");
+        swapchainInfo.imageAcquired = true;
+        swapchainInfo.stats.acquireCount++;
+    }
+
+    // Waits until the runtime has finished reading the acquired image. Each call to xrWaitSwapchainImage() is bounded, so
+    // stalls in the compositor are counted in the statistics. Returns false once m_maxSwapchainWaitTimeouts calls in a
+    // row have timed out; the image stays acquired and the wait is retried in the next frame.
+    bool WaitSwapchainImage(SwapchainInfo &swapchainInfo) {
+        XR_TUT_PROFILE_FUNCTION();
+        if (swapchainInfo.imageWaited) {
+            return true;
+        }
+        XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+        waitInfo.timeout = m_swapchainWaitTimeout;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        XrResult waitResult = XR_TIMEOUT_EXPIRED;
+        for (uint32_t timeoutCount = 0; waitResult == XR_TIMEOUT_EXPIRED && timeoutCount < m_maxSwapchainWaitTimeouts;) {
+            waitResult = xrWaitSwapchainImage(swapchainInfo.swapchain, &waitInfo);
+            if (waitResult == XR_TIMEOUT_EXPIRED) {
+                swapchainInfo.stats.waitTimeoutCount++;
+                timeoutCount++;
+            }
+        }
+        const XrDuration waitTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        swapchainInfo.stats.totalWaitTime += waitTime;
+        swapchainInfo.stats.maxWaitTime = std::max(swapchainInfo.stats.maxWaitTime, waitTime);
+        if (waitResult == XR_TIMEOUT_EXPIRED) {
+            swapchainInfo.stats.skippedFrameCount++;
+            return false;
+        }
+        OPENXR_CHECK(waitResult, "Failed to wait for Image from the Swapchain");
+        swapchainInfo.imageWaited = true;
+        return true;
+    }
+
+    void ReleaseSwapchainImage(SwapchainInfo &swapchainInfo) {
+        XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
+        OPENXR_CHECK(xrReleaseSwapchainImage(swapchainInfo.swapchain, &releaseInfo), "Failed to release Image back to the Swapchain");
+        swapchainInfo.imageAcquired = false;
+        swapchainInfo.imageWaited = false;
+    }
+
+    // Foveated rendering lowers the shading rate towards the edges of the color images, where the lenses blur them anyway.
+    // In order of preference:
+    //  - FB_EYE_TRACKED: XR_FB_foveation with XR_META_foveation_eye_tracked; the runtime moves the fovea with the gaze.
+    //  - FB_FIXED: XR_FB_foveation with a fixed foveation level from XR_FB_foveation_configuration.
+    // Both use scaled-bin foveation, which the OpenGL ES driver applies to the render passes without changes to the
+    // rendering. On Vulkan, the runtime's foveation is delivered as fragment density maps (XR_FB_foveation_vulkan) that
+    // only take effect when the render passes that draw into the images attach them, so it is not used until this
+    // chapter draws geometry; it only clears the images.
+    enum class FoveationMode : uint8_t {
+        NONE,
+        FB_FIXED,
+        FB_EYE_TRACKED
+    };
+
+    void SelectFoveationMode() {
+        m_foveationMode = FoveationMode::NONE;
+        if (!m_useFoveation) {
+            return;
+        }
+
+        const bool fbFoveation = m_enabledInstanceExtensions.Has(XR_FB_FOVEATION_EXTENSION_NAME) &&
+                                 m_enabledInstanceExtensions.Has(XR_FB_FOVEATION_CONFIGURATION_EXTENSION_NAME) &&
+                                 m_enabledInstanceExtensions.Has(XR_FB_SWAPCHAIN_UPDATE_STATE_EXTENSION_NAME);
+        if (fbFoveation) {
+            OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrCreateFoveationProfileFB", (PFN_xrVoidFunction *)&m_xrCreateFoveationProfileFB), "Failed to get InstanceProcAddr for xrCreateFoveationProfileFB.");
+            OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrDestroyFoveationProfileFB", (PFN_xrVoidFunction *)&m_xrDestroyFoveationProfileFB), "Failed to get InstanceProcAddr for xrDestroyFoveationProfileFB.");
+            OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrUpdateSwapchainFB", (PFN_xrVoidFunction *)&m_xrUpdateSwapchainFB), "Failed to get InstanceProcAddr for xrUpdateSwapchainFB.");
+            const bool eyeTracked = m_foveationEyeTrackedSupported && m_enabledInstanceExtensions.Has(XR_META_FOVEATION_EYE_TRACKED_EXTENSION_NAME);
+            m_foveationMode = eyeTracked ? FoveationMode::FB_EYE_TRACKED : FoveationMode::FB_FIXED;
+        }
+    }
+
+    // Called once the swapchains are created.
+    void ApplyFoveation() {
+        if (m_foveationMode == FoveationMode::FB_FIXED || m_foveationMode == FoveationMode::FB_EYE_TRACKED) {
+            XrFoveationLevelProfileCreateInfoFB levelProfileCI{XR_TYPE_FOVEATION_LEVEL_PROFILE_CREATE_INFO_FB};
+            levelProfileCI.level = m_foveationLevel;
+            levelProfileCI.verticalOffset = 0.0f;
+            levelProfileCI.dynamic = XR_FOVEATION_DYNAMIC_LEVEL_ENABLED_FB;  // Let the runtime lower the level when there is GPU headroom.
+            XrFoveationEyeTrackedProfileCreateInfoMETA eyeTrackedProfileCI{XR_TYPE_FOVEATION_EYE_TRACKED_PROFILE_CREATE_INFO_META};
+            if (m_foveationMode == FoveationMode::FB_EYE_TRACKED) {
+                levelProfileCI.next = &eyeTrackedProfileCI;
+            }
+            XrFoveationProfileCreateInfoFB profileCI{XR_TYPE_FOVEATION_PROFILE_CREATE_INFO_FB};
+            profileCI.next = &levelProfileCI;
+            XrFoveationProfileFB profile = XR_NULL_HANDLE;
+            OPENXR_CHECK(m_xrCreateFoveationProfileFB(m_session, &profileCI, &profile), "Failed to create FoveationProfile.");
+
+            // The swapchains keep the profile's settings, so it can be destroyed straight away.
+            for (const SwapchainInfo &colorSwapchainInfo : m_colorSwapchainInfos) {
+                XrSwapchainStateFoveationFB foveationState{XR_TYPE_SWAPCHAIN_STATE_FOVEATION_FB};
+                foveationState.profile = profile;
+                OPENXR_CHECK(m_xrUpdateSwapchainFB(colorSwapchainInfo.swapchain, reinterpret_cast<XrSwapchainStateBaseHeaderFB *>(&foveationState)), "Failed to update Swapchain foveation state.");
+            }
+            OPENXR_CHECK(m_xrDestroyFoveationProfileFB(profile), "Failed to destroy FoveationProfile.");
+        }
+
+        static const char *const foveationModeNames[] = {"none", "XR_FB_foveation, fixed", "XR_FB_foveation, eye-tracked"};
+        XR_TUT_LOG("Foveation: " << foveationModeNames[static_cast<uint8_t>(m_foveationMode)]);
+    }
+
+    // View constants: the view and view-projection matrices of each view live in one uniform buffer, which stays mapped
+    // for its lifetime when the backend allows it, and which the floor draw reads; see DrawFloor(). With
+    // m_lateLatchViews, the views are located a second time right before the frame's first submission and the buffer
+    // and projection views are patched with the newer poses, which shortens motion-to-photon latency. The difference
+    // between the predicted and the late-latched poses goes into the frame's FrameTimingRecord.
+    struct ViewConstants {
+        XrMatrix4x4f viewProj;
+        XrMatrix4x4f view;
+        // Each view's constants are bound at their offset in the buffer, which must be a multiple of the uniform buffer
+        // offset alignment. 256 bytes is the largest that Vulkan allows.
+        float pad[32];
+    };
+    static_assert(sizeof(ViewConstants) == 256, "ViewConstants must be aligned for uniform buffer offsets.");
+
+    void CreateViewConstantsBuffer() {
+        m_viewConstants.resize(m_views.size());
+        m_projectionCaches.assign(m_views.size(), XrProjectionCache{});
+        GraphicsAPI::BufferCreateInfo bufferCI = {GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(ViewConstants) * m_viewConstants.size(), m_viewConstants.data()};
+        bufferCI.persistentlyMapped = true;
+        m_viewConstantsBuffer = m_graphicsAPI->CreateBuffer(bufferCI);
+        m_viewConstantsMappedData = m_graphicsAPI->GetBufferMappedData(m_viewConstantsBuffer);
+    }
+
+    void DestroyViewConstantsBuffer() {
+        m_viewConstantsMappedData = nullptr;
+        m_graphicsAPI->DestroyBuffer(m_viewConstantsBuffer);
+        m_viewConstantsBuffer = nullptr;
+        m_viewConstants.clear();
+        m_projectionCaches.clear();
+    }
+
+    // Writes the matrices of m_views into the view constants buffer. This must be called after BeginRendering(), as that
+    // waits for the GPU to finish the previous submission that read the buffer.
+    void UpdateViewConstants() {
+        XR_TUT_PROFILE_FUNCTION();
+        for (size_t i = 0; i < m_viewConstants.size(); i++) {
+            const XrPosef &pose = m_views[i].pose;
+            XrMatrix4x4f toView;
+            XrVector3f scale = {1.0f, 1.0f, 1.0f};
+            // Runtimes usually report the same fov every frame, so the projection is only rebuilt when it changes.
+            const XrMatrix4x4f *proj = XrProjectionCache_Get(&m_projectionCaches[i], m_apiType, m_views[i].fov, m_nearZ, m_farZ, false);
+            XrMatrix4x4f_CreateTranslationRotationScale(&toView, &pose.position, &pose.orientation, &scale);
+            XrMatrix4x4f_InvertRigidBody(&m_viewConstants[i].view, &toView);
+            XrMatrix4x4f_Multiply(&m_viewConstants[i].viewProj, proj, &m_viewConstants[i].view);
+        }
+        const size_t size = sizeof(ViewConstants) * m_viewConstants.size();
+        if (m_viewConstantsMappedData) {
+            memcpy(m_viewConstantsMappedData, m_viewConstants.data(), size);
+        } else {
+            m_graphicsAPI->SetBufferData(m_viewConstantsBuffer, 0, size, m_viewConstants.data());
+        }
+    }
+
+    // Locates the views again for the same display time. The runtime's prediction is more accurate this close to the
+    // display time. On success, the view constants and the projection views are patched with the newer poses.
+    void LateLatchViews(const XrFrameState &frameState, std::chrono::steady_clock::time_point locateTime, FrameTimingRecord &timing) {
+        XR_TUT_PROFILE_FUNCTION();
+        const uint32_t viewCount = static_cast<uint32_t>(m_views.size());
+        m_latchedViews.resize(viewCount, {XR_TYPE_VIEW});
+
+        XrViewState viewState{XR_TYPE_VIEW_STATE};
+        XrViewLocateInfo viewLocateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+        viewLocateInfo.viewConfigurationType = m_viewConfiguration;
+        viewLocateInfo.displayTime = frameState.predictedDisplayTime;
+        viewLocateInfo.space = m_localSpace;
+        uint32_t latchedViewCount = 0;
+        XrResult result = xrLocateViews(m_session, &viewLocateInfo, &viewState, viewCount, &latchedViewCount, m_latchedViews.data());
+        if (result != XR_SUCCESS || latchedViewCount != viewCount || !BitwiseCheck(viewState.viewStateFlags, XrViewStateFlags(XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT))) {
+            // Keep the predicted views, which the frame was already recorded with.
+            timing.lateLatch = FrameTimingRecord::LateLatch::FAILED;
+            return;
+        }
+
+        timing.lateLatch = FrameTimingRecord::LateLatch::LATCHED;
+        timing.latchDelay = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - locateTime).count();
+        for (uint32_t i = 0; i < viewCount; i++) {
+            const XrPosef &predicted = m_views[i].pose;
+            const XrPosef &latched = m_latchedViews[i].pose;
+            const double dx = latched.position.x - predicted.position.x;
+            const double dy = latched.position.y - predicted.position.y;
+            const double dz = latched.position.z - predicted.position.z;
+            const double positionDelta = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const double dot = std::fabs(predicted.orientation.x * latched.orientation.x + predicted.orientation.y * latched.orientation.y +
+                                         predicted.orientation.z * latched.orientation.z + predicted.orientation.w * latched.orientation.w);
+            const double angleDelta = 2.0 * std::acos(std::min(dot, 1.0));
+            timing.latchPositionDelta = std::max(timing.latchPositionDelta, static_cast<float>(positionDelta));
+            timing.latchAngleDelta = std::max(timing.latchAngleDelta, static_cast<float>(angleDelta));
+
+            // The composition layer must be submitted with the poses that were rendered.
+            m_views[i] = m_latchedViews[i];
+            m_layerProjectionViews[i].pose = m_views[i].pose;
+            m_layerProjectionViews[i].fov = m_views[i].fov;
+        }
+        UpdateViewConstants();
+    }
+
+    // The floor is the one draw of this chapter: a checkerboard quad whose vertex shader reads the view constants, so
+    // that the late-latched poses reach the GPU. Its shaders are compiled to SPIR-V from Shaders/*_Floor.glsl by the
+    // CMakeLists.txt, so only the Vulkan backend draws it; the other graphics APIs only clear the images. Without a
+    // pipeline, for example when the shaders were not found, the images are only cleared as well.
+    void CreateFloorPipeline(int64_t colorFormat, int64_t depthFormat) {
+        if (m_apiType != VULKAN || m_useArraySwapchain) {
+            return;
+        }
+#if defined(__ANDROID__)
+        std::vector<char> vertexSource = ReadBinaryFile("shaders/VertexShader_Floor.spv", androidApp->activity->assetManager);
+        std::vector<char> fragmentSource = ReadBinaryFile("shaders/PixelShader_Floor.spv", androidApp->activity->assetManager);
+#else
+        std::vector<char> vertexSource = ReadBinaryFile("VertexShader_Floor.spv");
+        std::vector<char> fragmentSource = ReadBinaryFile("PixelShader_Floor.spv");
+#endif
+        if (vertexSource.empty() || fragmentSource.empty()) {
+            XR_TUT_LOG_ERROR("Failed to read the floor shaders; the images are only cleared.");
+            return;
+        }
+        m_floorVertexShader = m_graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
+        m_floorFragmentShader = m_graphicsAPI->CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+        // The vertices are generated in the vertex shader, so there is no vertex input. The depth test matches the
+        // ClearDepth(1.0f) in RenderLayer() and the forward-Z projection of UpdateViewConstants().
+        GraphicsAPI::PipelineCreateInfo pipelineCI;
+        pipelineCI.shaders = {m_floorVertexShader, m_floorFragmentShader};
+        pipelineCI.inputAssemblyState = {GraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, false};
+        pipelineCI.rasterisationState = {false, false, GraphicsAPI::PolygonMode::FILL, GraphicsAPI::CullMode::NONE, GraphicsAPI::FrontFace::COUNTER_CLOCKWISE, false, 0.0f, 0.0f, 0.0f, 1.0f};
+        pipelineCI.multisampleState = {1, false, 1.0f, 0xFFFFFFFF, false, false};
+        pipelineCI.depthStencilState = {true, true, GraphicsAPI::CompareOp::LESS_OR_EQUAL, false, false, {}, {}, 0.0f, 1.0f};
+        pipelineCI.colorBlendState = {false, GraphicsAPI::LogicOp::NO_OP, {{false, GraphicsAPI::BlendFactor::ONE, GraphicsAPI::BlendFactor::ZERO, GraphicsAPI::BlendOp::ADD, GraphicsAPI::BlendFactor::ONE, GraphicsAPI::BlendFactor::ZERO, GraphicsAPI::BlendOp::ADD, (GraphicsAPI::ColorComponentBit)15}}, {0.0f, 0.0f, 0.0f, 0.0f}};
+        pipelineCI.colorFormats = {colorFormat};
+        pipelineCI.depthFormat = depthFormat;
+        pipelineCI.layout = {{0, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false}};
+        m_floorPipeline = m_graphicsAPI->CreatePipeline(pipelineCI);
+    }
+
+    void DestroyFloorPipeline() {
+        if (m_floorPipeline) {
+            m_graphicsAPI->DestroyPipeline(m_floorPipeline);
+        }
+        for (void **shader : {&m_floorVertexShader, &m_floorFragmentShader}) {
+            if (*shader) {
+                m_graphicsAPI->DestroyShader(*shader);
+            }
+        }
+    }
+
+    // Records the floor draw of a view into its color and depth images, after they were cleared. The draw binds the
+    // view's constants in m_viewConstantsBuffer, which the GPU only reads when it executes the submission, so
+    // LateLatchViews() can still patch them after this is recorded.
+    void DrawFloor(uint32_t viewIndex, void *colorImageView, void *depthImageView, const SwapchainInfo &colorSwapchainInfo) {
+        XR_TUT_PROFILE_FUNCTION();
+        const XrRect2Di &imageRect = m_layerProjectionViews[viewIndex].subImage.imageRect;
+        GraphicsAPI::Viewport viewport = {static_cast<float>(imageRect.offset.x), static_cast<float>(imageRect.offset.y),
+                                          static_cast<float>(imageRect.extent.width), static_cast<float>(imageRect.extent.height), 0.0f, 1.0f};
+        GraphicsAPI::Rect2D scissor = {{imageRect.offset.x, imageRect.offset.y}, {static_cast<uint32_t>(imageRect.extent.width), static_cast<uint32_t>(imageRect.extent.height)}};
+        m_graphicsAPI->SetRenderAttachments(&colorImageView, 1, depthImageView, colorSwapchainInfo.width, colorSwapchainInfo.height, m_floorPipeline);
+        m_graphicsAPI->SetViewports(&viewport, 1);
+        m_graphicsAPI->SetScissors(&scissor, 1);
+        m_graphicsAPI->SetPipeline(m_floorPipeline);
+        m_graphicsAPI->SetDescriptor({0, m_viewConstantsBuffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false,
+                                      sizeof(ViewConstants) * viewIndex, 2 * sizeof(XrMatrix4x4f)});
+        m_graphicsAPI->UpdateDescriptors();
+        m_graphicsAPI->Draw(6, 1, 0, 0);
+    }
+
+    // Events are dispatched through a table of handlers, registered once, rather than a switch. Handlers run on the main
+    // thread, or, for events that only concern the application state, on the simulation thread, which receives them
+    // through a lock-free queue. Nothing on this path allocates or logs, as the runtime can send bursts of events during
+    // session transitions; the counts are logged when the application exits.
+    using EventHandler = void (OpenXRTutorial::*)(const XrEventDataBuffer &eventData);
+    enum class EventThread : uint8_t {
+        MAIN,
+        SIMULATION
+    };
+    struct EventHandlerEntry {
+        XrStructureType type = XR_TYPE_UNKNOWN;
+        EventHandler handler = nullptr;
+        EventThread thread = EventThread::MAIN;
+        uint64_t count = 0;
+    };
+
+    void RegisterEventHandler(XrStructureType type, EventHandler handler, EventThread thread = EventThread::MAIN) {
+        if (m_eventHandlerCount == m_eventHandlers.size()) {
+            XR_TUT_LOG_ERROR("Too many event handlers registered.");
+            DEBUG_BREAK;
+            return;
+        }
+        m_eventHandlers[m_eventHandlerCount++] = {type, handler, thread, 0};
+    }
+
+    void RegisterEventHandlers() {
+        RegisterEventHandler(XR_TYPE_EVENT_DATA_EVENTS_LOST, &OpenXRTutorial::OnEventsLost);
+        RegisterEventHandler(XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING, &OpenXRTutorial::OnInstanceLossPending);
+        RegisterEventHandler(XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED, &OpenXRTutorial::OnSessionStateChanged);
+        RegisterEventHandler(XR_TYPE_EVENT_DATA_PERF_SETTINGS_EXT, &OpenXRTutorial::OnPerfSettings);
+        RegisterEventHandler(XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED, &OpenXRTutorial::OnInteractionProfileChanged, EventThread::SIMULATION);
+        RegisterEventHandler(XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING, &OpenXRTutorial::OnReferenceSpaceChangePending);
+    }
+
+    EventHandlerEntry *FindEventHandler(XrStructureType type) {
+        for (size_t i = 0; i < m_eventHandlerCount; i++) {
+            if (m_eventHandlers[i].type == type) {
+                return &m_eventHandlers[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void PollEvents() {
+        XR_TUT_PROFILE_FUNCTION();
+        if (m_xrInstance == XR_NULL_HANDLE) {
+            return;  // Lost, and not recreated yet.
+        }
+        m_debugUtilsMessageDeduplicator.LogDueSummaries();
+
+        // Drain at most one batch of events from the runtime, so that a burst can not stall the frame loop; the rest are
+        // polled on the next iteration. Only the header of each buffer is reset, as required by xrPollEvent().
+        size_t eventCount = 0;
+        while (eventCount < m_polledEvents.size()) {
+            XrEventDataBuffer &eventData = m_polledEvents[eventCount];
+            eventData.type = XR_TYPE_EVENT_DATA_BUFFER;
+            eventData.next = nullptr;
+            if (xrPollEvent(m_xrInstance, &eventData) != XR_SUCCESS) {
+                break;
+            }
+            eventCount++;
+        }
+        if (eventCount > 0) {
+            m_idleWait = std::chrono::milliseconds(0);
+        }
+
+        for (size_t i = 0; i < eventCount; i++) {
+            const XrEventDataBuffer &eventData = m_polledEvents[i];
+            EventHandlerEntry *entry = FindEventHandler(eventData.type);
+            if (!entry) {
+                m_unhandledEventCount++;
+                continue;
+            }
+            entry->count++;
+            // Simulation events are handled here while the simulation thread is not running, or if its queue is full.
+            if (entry->thread == EventThread::SIMULATION && m_framePipelineRunning) {
+                if (m_simulationEvents.Push(eventData)) {
+                    continue;
                 }
+                m_simulationEventOverflowCount++;
+            }
+            (this->*entry->handler)(eventData);
+        }
+    }
 
-                // Log that the interaction profile has changed.
-                case XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED: {
-                    XrEventDataInteractionProfileChanged *interactionProfileChanged = reinterpret_cast<XrEventDataInteractionProfileChanged *>(&eventData);
-                    XR_TUT_LOG("OPENXR: Interaction Profile changed for Session: " << interactionProfileChanged->session);
-                    if (interactionProfileChanged->session != m_session) {
-                        XR_TUT_LOG("XrEventDataInteractionProfileChanged for unknown Session");
-                        break;
-                    }
-                    break;
+    // Called on the simulation thread, or on the main thread once the simulation thread has stopped.
+    void DispatchSimulationEvents() {
+        XrEventDataBuffer eventData;
+        while (m_simulationEvents.Pop(eventData)) {
+            // The table is not modified after RegisterEventHandlers(), so it can be read from any thread.
+            const EventHandlerEntry *entry = FindEventHandler(eventData.type);
+            (this->*entry->handler)(eventData);
+        }
+    }
+
+    void LogEventCounts() {
+        for (size_t i = 0; i < m_eventHandlerCount; i++) {
+            const EventHandlerEntry &entry = m_eventHandlers[i];
+            if (entry.count > 0) {
+                char typeName[XR_MAX_STRUCTURE_NAME_SIZE] = {};
+                if (m_xrInstance == XR_NULL_HANDLE || XR_FAILED(xrStructureTypeToString(m_xrInstance, entry.type, typeName))) {
+                    snprintf(typeName, sizeof(typeName), "XrStructureType %d", static_cast<int>(entry.type));
                 }
+                XR_TUT_LOG("OPENXR: " << entry.count << " " << typeName << " events");
+            }
+        }
+        XR_TUT_LOG("OPENXR: " << m_lostEventCount << " events lost by the runtime, " << m_unhandledEventCount << " unhandled, "
+                              << m_simulationEventOverflowCount << " handled on the main thread as the simulation queue was full, "
+                              << m_unknownSessionEventCount << " for an unknown Session");
+        const DebugUtilsMessageDeduplicator::Stats debugUtilsStats = m_debugUtilsMessageDeduplicator.GetStats();
+        XR_TUT_LOG("OPENXR: " << debugUtilsStats.receivedCount << " debug utils messages, " << debugUtilsStats.suppressedCount << " repeats suppressed");
+    }
 
-                // Log that there's a reference space change pending.
-                case XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING: {
-                    XrEventDataReferenceSpaceChangePending *referenceSpaceChangePending = reinterpret_cast<XrEventDataReferenceSpaceChangePending *>(&eventData);
-                    XR_TUT_LOG("OPENXR: Reference Space Change pending for Session: " << referenceSpaceChangePending->session);
-                    if (referenceSpaceChangePending->session != m_session) {
-                        XR_TUT_LOG("XrEventDataReferenceSpaceChangePending for unknown Session");
-                        break;
-                    }
+    // Count the number of lost events from the runtime.
+    void OnEventsLost(const XrEventDataBuffer &eventData) {
+        const XrEventDataEventsLost *eventsLost = reinterpret_cast<const XrEventDataEventsLost *>(&eventData);
+        m_lostEventCount += eventsLost->lostEventCount;
+    }
+
+    // An instance loss is pending: stop the frame pipeline. Run() then destroys the XrInstance and recreates it once the
+    // runtime is available again.
+    void OnInstanceLossPending(const XrEventDataBuffer &eventData) {
+        const XrEventDataInstanceLossPending *instanceLossPending = reinterpret_cast<const XrEventDataInstanceLossPending *>(&eventData);
+        XR_TUT_LOG("OPENXR: Instance Loss Pending at: " << instanceLossPending->lossTime);
+        StopFramePipeline();
+        m_sessionRunning = false;
+        m_lossRecovery = LossRecovery::INSTANCE;
+    }
+
+    // XR_EXT_performance_settings: the runtime reports that the GPU is, or is no longer, struggling to keep up.
+    void OnPerfSettings(const XrEventDataBuffer &eventData) {
+        const XrEventDataPerfSettingsEXT *perfSettings = reinterpret_cast<const XrEventDataPerfSettingsEXT *>(&eventData);
+        if (perfSettings->domain == XR_PERF_SETTINGS_DOMAIN_GPU_EXT) {
+            m_dynamicResolution.SetThrottled(perfSettings->toLevel != XR_PERF_SETTINGS_NOTIF_LEVEL_NORMAL_EXT);
+        }
+    }
+
+    // The interaction profile of one or more hands has changed. The event does not say which, so the current profile of
+    // each hand is queried again; PollActions() passes them on with the frame's InputState.
+    void OnInteractionProfileChanged(const XrEventDataBuffer &eventData) {
+        const XrEventDataInteractionProfileChanged *interactionProfileChanged = reinterpret_cast<const XrEventDataInteractionProfileChanged *>(&eventData);
+        if (interactionProfileChanged->session != m_session) {
+            m_unknownSessionEventCount++;
+            return;
+        }
+        for (uint32_t hand = 0; hand < HAND_COUNT; hand++) {
+            XrInteractionProfileState interactionProfileState{XR_TYPE_INTERACTION_PROFILE_STATE};
+            const XrResult profileResult = xrGetCurrentInteractionProfile(m_session, m_handPaths[hand], &interactionProfileState);
+            if (HandleFramePipelineLoss(profileResult)) {
+                return;
+            }
+            OPENXR_CHECK(profileResult, "Failed to get the current interaction profile.");
+            if (m_interactionProfiles[hand] != interactionProfileState.interactionProfile) {
+                m_interactionProfiles[hand] = interactionProfileState.interactionProfile;
+                m_inputStats.interactionProfileChangeCount++;
+            }
+        }
+    }
+
+    // A reference space change is pending. The tutorial places no content in its reference space, and every frame locates
+    // the views and action spaces again, so there is nothing to re-anchor.
+    void OnReferenceSpaceChangePending(const XrEventDataBuffer &eventData) {
+        const XrEventDataReferenceSpaceChangePending *referenceSpaceChangePending = reinterpret_cast<const XrEventDataReferenceSpaceChangePending *>(&eventData);
+        if (referenceSpaceChangePending->session != m_session) {
+            m_unknownSessionEventCount++;
+            return;
+        }
+    }
+
+    // Session State changes:
+    void OnSessionStateChanged(const XrEventDataBuffer &eventData) {
+        const XrEventDataSessionStateChanged *sessionStateChanged = reinterpret_cast<const XrEventDataSessionStateChanged *>(&eventData);
+        if (sessionStateChanged->session != m_session) {
+            m_unknownSessionEventCount++;
+            return;
+        }
+
+        if (sessionStateChanged->state == XR_SESSION_STATE_READY) {
+            // SessionState is ready. Begin the XrSession using the XrViewConfigurationType.
+            XrSessionBeginInfo sessionBeginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+            sessionBeginInfo.primaryViewConfigurationType = m_viewConfiguration;
+            OPENXR_CHECK(xrBeginSession(m_session, &sessionBeginInfo), "Failed to begin Session.");
+            m_sessionRunning = true;
+            StartFramePipeline();
+        }
+        if (sessionStateChanged->state == XR_SESSION_STATE_STOPPING) {
+            // SessionState is stopping. Drain the frame pipeline and end the XrSession.
+            StopFramePipeline();
+            OPENXR_CHECK(xrEndSession(m_session), "Failed to end Session.");
+            m_sessionRunning = false;
+        }
+        if (sessionStateChanged->state == XR_SESSION_STATE_EXITING) {
+            // SessionState is exiting. Exit the application.
+            m_sessionRunning = false;
+            m_applicationRunning = false;
+        }
+        if (sessionStateChanged->state == XR_SESSION_STATE_LOSS_PENDING) {
+            // SessionState is loss pending. Recreate the XrSession, unless the whole XrInstance is being recreated.
+            StopFramePipeline();
+            m_sessionRunning = false;
+            if (m_lossRecovery == LossRecovery::NONE) {
+                m_lossRecovery = LossRecovery::SESSION;
+            }
+        }
+        // Store state for reference across the application.
+        m_sessionState = sessionStateChanged->state;
+    }
+
+    // The frame loop is split into three stages that run concurrently on consecutive frames:
+    //  - FramePacingThread() calls xrWaitFrame() and xrBeginFrame(). It is the only stage that blocks on the runtime's
+    //    display timing.
+    //  - SimulationThread() advances the application to the frame's predictedDisplayTime.
+    //  - RenderFrame() runs on the main thread, which owns the graphics context, records the frame and calls xrEndFrame().
+    // While frame N is rendered, frame N+1 is simulated and the pacing thread is already waiting on frame N+2.
+    // xrBeginFrame() for frame N+1 is only called after xrEndFrame() for frame N, as the runtime would otherwise discard frame N.
+    struct FramePacket {
+        uint64_t frameIndex = 0;
+        XrFrameState frameState = {XR_TYPE_FRAME_STATE};
+        InputState input;  // Written by the simulation stage.
+        FrameTimingRecord timing;
+    };
+
+    void StartFramePipeline() {
+        m_frameTiming.Restart();
+        m_lastPredictedDisplayTime = 0;
+        m_lastBegunFrameIndex = 0;
+        m_lastEndedFrameIndex = 0;
+        m_simulationQueue.Reset();
+        m_renderQueue.Reset();
+        m_framePipelineRunning = true;
+        m_framePacingThread = std::thread(&OpenXRTutorial::FramePacingThread, this);
+        m_simulationThread = std::thread(&OpenXRTutorial::SimulationThread, this);
+    }
+
+    void StopFramePipeline() {
+        {
+            std::lock_guard<std::mutex> lock(m_frameSyncMutex);
+            m_framePipelineRunning = false;
+        }
+        m_frameSyncCV.notify_all();
+        m_simulationQueue.Close();
+        m_renderQueue.Close();
+        if (m_framePacingThread.joinable()) {
+            m_framePacingThread.join();
+        }
+        if (m_simulationThread.joinable()) {
+            m_simulationThread.join();
+        }
+        // Handle the events the simulation thread did not get to.
+        DispatchSimulationEvents();
+    }
+
+    // A call on the frame pipeline's threads (the frame calls, xrSyncActions() and the space locates) can return
+    // XR_ERROR_SESSION_LOST or XR_ERROR_INSTANCE_LOST before the main thread has handled the loss pending event. Returns true if result is one of them, after stopping the frame pipeline's threads; the main
+    // thread then picks the loss up in TakeFramePipelineLoss() and recovers from it as from the event.
+    bool HandleFramePipelineLoss(XrResult frameResult) {
+        if (frameResult != XR_ERROR_SESSION_LOST && frameResult != XR_ERROR_INSTANCE_LOST) {
+            return false;
+        }
+        XrResult expected = XR_SUCCESS;
+        m_framePipelineLoss.compare_exchange_strong(expected, frameResult);
+        {
+            std::lock_guard<std::mutex> lock(m_frameSyncMutex);
+            m_framePipelineRunning = false;
+        }
+        m_frameSyncCV.notify_all();
+        m_simulationQueue.Close();
+        m_renderQueue.Close();
+        return true;
+    }
+
+    void TakeFramePipelineLoss() {
+        const XrResult framePipelineLoss = m_framePipelineLoss.exchange(XR_SUCCESS);
+        if (framePipelineLoss == XR_SUCCESS) {
+            return;
+        }
+        XR_TUT_LOG("OPENXR: The frame pipeline got " << (framePipelineLoss == XR_ERROR_INSTANCE_LOST ? "XR_ERROR_INSTANCE_LOST" : "XR_ERROR_SESSION_LOST") << "; recovering.");
+        if (framePipelineLoss == XR_ERROR_INSTANCE_LOST) {
+            m_lossRecovery = LossRecovery::INSTANCE;
+        } else if (m_lossRecovery == LossRecovery::NONE) {
+            m_lossRecovery = LossRecovery::SESSION;
+        }
+    }
+
+    void FramePacingThread() {
+        XR_TUT_PROFILE_THREAD_NAME("Frame pacing");
+        uint64_t frameIndex = 0;
+        while (m_framePipelineRunning) {
+            FramePacket packet;
+            packet.frameIndex = ++frameIndex;
+
+            // Block until the runtime wants the application to start on the next frame.
+            XrFrameWaitInfo frameWaitInfo{XR_TYPE_FRAME_WAIT_INFO};
+            packet.timing.waitFrameStart = std::chrono::steady_clock::now();
+            XrResult waitResult = XR_SUCCESS;
+            {
+                XR_TUT_PROFILE_SCOPE("xrWaitFrame");
+                waitResult = xrWaitFrame(m_session, &frameWaitInfo, &packet.frameState);
+            }
+            if (HandleFramePipelineLoss(waitResult)) {
+                break;
+            }
+            OPENXR_CHECK(waitResult, "Failed to wait for XR Frame.");
+            packet.timing.waitFrameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - packet.timing.waitFrameStart).count();
+
+            // Hand the predicted display time to the simulation straight away, so it overlaps with the render stage.
+            if (!m_simulationQueue.Push(packet)) {
+                break;
+            }
+
+            // Begin the frame once the previous one has been ended.
+            {
+                std::unique_lock<std::mutex> lock(m_frameSyncMutex);
+                m_frameSyncCV.wait(lock, [&] { return m_lastEndedFrameIndex + 1 >= packet.frameIndex || !m_framePipelineRunning; });
+                if (!m_framePipelineRunning) {
                     break;
                 }
+            }
+            XrFrameBeginInfo frameBeginInfo{XR_TYPE_FRAME_BEGIN_INFO};
+            XrResult beginResult = XR_SUCCESS;
+            {
+                XR_TUT_PROFILE_SCOPE("xrBeginFrame");
+                beginResult = xrBeginFrame(m_session, &frameBeginInfo);
+            }
+            if (HandleFramePipelineLoss(beginResult)) {
+                break;
+            }
+            OPENXR_CHECK(beginResult, "Failed to begin the XR Frame.");
+            {
+                std::lock_guard<std::mutex> lock(m_frameSyncMutex);
+                m_lastBegunFrameIndex = packet.frameIndex;
+            }
+            m_frameSyncCV.notify_all();
+        }
+    }
 
-                // Session State changes:
-                case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED: {
-                    XrEventDataSessionStateChanged *sessionStateChanged = reinterpret_cast<XrEventDataSessionStateChanged *>(&eventData);
-                    if (sessionStateChanged->session != m_session) {
-                        XR_TUT_LOG("XrEventDataSessionStateChanged for unknown Session");
-                        break;
-                    }
+    void SimulationThread() {
+        XR_TUT_PROFILE_THREAD_NAME("Simulation");
+        FramePacket packet;
+        while (m_simulationQueue.Pop(packet)) {
+            packet.timing.simulationStart = std::chrono::steady_clock::now();
+            DispatchSimulationEvents();
+            UpdateSimulation(packet);
+            packet.timing.simulationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - packet.timing.simulationStart).count();
+            if (!m_renderQueue.Push(packet)) {
+                break;
+            }
+        }
+    }
 
-                    if (sessionStateChanged->state == XR_SESSION_STATE_READY) {
-                        // SessionState is ready. Begin the XrSession using the XrViewConfigurationType.
-                        XrSessionBeginInfo sessionBeginInfo{XR_TYPE_SESSION_BEGIN_INFO};
-                        sessionBeginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
-                        OPENXR_CHECK(xrBeginSession(m_session, &sessionBeginInfo), "Failed to begin Session.");
-                        m_sessionRunning = true;
-                    }
-                    if (sessionStateChanged->state == XR_SESSION_STATE_STOPPING) {
-                        // SessionState is stopping. End the XrSession.
-                        OPENXR_CHECK(xrEndSession(m_session), "Failed to end Session.");
-                        m_sessionRunning = false;
-                    }
-                    if (sessionStateChanged->state == XR_SESSION_STATE_EXITING) {
-                        // SessionState is exiting. Exit the application.
-                        m_sessionRunning = false;
-                        m_applicationRunning = false;
-                    }
-                    if (sessionStateChanged->state == XR_SESSION_STATE_LOSS_PENDING) {
-                        // SessionState is loss pending. Exit the application.
-                        // It's possible to try a reestablish an XrInstance and XrSession, but we will simply exit here.
-                        m_sessionRunning = false;
-                        m_applicationRunning = false;
+    void UpdateSimulation(FramePacket &packet) {
+        XR_TUT_PROFILE_FUNCTION();
+        PollActions(packet.frameState.predictedDisplayTime, packet.input);
+    }
+
+    void RenderFrame() {
+        XR_TUT_PROFILE_FUNCTION();
+        // Time out regularly, so that Run() keeps polling for events while the runtime is not producing frames.
+        FramePacket packet;
+        if (!m_renderQueue.Pop(packet, std::chrono::milliseconds(100))) {
+            return;
+        }
+
+        // Wait for the pacing thread to begin this frame.
+        {
+            std::unique_lock<std::mutex> lock(m_frameSyncMutex);
+            m_frameSyncCV.wait(lock, [&] { return m_lastBegunFrameIndex >= packet.frameIndex || !m_framePipelineRunning; });
+            if (!m_framePipelineRunning) {
+                return;
+            }
+        }
+
+        // Rendering is skipped when the runtime reports that nothing would be displayed, but the frame must still be ended.
+        FrameTimingRecord &timing = packet.timing;
+        timing.recordStart = std::chrono::steady_clock::now();
+        TrackDisplayTime(packet.frameState);
+        m_renderLayers.clear();
+        if (packet.frameState.shouldRender) {
+            if (RenderLayer(packet.frameState, timing)) {
+                m_renderLayers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader *>(&m_layerProjection));
+            }
+        }
+
+        XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
+        frameEndInfo.displayTime = packet.frameState.predictedDisplayTime;
+        frameEndInfo.environmentBlendMode = m_environmentBlendMode;
+        frameEndInfo.layerCount = static_cast<uint32_t>(m_renderLayers.size());
+        frameEndInfo.layers = m_renderLayers.data();
+        timing.submitStart = std::chrono::steady_clock::now();
+        timing.recordTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timing.submitStart - timing.recordStart).count();
+        XrResult endResult = XR_SUCCESS;
+        {
+            XR_TUT_PROFILE_SCOPE("xrEndFrame");
+            endResult = xrEndFrame(m_session, &frameEndInfo);
+        }
+        if (HandleFramePipelineLoss(endResult)) {
+            return;
+        }
+        OPENXR_CHECK(endResult, "Failed to end the XR Frame.");
+        timing.submitTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - timing.submitStart).count();
+        timing.frameIndex = packet.frameIndex;
+        timing.predictedDisplayTime = packet.frameState.predictedDisplayTime;
+        timing.predictedDisplayPeriod = packet.frameState.predictedDisplayPeriod;
+        timing.shouldRender = packet.frameState.shouldRender;
+        m_frameTiming.Add(timing);
+        if (!m_firstFrameSubmitted && !m_renderLayers.empty()) {
+            m_firstFrameSubmitted = true;
+            XR_TUT_LOG("Startup: first frame submitted " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_startupTime).count() << " ms after start.");
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_frameSyncMutex);
+            m_lastEndedFrameIndex = packet.frameIndex;
+        }
+        m_frameSyncCV.notify_all();
+    }
+
+    bool RenderLayer(const XrFrameState &frameState, FrameTimingRecord &timing) {
+        XR_TUT_PROFILE_FUNCTION();
+        // Locate the views from the view configuration within the (reference) space at the display time.
+        XrViewState viewState{XR_TYPE_VIEW_STATE};  // Will contain information on whether the position and/or orientation is valid and/or tracked.
+        XrViewLocateInfo viewLocateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+        viewLocateInfo.viewConfigurationType = m_viewConfiguration;
+        viewLocateInfo.displayTime = frameState.predictedDisplayTime;
+        viewLocateInfo.space = m_localSpace;
+        uint32_t viewCount = 0;
+        const std::chrono::steady_clock::time_point locateTime = std::chrono::steady_clock::now();
+        XrResult result = xrLocateViews(m_session, &viewLocateInfo, &viewState, static_cast<uint32_t>(m_views.size()), &viewCount, m_views.data());
+        if (result != XR_SUCCESS || !BitwiseCheck(viewState.viewStateFlags, XrViewStateFlags(XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT))) {
+            return false;
+        }
+
+        const float resolutionScale = UpdateResolutionScale(frameState);
+
+        // Acquire every image for this frame first; the waits happen per swapchain, just before rendering to it.
+        const size_t swapchainCount = m_colorSwapchainInfos.size();
+        for (size_t i = 0; i < swapchainCount; i++) {
+            AcquireSwapchainImage(m_colorSwapchainInfos[i]);
+            AcquireSwapchainImage(m_depthSwapchainInfos[i]);
+        }
+
+        // Fill out the XrCompositionLayerProjectionView structures specifying the pose and fov from the views.
+        // This also associates the swapchain image, or the layer of the array swapchain image, with each view.
+        for (uint32_t i = 0; i < viewCount; i++) {
+            const SwapchainInfo &colorSwapchainInfo = m_colorSwapchainInfos[m_useArraySwapchain ? 0 : i];
+            XrCompositionLayerProjectionView &layerProjectionView = m_layerProjectionViews[i];
+            layerProjectionView = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
+            layerProjectionView.pose = m_views[i].pose;
+            layerProjectionView.fov = m_views[i].fov;
+            layerProjectionView.subImage.swapchain = colorSwapchainInfo.swapchain;
+            layerProjectionView.subImage.imageRect = GetScaledImageRect(colorSwapchainInfo, m_viewConfigurationViews[i], resolutionScale);
+            layerProjectionView.subImage.imageArrayIndex = m_useArraySwapchain ? i : 0;
+
+            // Chain the depth image of this view. The depth range and near/far planes must match UpdateViewConstants().
+            if (m_submitDepth) {
+                const SwapchainInfo &depthSwapchainInfo = m_depthSwapchainInfos[m_useArraySwapchain ? 0 : i];
+                XrCompositionLayerDepthInfoKHR &layerDepthInfo = m_layerDepthInfos[i];
+                layerDepthInfo = {XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR};
+                layerDepthInfo.subImage.swapchain = depthSwapchainInfo.swapchain;
+                layerDepthInfo.subImage.imageRect = layerProjectionView.subImage.imageRect;
+                layerDepthInfo.subImage.imageArrayIndex = layerProjectionView.subImage.imageArrayIndex;
+                layerDepthInfo.minDepth = 0.0f;
+                layerDepthInfo.maxDepth = 1.0f;
+                layerDepthInfo.nearZ = m_nearZ;
+                layerDepthInfo.farZ = m_farZ;
+                layerProjectionView.next = &layerDepthInfo;
+            }
+        }
+
+        // With an array swapchain, this loop runs once and clears the layers of all views together.
+        bool layerComplete = true;
+        for (size_t i = 0; i < swapchainCount; i++) {
+            SwapchainInfo &colorSwapchainInfo = m_colorSwapchainInfos[i];
+            SwapchainInfo &depthSwapchainInfo = m_depthSwapchainInfos[i];
+
+            // If the runtime does not hand back an image in time, the layer is left out of this frame rather than
+            // blocking the render stage indefinitely. A waited image is released unrendered; the other stays acquired.
+            if (!WaitSwapchainImage(colorSwapchainInfo) || !WaitSwapchainImage(depthSwapchainInfo)) {
+                for (SwapchainInfo *swapchainInfo : {&colorSwapchainInfo, &depthSwapchainInfo}) {
+                    if (swapchainInfo->imageWaited) {
+                        ReleaseSwapchainImage(*swapchainInfo);
                     }
-                    // Store state for reference across the application.
-                    m_sessionState = sessionStateChanged->state;
-                    break;
-                }
-                default: {
-                    break;
                 }
+                layerComplete = false;
+                continue;
+            }
+
+            void *colorImageView = colorSwapchainInfo.imageViews[colorSwapchainInfo.imageIndex];
+            void *depthImageView = depthSwapchainInfo.imageViews[depthSwapchainInfo.imageIndex];
+
+            // Clear the images, then draw into them. Draws set their viewports and scissors to the views' imageRect, as it
+            // is smaller than the image when scaled.
+            const std::chrono::steady_clock::time_point renderingStartTime = std::chrono::steady_clock::now();
+            m_graphicsAPI->BeginRendering();
+            const XrDuration gpuTime = static_cast<XrDuration>(m_graphicsAPI->GetLastRenderingGpuTime());
+            m_frameGpuTime += gpuTime;
+            timing.gpuTime += gpuTime;
+            if (i == 0) {
+                UpdateViewConstants();
+            }
+            m_graphicsAPI->ClearColor(colorImageView, 0.17f, 0.17f, 0.17f, 1.00f);
+            m_graphicsAPI->ClearDepth(depthImageView, 1.0f);
+            if (m_floorPipeline) {
+                DrawFloor(static_cast<uint32_t>(i), colorImageView, depthImageView, colorSwapchainInfo);
+            }
+
+            // Draws read m_viewConstantsBuffer when the GPU executes them, so the buffer can still be patched until the
+            // frame's first submission in EndRendering(). All views are latched together, as they share one pose sample.
+            if (i == 0 && m_lateLatchViews) {
+                LateLatchViews(frameState, locateTime, timing);
             }
+            m_graphicsAPI->EndRendering();
+            m_frameRenderingTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - renderingStartTime).count();
+
+            // Give the swapchain images back to the runtime, allowing the compositor to use them.
+            ReleaseSwapchainImage(colorSwapchainInfo);
+            ReleaseSwapchainImage(depthSwapchainInfo);
+        }
+        if (!layerComplete) {
+            return false;
+        }
+
+        // Fill out the XrCompositionLayerProjection structure for usage with xrEndFrame().
+        m_layerProjection = {XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+        m_layerProjection.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT | XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT;
+        m_layerProjection.space = m_localSpace;
+        m_layerProjection.viewCount = viewCount;
+        m_layerProjection.views = m_layerProjectionViews.data();
+        return true;
+    }
+
+    // Called for every frame, including those that are not rendered, so that a run of frames with shouldRender false is
+    // not taken for a missed frame when rendering resumes.
+    void TrackDisplayTime(const XrFrameState &frameState) {
+        m_lastFrameMissed = m_lastPredictedDisplayTime != 0 && frameState.predictedDisplayTime - m_lastPredictedDisplayTime > frameState.predictedDisplayPeriod * 3 / 2;
+        m_lastPredictedDisplayTime = frameState.predictedDisplayTime;
+    }
+
+    // Feeds the previous frame's timing to the dynamic resolution controller and returns the scale for this frame.
+    float UpdateResolutionScale(const XrFrameState &frameState) {
+        if (!m_useDynamicResolution) {
+            return 1.0f;
+        }
+        // GetLastRenderingGpuTime() lags by a submission, so the GPU times summed over a frame add up to about one frame's
+        // worth. Without GPU timing, the CPU time spent in BeginRendering()/EndRendering(), which includes waiting on the
+        // previous submission, is used instead.
+        const XrDuration frameTime = m_frameGpuTime > 0 ? m_frameGpuTime : m_frameRenderingTime;
+        m_frameGpuTime = 0;
+        m_frameRenderingTime = 0;
+        return m_dynamicResolution.Update(frameTime, frameState.predictedDisplayPeriod, m_lastFrameMissed);
+    }
+
+    void LogLoggerStats() {
+        const Logger::Stats stats = Logger::Get().GetStats();
+        XR_TUT_LOG("Log: " << stats.writtenCounts[static_cast<size_t>(LogSeverity::VERBOSE)] << " verbose, "
+                           << stats.writtenCounts[static_cast<size_t>(LogSeverity::INFO)] << " info, "
+                           << stats.writtenCounts[static_cast<size_t>(LogSeverity::WARN)] << " warning and "
+                           << stats.writtenCounts[static_cast<size_t>(LogSeverity::ERR)] << " error messages written, "
+                           << stats.droppedCount << " dropped as a queue was full, " << stats.truncatedCount << " truncated, "
+                           << "most queued on one thread " << stats.maxQueueDepth << " of " << static_cast<size_t>(Logger::QueueCapacity));
+    }
+
+    void LogFrameTiming() {
+        const FrameTimingRecorder::Stats &stats = m_frameTiming.GetStats();
+        if (stats.frameCount == 0) {
+            return;
+        }
+        auto AverageMilliseconds = [&](XrDuration total) { return static_cast<double>(total) / static_cast<double>(stats.frameCount) / 1000000.0; };
+        XR_TUT_LOG("Frame timing: " << stats.frameCount << " frames, average ms: xrWaitFrame " << AverageMilliseconds(stats.totalWaitFrameTime)
+                                    << ", simulation " << AverageMilliseconds(stats.totalSimulationTime) << ", record " << AverageMilliseconds(stats.totalRecordTime)
+                                    << ", xrEndFrame " << AverageMilliseconds(stats.totalSubmitTime) << ", GPU " << AverageMilliseconds(stats.totalGpuTime));
+        XR_TUT_LOG("Frame timing: " << stats.missedFrameCount << " missed frames: "
+                                    << stats.missedFrameCauseCounts[static_cast<size_t>(FrameTimingRecord::MissedFrameCause::GPU)] << " GPU, "
+                                    << stats.missedFrameCauseCounts[static_cast<size_t>(FrameTimingRecord::MissedFrameCause::RENDERING)] << " rendering, "
+                                    << stats.missedFrameCauseCounts[static_cast<size_t>(FrameTimingRecord::MissedFrameCause::SIMULATION)] << " simulation, "
+                                    << stats.missedFrameCauseCounts[static_cast<size_t>(FrameTimingRecord::MissedFrameCause::RUNTIME)] << " runtime");
+        if (stats.latchCount + stats.failedLatchCount > 0) {
+            const double latchCount = static_cast<double>(std::max<uint64_t>(stats.latchCount, 1));
+            XR_TUT_LOG("Frame timing: late latching: " << stats.latchCount << " frames latched, " << stats.failedLatchCount << " failed, average latch delay "
+                                                       << static_cast<double>(stats.totalLatchDelay) / latchCount / 1000000.0 << " ms, average/max position delta "
+                                                       << stats.totalLatchPositionDelta / latchCount << "/" << stats.maxLatchPositionDelta << " m, average/max angle delta "
+                                                       << stats.totalLatchAngleDelta / latchCount << "/" << stats.maxLatchAngleDelta << " rad");
         }
+
+        if (m_frameTimingExportPath.empty()) {
+            return;
+        }
+        std::ofstream stream(m_frameTimingExportPath);
+        if (!stream.is_open()) {
+            XR_TUT_LOG_ERROR("Failed to open " << m_frameTimingExportPath << " for the frame timing.");
+            return;
+        }
+        auto EndsWith = [&](const std::string &suffix) {
+            return m_frameTimingExportPath.size() >= suffix.size() && m_frameTimingExportPath.compare(m_frameTimingExportPath.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+        if (EndsWith(".csv")) {
+            m_frameTiming.WriteCSV(stream);
+        } else if (EndsWith(".trace.json")) {
+            m_frameTiming.WriteChromeTrace(stream);
+        } else {
+            m_frameTiming.WriteJSON(stream);
+        }
+        XR_TUT_LOG("Frame timing: wrote the last " << m_frameTiming.Size() << " frames to " << m_frameTimingExportPath);
+    }
+
+    // The rect is centered in the image, so that the foveation of the full image stays centered on the view.
+    XrRect2Di GetScaledImageRect(const SwapchainInfo &swapchainInfo, const XrViewConfigurationView &viewConfigurationView, float scale) {
+        XrRect2Di imageRect;
+        imageRect.extent.width = std::min(std::max(static_cast<int32_t>(viewConfigurationView.recommendedImageRectWidth * scale + 0.5f), 1), static_cast<int32_t>(swapchainInfo.width));
+        imageRect.extent.height = std::min(std::max(static_cast<int32_t>(viewConfigurationView.recommendedImageRectHeight * scale + 0.5f), 1), static_cast<int32_t>(swapchainInfo.height));
+        imageRect.offset.x = (static_cast<int32_t>(swapchainInfo.width) - imageRect.extent.width) / 2;
+        imageRect.offset.y = (static_cast<int32_t>(swapchainInfo.height) - imageRect.extent.height) / 2;
+        return imageRect;
     }
 
 #if defined(__ANDROID__)
@@ -351,18 +2225,37 @@ private:
     }
 #else
     void PollSystemEvents() {
-        return;
+        // There are no system events to poll on desktop, but while the session is not running nothing else paces Run(),
+        // which would spin on xrPollEvent(). As with the ALooper_pollOnce() timeout on Android, block here instead.
+        // OpenXR has no blocking event wait, so the wait backs off up to m_maxIdleWait and is reset by PollEvents()
+        // whenever an event arrives.
+        if (m_sessionRunning || !m_applicationRunning) {
+            m_idleWait = std::chrono::milliseconds(0);
+            return;
+        }
+        std::this_thread::sleep_for(m_idleWait);
+        m_idleWait = std::min(m_idleWait * 2 + std::chrono::milliseconds(1), m_maxIdleWait);
     }
 #endif
 
 private:
     XrInstance m_xrInstance = {};
+    XrVersion m_xrApiVersion = 0;
     std::vector<const char *> m_activeAPILayers = {};
     std::vector<const char *> m_activeInstanceExtensions = {};
     std::vector<std::string> m_apiLayers = {};
     std::vector<std::string> m_instanceExtensions = {};
+    std::vector<std::string> m_optionalInstanceExtensions = {};
+    CapabilitySet m_availableAPILayers;
+    CapabilitySet m_availableInstanceExtensions;
+    CapabilitySet m_enabledInstanceExtensions;
 
     XrDebugUtilsMessengerEXT m_debugUtilsMessenger = {};
+    // Subscribing to VERBOSE messages makes some runtimes and API layers do a lot of extra work, so they are only
+    // requested when they would be logged.
+    XrDebugUtilsMessageSeverityFlagsEXT m_debugUtilsMessageSeverities = XR_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    XrDebugUtilsMessageTypeFlagsEXT m_debugUtilsMessageTypes = XR_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT | XR_DEBUG_UTILS_MESSAGE_TYPE_CONFORMANCE_BIT_EXT;
+    DebugUtilsMessageDeduplicator m_debugUtilsMessageDeduplicator;
 
     XrFormFactor m_formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
     XrSystemId m_systemID = {};
@@ -376,6 +2269,100 @@ private:
     XrSessionState m_sessionState = XR_SESSION_STATE_UNKNOWN;
     bool m_applicationRunning = true;
     bool m_sessionRunning = false;
+    std::chrono::milliseconds m_idleWait = std::chrono::milliseconds(0);
+    std::chrono::milliseconds m_maxIdleWait = std::chrono::milliseconds(100);
+    std::chrono::steady_clock::time_point m_startupTime = {};
+    bool m_firstFrameSubmitted = false;
+    LossRecovery m_lossRecovery = LossRecovery::NONE;
+    std::chrono::steady_clock::time_point m_nextInstanceAttempt = {};
+    std::chrono::milliseconds m_minInstanceRetryInterval = std::chrono::milliseconds(1000);
+    std::chrono::milliseconds m_maxInstanceRetryInterval = std::chrono::milliseconds(8000);
+    std::chrono::milliseconds m_instanceRetryInterval = m_minInstanceRetryInterval;
+    bool m_systemUnavailable = false;  // Set by GetSystemID() when the XrFormFactor is unavailable.
+    uint32_t m_sessionRecoveryCount = 0;
+    uint32_t m_instanceRecoveryCount = 0;
+
+    XrEnvironmentBlendMode m_environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+    XrViewConfigurationType m_viewConfiguration = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+    std::vector<XrViewConfigurationView> m_viewConfigurationViews;
+
+    XrSpace m_localSpace = XR_NULL_HANDLE;
+
+    XrActionSet m_actionSet = XR_NULL_HANDLE;
+    XrAction m_selectAction = XR_NULL_HANDLE;
+    XrAction m_grabAction = XR_NULL_HANDLE;
+    XrAction m_gripPoseAction = XR_NULL_HANDLE;
+    XrAction m_aimPoseAction = XR_NULL_HANDLE;
+    std::array<XrPath, HAND_COUNT> m_handPaths = {};
+    std::array<XrPath, HAND_COUNT> m_interactionProfiles = {};  // Written by OnInteractionProfileChanged() on the simulation thread.
+    std::vector<XrSpace> m_inputSpaces;
+    std::vector<XrSpaceLocationDataKHR> m_inputSpaceLocations;  // Filled by the runtime, then copied into InputState.
+    PFN_xrLocateSpacesKHR m_xrLocateSpaces = nullptr;
+    InputStats m_inputStats;
+
+    std::vector<SwapchainInfo> m_colorSwapchainInfos = {};
+    std::vector<SwapchainInfo> m_depthSwapchainInfos = {};
+    bool m_useArraySwapchain = false;
+    XrDuration m_swapchainWaitTimeout = 100000000;  // 100 ms, in nanoseconds.
+    uint32_t m_maxSwapchainWaitTimeouts = 3;        // Timeouts in a row after which the layer is skipped for the frame.
+
+    std::vector<XrView> m_views;
+    std::vector<XrCompositionLayerProjectionView> m_layerProjectionViews;
+    XrCompositionLayerProjection m_layerProjection = {XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+    float m_nearZ = 0.05f;
+    float m_farZ = 100.0f;
+
+    bool m_useFoveation = true;
+    FoveationMode m_foveationMode = FoveationMode::NONE;
+    bool m_foveationEyeTrackedSupported = false;
+    XrFoveationLevelFB m_foveationLevel = XR_FOVEATION_LEVEL_HIGH_FB;
+    PFN_xrCreateFoveationProfileFB m_xrCreateFoveationProfileFB = nullptr;
+    PFN_xrDestroyFoveationProfileFB m_xrDestroyFoveationProfileFB = nullptr;
+    PFN_xrUpdateSwapchainFB m_xrUpdateSwapchainFB = nullptr;
+
+    std::array<EventHandlerEntry, 16> m_eventHandlers = {};
+    size_t m_eventHandlerCount = 0;
+    std::array<XrEventDataBuffer, 8> m_polledEvents = {};
+    uint64_t m_lostEventCount = 0;
+    uint64_t m_unhandledEventCount = 0;
+    std::atomic<uint64_t> m_unknownSessionEventCount{0};  // Also counted by handlers on the simulation thread.
+    uint64_t m_simulationEventOverflowCount = 0;
+
+    bool m_useDynamicResolution = true;
+    DynamicResolutionController m_dynamicResolution;
+    XrTime m_lastPredictedDisplayTime = 0;  // Reset by StartFramePipeline(), as a new session starts after a gap.
+    bool m_lastFrameMissed = false;
+    XrDuration m_frameGpuTime = 0;
+    FrameTimingRecorder m_frameTiming{4096};  // About 45 s at 90 Hz.
+    std::string m_frameTimingExportPath;
+    XrDuration m_frameRenderingTime = 0;
+
+    bool m_submitDepth = true;
+    std::vector<XrCompositionLayerDepthInfoKHR> m_layerDepthInfos;
+
+    bool m_lateLatchViews = true;
+    std::vector<XrView> m_latchedViews;
+    std::vector<ViewConstants> m_viewConstants;
+    void *m_viewConstantsBuffer = nullptr;
+    void *m_viewConstantsMappedData = nullptr;
+    std::vector<XrProjectionCache> m_projectionCaches;
+    void *m_floorVertexShader = nullptr;
+    void *m_floorFragmentShader = nullptr;
+    void *m_floorPipeline = nullptr;
+
+    // Frame pipeline. The queues hold a single frame each, which keeps the stages in lock-step.
+    std::thread m_framePacingThread;
+    std::thread m_simulationThread;
+    std::atomic<bool> m_framePipelineRunning{false};
+    std::atomic<XrResult> m_framePipelineLoss{XR_SUCCESS};  // Set by HandleFramePipelineLoss() on any pipeline thread.
+    LockStepQueue<FramePacket, 1> m_simulationQueue;
+    LockStepQueue<FramePacket, 1> m_renderQueue;
+    SPSCQueue<XrEventDataBuffer, 8> m_simulationEvents;
+    std::mutex m_frameSyncMutex;
+    std::condition_variable m_frameSyncCV;
+    uint64_t m_lastBegunFrameIndex = 0;
+    uint64_t m_lastEndedFrameIndex = 0;
+    std::vector<XrCompositionLayerBaseHeader *> m_renderLayers;
 };
 
 void OpenXRTutorial_Main(GraphicsAPI_Type apiType) {
@@ -0,0 +1,14 @@
+# Copyright 2023, The Khronos Group Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+include_guard()
+
+
+option(XR_TUTORIAL_ENABLE_PROFILING "Record the XR_TUT_PROFILE_SCOPE() timings from Profiler.h into a Chrome trace file." OFF)
+
+function(AddProfilingDefine PROJECT_NAME)
+    if(XR_TUTORIAL_ENABLE_PROFILING)
+        target_compile_definitions(${PROJECT_NAME} PUBLIC XR_TUTORIAL_ENABLE_PROFILING)
+    endif()
+endfunction(AddProfilingDefine)